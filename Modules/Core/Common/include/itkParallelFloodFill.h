@@ -0,0 +1,192 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelFloodFill_h
+#define itkParallelFloodFill_h
+
+#include "itkImageRegion.h"
+#include "itkMultiThreaderBase.h"
+#include "itkProcessObject.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class ParallelFloodFill
+ * \brief Find the pixels of a region connected to seeds through the pixels
+ * accepted by a predicate, with several threads
+ *
+ * The pixels are filled by runs along the first dimension: a pixel accepted
+ * by the predicate is extended to the left and to the right as long as the
+ * pixels are accepted, as in a scanline flood fill. The runs found at a step
+ * are the frontier of the next step, which scans the lines next to each run
+ * for new runs. Large frontiers are split between the work units of the
+ * multi-threader, each of them building its own part of the next frontier.
+ * The state of each pixel, unknown, excluded or included, is kept in an array
+ * of atomic bytes, so that a pixel is claimed by a single run even when it is
+ * reached by several threads.
+ *
+ * The pixels filled are those of the connected component of the seeds, so
+ * they do not depend on the number of threads, and the runs are sorted and
+ * merged once the fill is done.
+ *
+ * The seeds inside the region are included without evaluating the predicate:
+ * the callers which require the seeds to be accepted check them before.
+ * The predicate is called with the index of the pixel, by several threads at
+ * the same time, and must be thread safe. It may be called more than once for
+ * the same pixel.
+ *
+ * The neighbors of a pixel are its face neighbors, 2*VDimension pixels, or
+ * all its 3^VDimension-1 neighbors when FullyConnected is on.
+ *
+ * \sa FloodFilledImageFunctionConditionalIterator
+ * \ingroup ITKCommon
+ */
+template <unsigned int VDimension>
+class ITK_TEMPLATE_EXPORT ParallelFloodFill
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ParallelFloodFill);
+
+  /** Standard class type aliases. */
+  using Self = ParallelFloodFill;
+
+  static constexpr unsigned int ImageDimension = VDimension;
+
+  using IndexType = Index<VDimension>;
+  using OffsetType = Offset<VDimension>;
+  using RegionType = ImageRegion<VDimension>;
+  using SeedsContainerType = std::vector<IndexType>;
+
+  /** Consecutive pixels along the first dimension, starting at m_Index. */
+  struct RunType
+  {
+    IndexType     m_Index;
+    SizeValueType m_Length;
+  };
+  using RunsContainerType = std::vector<RunType>;
+
+  /** Constructor for the region in which the pixels are filled. */
+  explicit ParallelFloodFill(const RegionType & region);
+
+  ~ParallelFloodFill() = default;
+
+  const RegionType &
+  GetRegion() const
+  {
+    return m_Region;
+  }
+
+  /** Set/Get whether all the neighbors of a pixel are connected to it, or
+   * only its face neighbors. Defaults to false. */
+  void
+  SetFullyConnected(bool fullyConnected)
+  {
+    m_FullyConnected = fullyConnected;
+  }
+  bool
+  GetFullyConnected() const
+  {
+    return m_FullyConnected;
+  }
+
+  /** Fill the pixels connected to the seeds. The work units of the
+   * multi-threader are used when it is not null, and the progress of the
+   * filter, when it is not null, is incremented by progressWeight times the
+   * fraction of the region filled. A ProcessAborted exception is thrown when
+   * the filter is aborted. */
+  template <typename TPredicate>
+  void
+  Fill(const SeedsContainerType & seeds,
+       const TPredicate &         isIncluded,
+       MultiThreaderBase *        multiThreader = nullptr,
+       ProcessObject *            filter = nullptr,
+       float                      progressWeight = 1.0f);
+
+  /** The runs of pixels filled, ordered as the pixels in the image buffer,
+   * with no two runs adjacent on the same line. */
+  const RunsContainerType &
+  GetRuns() const
+  {
+    return m_Runs;
+  }
+
+  /** The number of pixels filled. */
+  SizeValueType
+  GetNumberOfPixels() const
+  {
+    return m_NumberOfPixels;
+  }
+
+private:
+  using StateType = std::atomic<uint8_t>;
+
+  enum : uint8_t
+  {
+    Unknown = 0,
+    Excluded = 1,
+    Included = 2
+  };
+
+  /** Offset of the pixel in the state array. */
+  OffsetValueType
+  ComputeOffset(const IndexType & index) const;
+
+  /** Claim the pixel at the given position of the line, if it is unknown and
+   * accepted by the predicate, and mark it as excluded if it is rejected. */
+  template <typename TPredicate>
+  bool
+  Claim(StateType * line, const IndexType & index, const TPredicate & isIncluded) const;
+
+  /** Extend on both sides the run of the pixel claimed at index, and add it
+   * to the runs. */
+  template <typename TPredicate>
+  IndexValueType
+  ExtendRun(StateType * line, IndexType index, const TPredicate & isIncluded, RunsContainerType & runs) const;
+
+  /** Scan the lines next to a run for new runs. */
+  template <typename TPredicate>
+  void
+  ProcessRun(const RunType & run, const TPredicate & isIncluded, RunsContainerType & runs) const;
+
+  /** Minimal number of runs of the frontier processed by a work unit. */
+  static constexpr SizeValueType MinimumRunsPerWorkUnit = 64;
+
+  RegionType m_Region;
+  bool       m_FullyConnected{ false };
+
+  OffsetValueType m_Strides[VDimension];
+
+  /** The offsets of the lines next to a line, and their offsets in the state
+   * array. */
+  std::vector<OffsetType>      m_LineOffsets;
+  std::vector<OffsetValueType> m_LineStrides;
+
+  std::unique_ptr<StateType[]> m_States;
+  RunsContainerType            m_Runs;
+  SizeValueType                m_NumberOfPixels{ 0 };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkParallelFloodFill.hxx"
+#endif
+
+#endif
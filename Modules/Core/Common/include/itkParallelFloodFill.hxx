@@ -0,0 +1,325 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelFloodFill_hxx
+#define itkParallelFloodFill_hxx
+
+#include "itkTotalProgressReporter.h"
+#include <algorithm>
+
+namespace itk
+{
+
+template <unsigned int VDimension>
+ParallelFloodFill<VDimension>::ParallelFloodFill(const RegionType & region)
+  : m_Region(region)
+{
+  OffsetValueType stride = 1;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    m_Strides[d] = stride;
+    stride *= static_cast<OffsetValueType>(region.GetSize(d));
+  }
+}
+
+template <unsigned int VDimension>
+OffsetValueType
+ParallelFloodFill<VDimension>::ComputeOffset(const IndexType & index) const
+{
+  OffsetValueType offset = 0;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    offset += (index[d] - m_Region.GetIndex(d)) * m_Strides[d];
+  }
+  return offset;
+}
+
+template <unsigned int VDimension>
+template <typename TPredicate>
+void
+ParallelFloodFill<VDimension>::Fill(const SeedsContainerType & seeds,
+                                    const TPredicate &         isIncluded,
+                                    MultiThreaderBase *        multiThreader,
+                                    ProcessObject *            filter,
+                                    float                      progressWeight)
+{
+  m_Runs.clear();
+  m_NumberOfPixels = 0;
+
+  const SizeValueType numberOfPixels = m_Region.GetNumberOfPixels();
+  if (numberOfPixels == 0)
+  {
+    return;
+  }
+
+  // The lines next to a line are all the lines at a distance of one pixel
+  // in the other dimensions, or only the lines along each other dimension
+  m_LineOffsets.clear();
+  m_LineStrides.clear();
+  OffsetType lineOffset;
+  if (m_FullyConnected)
+  {
+    SizeValueType numberOfLines = 1;
+    for (unsigned int d = 1; d < VDimension; ++d)
+    {
+      numberOfLines *= 3;
+    }
+    for (SizeValueType n = 0; n < numberOfLines; ++n)
+    {
+      lineOffset.Fill(0);
+      SizeValueType position = n;
+      for (unsigned int d = 1; d < VDimension; ++d)
+      {
+        lineOffset[d] = static_cast<OffsetValueType>(position % 3) - 1;
+        position /= 3;
+      }
+      if (lineOffset != OffsetType())
+      {
+        m_LineOffsets.push_back(lineOffset);
+      }
+    }
+  }
+  else
+  {
+    for (unsigned int d = 1; d < VDimension; ++d)
+    {
+      for (OffsetValueType step = -1; step <= 1; step += 2)
+      {
+        lineOffset.Fill(0);
+        lineOffset[d] = step;
+        m_LineOffsets.push_back(lineOffset);
+      }
+    }
+  }
+  for (const OffsetType & offset : m_LineOffsets)
+  {
+    OffsetValueType stride = 0;
+    for (unsigned int d = 1; d < VDimension; ++d)
+    {
+      stride += offset[d] * m_Strides[d];
+    }
+    m_LineStrides.push_back(stride);
+  }
+
+  // All the pixels are unknown
+  m_States = std::make_unique<StateType[]>(numberOfPixels);
+
+  TotalProgressReporter progress(filter, numberOfPixels, 100, progressWeight);
+
+  // The seeds are all marked before their runs are extended, so that a run
+  // stops at the next seed
+  SeedsContainerType claimedSeeds;
+  for (const IndexType & seed : seeds)
+  {
+    if (m_Region.IsInside(seed) && m_States[this->ComputeOffset(seed)].exchange(Included) != Included)
+    {
+      claimedSeeds.push_back(seed);
+    }
+  }
+
+  RunsContainerType frontier;
+  for (const IndexType & seed : claimedSeeds)
+  {
+    StateType * line = m_States.get() + this->ComputeOffset(seed) - (seed[0] - m_Region.GetIndex(0));
+    this->ExtendRun(line, seed, isIncluded, frontier);
+  }
+
+  while (!frontier.empty())
+  {
+    SizeValueType frontierPixels = 0;
+    for (const RunType & run : frontier)
+    {
+      frontierPixels += run.m_Length;
+    }
+    m_NumberOfPixels += frontierPixels;
+    progress.Completed(frontierPixels);
+
+    // Small frontiers are not worth being split
+    SizeValueType numberOfWorkUnits = 1;
+    if (multiThreader != nullptr)
+    {
+      numberOfWorkUnits = std::min(static_cast<SizeValueType>(multiThreader->GetNumberOfWorkUnits()),
+                                   static_cast<SizeValueType>(frontier.size()) / MinimumRunsPerWorkUnit);
+    }
+
+    RunsContainerType next;
+    if (numberOfWorkUnits <= 1)
+    {
+      for (const RunType & run : frontier)
+      {
+        this->ProcessRun(run, isIncluded, next);
+      }
+    }
+    else
+    {
+      std::vector<RunsContainerType> workUnitRuns(numberOfWorkUnits);
+      const auto                     numberOfRuns = static_cast<SizeValueType>(frontier.size());
+      multiThreader->ParallelizeArray(
+        0,
+        numberOfWorkUnits,
+        [&](SizeValueType workUnit) {
+          const SizeValueType first = numberOfRuns * workUnit / numberOfWorkUnits;
+          const SizeValueType last = numberOfRuns * (workUnit + 1) / numberOfWorkUnits;
+          for (SizeValueType i = first; i < last; ++i)
+          {
+            this->ProcessRun(frontier[i], isIncluded, workUnitRuns[workUnit]);
+          }
+        },
+        nullptr);
+      for (const RunsContainerType & runs : workUnitRuns)
+      {
+        next.insert(next.end(), runs.begin(), runs.end());
+      }
+    }
+
+    m_Runs.insert(m_Runs.end(), frontier.begin(), frontier.end());
+    frontier.swap(next);
+  }
+  m_States.reset();
+
+  // The pixels are the same whatever the order of the claims, but not
+  // their runs: sorting and merging them gives the same runs every time
+  std::sort(m_Runs.begin(), m_Runs.end(), [](const RunType & run1, const RunType & run2) {
+    for (unsigned int d = VDimension; d > 0; --d)
+    {
+      if (run1.m_Index[d - 1] != run2.m_Index[d - 1])
+      {
+        return run1.m_Index[d - 1] < run2.m_Index[d - 1];
+      }
+    }
+    return false;
+  });
+
+  auto merged = m_Runs.begin();
+  for (auto it = m_Runs.begin(); it != m_Runs.end(); ++it)
+  {
+    if (it == merged)
+    {
+      continue;
+    }
+    bool sameLine = true;
+    for (unsigned int d = 1; d < VDimension; ++d)
+    {
+      sameLine = sameLine && merged->m_Index[d] == it->m_Index[d];
+    }
+    if (sameLine && merged->m_Index[0] + static_cast<IndexValueType>(merged->m_Length) == it->m_Index[0])
+    {
+      merged->m_Length += it->m_Length;
+    }
+    else
+    {
+      *++merged = *it;
+    }
+  }
+  if (!m_Runs.empty())
+  {
+    m_Runs.erase(merged + 1, m_Runs.end());
+  }
+}
+
+template <unsigned int VDimension>
+template <typename TPredicate>
+bool
+ParallelFloodFill<VDimension>::Claim(StateType * line, const IndexType & index, const TPredicate & isIncluded) const
+{
+  StateType & state = line[index[0] - m_Region.GetIndex(0)];
+  if (state.load(std::memory_order_relaxed) != Unknown)
+  {
+    return false;
+  }
+
+  // Another thread may evaluate the same pixel at the same time: only one
+  // of them claims it
+  uint8_t expected = Unknown;
+  if (isIncluded(index))
+  {
+    return state.compare_exchange_strong(expected, Included, std::memory_order_relaxed);
+  }
+  state.compare_exchange_strong(expected, Excluded, std::memory_order_relaxed);
+  return false;
+}
+
+template <unsigned int VDimension>
+template <typename TPredicate>
+IndexValueType
+ParallelFloodFill<VDimension>::ExtendRun(StateType *        line,
+                                         IndexType          index,
+                                         const TPredicate & isIncluded,
+                                         RunsContainerType & runs) const
+{
+  const IndexValueType firstX = m_Region.GetIndex(0);
+  const IndexValueType lastX = firstX + static_cast<IndexValueType>(m_Region.GetSize(0)) - 1;
+
+  IndexType      neighbor = index;
+  IndexValueType first = index[0];
+  for (neighbor[0] = first - 1; neighbor[0] >= firstX && this->Claim(line, neighbor, isIncluded); --neighbor[0])
+  {
+    first = neighbor[0];
+  }
+  IndexValueType last = index[0];
+  for (neighbor[0] = last + 1; neighbor[0] <= lastX && this->Claim(line, neighbor, isIncluded); ++neighbor[0])
+  {
+    last = neighbor[0];
+  }
+
+  index[0] = first;
+  runs.push_back(RunType{ index, static_cast<SizeValueType>(last - first + 1) });
+  return last;
+}
+
+template <unsigned int VDimension>
+template <typename TPredicate>
+void
+ParallelFloodFill<VDimension>::ProcessRun(const RunType &     run,
+                                          const TPredicate &  isIncluded,
+                                          RunsContainerType & runs) const
+{
+  const IndexValueType firstX = m_Region.GetIndex(0);
+  const IndexValueType lastX = firstX + static_cast<IndexValueType>(m_Region.GetSize(0)) - 1;
+
+  // The diagonal neighbors of the ends of the run are on the next lines
+  // when all the neighbors are connected
+  const IndexValueType extension = m_FullyConnected ? 1 : 0;
+  const IndexValueType first = std::max(run.m_Index[0] - extension, firstX);
+  const IndexValueType last =
+    std::min(run.m_Index[0] + static_cast<IndexValueType>(run.m_Length) - 1 + extension, lastX);
+
+  IndexType lineIndex = run.m_Index;
+  lineIndex[0] = firstX;
+  const OffsetValueType lineOffset = this->ComputeOffset(lineIndex);
+
+  for (unsigned int i = 0; i < m_LineOffsets.size(); ++i)
+  {
+    IndexType index = lineIndex + m_LineOffsets[i];
+    if (!m_Region.IsInside(index))
+    {
+      continue;
+    }
+    StateType * line = m_States.get() + lineOffset + m_LineStrides[i];
+    for (index[0] = first; index[0] <= last; ++index[0])
+    {
+      if (this->Claim(line, index, isIncluded))
+      {
+        index[0] = this->ExtendRun(line, index, isIncluded, runs);
+      }
+    }
+  }
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkParallelFloodFill.h"
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include <cstdlib>
+#include <iostream>
+#include <queue>
+#include <random>
+
+/*
+ * Fill random images with one and several threads, and check that the pixels
+ * filled are those of a breadth first search, in sorted and merged runs.
+ */
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<unsigned char, Dimension>;
+using FloodFillType = itk::ParallelFloodFill<Dimension>;
+
+int
+itkParallelFloodFillTestRun(const ImageType * image, bool fullyConnected, itk::MultiThreaderBase * multiThreader)
+{
+  FloodFillType::SeedsContainerType seeds;
+  for (int i = 0; i < 3; ++i)
+  {
+    FloodFillType::IndexType seed;
+    seed.Fill(20 * i + 3);
+    seeds.push_back(seed);
+  }
+
+  // The reference fill, a breadth first search from the seeds
+  auto reference = ImageType::New();
+  reference->SetRegions(image->GetBufferedRegion());
+  reference->Allocate(true);
+  std::queue<ImageType::IndexType> queue;
+  for (const auto & seed : seeds)
+  {
+    reference->SetPixel(seed, 1);
+    queue.push(seed);
+  }
+  while (!queue.empty())
+  {
+    const ImageType::IndexType index = queue.front();
+    queue.pop();
+    for (int n = 0; n < 27; ++n)
+    {
+      const ImageType::OffsetType offset = { { n % 3 - 1, n / 3 % 3 - 1, n / 9 - 1 } };
+      const int                   distance = std::abs(offset[0]) + std::abs(offset[1]) + std::abs(offset[2]);
+      const ImageType::IndexType  neighbor = index + offset;
+      if ((distance == 1 || (fullyConnected && distance > 1)) && reference->GetBufferedRegion().IsInside(neighbor) &&
+          reference->GetPixel(neighbor) == 0 && image->GetPixel(neighbor) != 0)
+      {
+        reference->SetPixel(neighbor, 1);
+        queue.push(neighbor);
+      }
+    }
+  }
+
+  FloodFillType floodFill(image->GetBufferedRegion());
+  floodFill.SetFullyConnected(fullyConnected);
+  floodFill.Fill(
+    seeds,
+    [image](const FloodFillType::IndexType & index) { return image->GetPixel(index) != 0; },
+    multiThreader,
+    nullptr);
+
+  auto filled = ImageType::New();
+  filled->SetRegions(image->GetBufferedRegion());
+  filled->Allocate(true);
+  const FloodFillType::RunType * previous = nullptr;
+  for (const FloodFillType::RunType & run : floodFill.GetRuns())
+  {
+    // The runs are ordered, and two runs of the same line are not adjacent
+    const auto start = static_cast<itk::SizeValueType>(filled->ComputeOffset(run.m_Index));
+    if (previous != nullptr &&
+        (filled->ComputeOffset(previous->m_Index) + previous->m_Length + (run.m_Index[0] > 0 ? 1 : 0) > start))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The run at " << run.m_Index << " is not after the run at " << previous->m_Index << std::endl;
+      return EXIT_FAILURE;
+    }
+    FloodFillType::IndexType index = run.m_Index;
+    for (itk::SizeValueType i = 0; i < run.m_Length; ++i, ++index[0])
+    {
+      filled->SetPixel(index, 1);
+    }
+    previous = &run;
+  }
+
+  itk::SizeValueType                       numberOfPixels = 0;
+  itk::ImageRegionConstIterator<ImageType> rit(reference, reference->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> fit(filled, filled->GetBufferedRegion());
+  for (; !rit.IsAtEnd(); ++rit, ++fit)
+  {
+    if (rit.Get() != fit.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The pixel " << rit.GetIndex() << " is " << static_cast<int>(fit.Get()) << " instead of "
+                << static_cast<int>(rit.Get()) << std::endl;
+      return EXIT_FAILURE;
+    }
+    numberOfPixels += rit.Get();
+  }
+
+  if (floodFill.GetNumberOfPixels() != numberOfPixels)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The number of pixels filled is " << floodFill.GetNumberOfPixels() << " instead of "
+              << numberOfPixels << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkParallelFloodFillTest(int, char *[])
+{
+  // Keep 55% of the pixels, so that the component of the seeds is large and
+  // its frontiers are split between the threads
+  ImageType::SizeType size;
+  size.Fill(64);
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  std::mt19937                           generator(0);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(distribution(generator) < 0.55 ? 1 : 0);
+  }
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(8);
+
+  for (bool fullyConnected : { false, true })
+  {
+    if (itkParallelFloodFillTestRun(image, fullyConnected, nullptr) != EXIT_SUCCESS ||
+        itkParallelFloodFillTestRun(image, fullyConnected, multiThreader) != EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
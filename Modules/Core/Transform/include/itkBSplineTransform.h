@@ -238,6 +238,15 @@ public:
                  ParameterIndexArrayType & indices,
                  bool &                    inside) const override;
 
+  /** Transform the equally spaced points firstPoint + k * step. The position
+   * in the coefficient grid is computed once for the line and incremented for
+   * each point, and the coefficients are read directly from the buffers. */
+  void
+  TransformPointsAlongLine(const InputPointType &  firstPoint,
+                           const InputVectorType & step,
+                           SizeValueType           numberOfPoints,
+                           OutputPointType *       outputPoints) const override;
+
   /** Compute the Jacobian in one position. */
   void
   ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override;
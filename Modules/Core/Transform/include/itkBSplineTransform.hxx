@@ -597,6 +597,105 @@ BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoint
   }
 }
 
+template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
+void
+BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPointsAlongLine(
+  const InputPointType &  firstPoint,
+  const InputVectorType & step,
+  SizeValueType           numberOfPoints,
+  OutputPointType *       outputPoints) const
+{
+  const ImageType * coefficientImage = this->m_CoefficientImages[0];
+  if (!coefficientImage->GetBufferPointer())
+  {
+    Superclass::TransformPointsAlongLine(firstPoint, step, numberOfPoints, outputPoints);
+    return;
+  }
+
+  // Position of the first point, and increment between the points, in the coefficient grid
+  const ContinuousIndexType firstIndex =
+    coefficientImage->template TransformPhysicalPointToContinuousIndex<typename ContinuousIndexType::ValueType>(
+      firstPoint);
+  const DirectionType & inverseDirection = coefficientImage->GetInverseDirection();
+  const SpacingType &   spacing = coefficientImage->GetSpacing();
+  ContinuousIndexType   indexStep;
+  for (unsigned int i = 0; i < SpaceDimension; ++i)
+  {
+    indexStep[i] = 0.0;
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      indexStep[i] += inverseDirection[i][j] * step[j];
+    }
+    indexStep[i] /= spacing[i];
+  }
+
+  // Buffer offsets of the coefficients of the support region, in the order of the weights
+  const OffsetValueType *                            offsetTable = coefficientImage->GetOffsetTable();
+  FixedArray<OffsetValueType, Self::NumberOfWeights> supportOffsets;
+  for (unsigned int w = 0; w < Self::NumberOfWeights; ++w)
+  {
+    unsigned int    remainder = w;
+    OffsetValueType offset = 0;
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      offset += static_cast<OffsetValueType>(remainder % (SplineOrder + 1)) * offsetTable[d];
+      remainder /= SplineOrder + 1;
+    }
+    supportOffsets[w] = offset;
+  }
+
+  const IndexType             bufferStart = coefficientImage->GetBufferedRegion().GetIndex();
+  const ParametersValueType * coefficients[SpaceDimension];
+  for (unsigned int j = 0; j < SpaceDimension; ++j)
+  {
+    coefficients[j] = this->m_CoefficientImages[j]->GetBufferPointer();
+  }
+
+  WeightsType weights;
+  IndexType   supportIndex;
+  for (SizeValueType k = 0; k < numberOfPoints; ++k)
+  {
+    const auto           kk = static_cast<ScalarType>(k);
+    const InputPointType point = firstPoint + step * kk;
+    ContinuousIndexType  index;
+    for (unsigned int i = 0; i < SpaceDimension; ++i)
+    {
+      index[i] = firstIndex[i] + kk * indexStep[i];
+    }
+
+    // NOTE: if the support region does not lie totally within the grid
+    // we assume zero displacement and return the input point
+    if (!this->InsideValidRegion(index))
+    {
+      outputPoints[k] = point;
+      continue;
+    }
+
+    this->m_WeightsFunction->Evaluate(index, weights, supportIndex);
+
+    OffsetValueType supportStart = 0;
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      supportStart += (supportIndex[d] - bufferStart[d]) * offsetTable[d];
+    }
+
+    OutputPointType & outputPoint = outputPoints[k];
+    outputPoint.Fill(NumericTraits<ScalarType>::ZeroValue());
+    for (unsigned int w = 0; w < Self::NumberOfWeights; ++w)
+    {
+      const OffsetValueType offset = supportStart + supportOffsets[w];
+      for (unsigned int j = 0; j < SpaceDimension; ++j)
+      {
+        outputPoint[j] += static_cast<ScalarType>(weights[w] * coefficients[j][offset]);
+      }
+    }
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      outputPoint[j] += point[j];
+    }
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
 void
 BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::ComputeJacobianWithRespectToParameters(
@@ -194,6 +194,20 @@ public:
   virtual OutputPointType
   TransformPoint(const InputPointType &) const = 0;
 
+  /** Method to transform the equally spaced points firstPoint + k * step,
+   * for k in [0, numberOfPoints), such as the points of a scanline of an
+   * image. The default implementation calls TransformPoint() for each point.
+   * Transforms defined on a grid override it to set up the grid lookup once
+   * per line instead of once per point.
+   * \warning This method must be thread-safe. See, e.g., its use
+   * in ResampleImageFilter.
+   */
+  virtual void
+  TransformPointsAlongLine(const InputPointType &  firstPoint,
+                           const InputVectorType & step,
+                           SizeValueType           numberOfPoints,
+                           OutputPointType *       outputPoints) const;
+
   /**  Method to transform a vector. */
   virtual OutputVectorType
   TransformVector(const InputVectorType &) const
@@ -119,6 +119,21 @@ Transform<TParametersValueType, VInputDimension, VOutputDimension>::UpdateTransf
 }
 
 
+template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
+void
+Transform<TParametersValueType, VInputDimension, VOutputDimension>::TransformPointsAlongLine(
+  const InputPointType &  firstPoint,
+  const InputVectorType & step,
+  SizeValueType           numberOfPoints,
+  OutputPointType *       outputPoints) const
+{
+  for (SizeValueType k = 0; k < numberOfPoints; ++k)
+  {
+    outputPoints[k] = this->TransformPoint(firstPoint + step * static_cast<TParametersValueType>(k));
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
 typename Transform<TParametersValueType, VInputDimension, VOutputDimension>::OutputVectorType
 Transform<TParametersValueType, VInputDimension, VOutputDimension>::TransformVector(const InputVectorType & vector,
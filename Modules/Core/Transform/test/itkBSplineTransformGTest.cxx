@@ -205,3 +205,50 @@ TEST(ITKBSplineTransform, NumberOfWeights)
   testNumberOfWeights(*itk::BSplineTransform<float, 2>::New());
   testNumberOfWeights(*itk::BSplineTransform<float, 2, 2>::New());
 }
+
+
+TEST(ITKBSplineTransform, TransformPointsAlongLine)
+{
+  using namespace itk::GTest::TypedefsAndConstructors::Dimension2;
+
+  using BSplineType = itk::BSplineTransform<double, 2, 3>;
+
+  DirectionType direction;
+  direction(0, 0) = 0.6;
+  direction(0, 1) = -0.8;
+  direction(1, 0) = 0.8;
+  direction(1, 1) = 0.6;
+
+  auto bspline = BSplineType::New();
+  bspline->SetTransformDomainOrigin(itk::MakePoint(-2.0, 1.0));
+  bspline->SetTransformDomainPhysicalDimensions(itk::MakeVector(20.0, 15.0));
+  bspline->SetTransformDomainDirection(direction);
+  bspline->SetTransformDomainMeshSize(itk::MakeSize(5, 4));
+
+  BSplineType::ParametersType parameters(bspline->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.Size(); ++i)
+  {
+    parameters[i] = std::sin(0.7 * i);
+  }
+  bspline->SetParameters(parameters);
+
+  // The line enters and leaves the transform domain
+  const auto                                firstPoint = itk::MakePoint(-20.0, 5.0);
+  const auto                                step = itk::MakeVector(0.45, 0.2);
+  constexpr itk::SizeValueType              numberOfPoints = 80;
+  std::vector<BSplineType::OutputPointType> outputPoints(numberOfPoints);
+  bspline->TransformPointsAlongLine(firstPoint, step, numberOfPoints, outputPoints.data());
+
+  unsigned int numberOfDisplacedPoints = 0;
+  for (itk::SizeValueType k = 0; k < numberOfPoints; ++k)
+  {
+    const BSplineType::InputPointType point = firstPoint + step * static_cast<double>(k);
+    ITK_EXPECT_VECTOR_NEAR(outputPoints[k], bspline->TransformPoint(point), 1e-12) << "Point " << k;
+    if (outputPoints[k].EuclideanDistanceTo(point) > 1e-6)
+    {
+      ++numberOfDisplacedPoints;
+    }
+  }
+  EXPECT_GT(numberOfDisplacedPoints, 0u);
+  EXPECT_LT(numberOfDisplacedPoints, numberOfPoints);
+}
@@ -23,8 +23,36 @@
 #include "itkProgressAccumulator.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 
+#include <memory>
+#include <type_traits>
+#include <vector>
+
 namespace itk
 {
+/** \class ConvolutionImageFilterEnums
+ * \brief Contains all enum classes used by ConvolutionImageFilter class.
+ * \ingroup ITKConvolution
+ */
+class ConvolutionImageFilterEnums
+{
+public:
+  /**
+   * \class ConvolutionAlgorithm
+   * \ingroup ITKConvolution
+   * Algorithm used to compute the convolution
+   */
+  enum class ConvolutionAlgorithm : uint8_t
+  {
+    AUTOMATIC = 0,
+    DIRECT,
+    SEPARABLE,
+    FFT
+  };
+};
+/** Define how to print enumerations */
+extern ITKConvolution_EXPORT std::ostream &
+                             operator<<(std::ostream & out, const ConvolutionImageFilterEnums::ConvolutionAlgorithm value);
+
 /**
  * \class ConvolutionImageFilter
  * \brief Convolve a given image with an arbitrary image kernel.
@@ -43,6 +71,29 @@ namespace itk
  * The kernel can optionally be normalized to sum to 1 using
  * NormalizeOn(). Normalization is off by default.
  *
+ * The convolution is computed with one of the following algorithms,
+ * selected with SetAlgorithm():
+ * - DIRECT computes the inner product at each pixel, with a cost
+ *   proportional to the number of pixels of the kernel.
+ * - SEPARABLE decomposes the kernel into a sum of outer products of 1-D
+ *   kernels, and convolves the image with each 1-D kernel along its axis
+ *   in turn, with a cost proportional to the sum of the sizes of the kernel
+ *   times the number of terms. Kernels such as Gaussian or box kernels
+ *   have a single term. 2-D kernels are decomposed with a singular value
+ *   decomposition, so that kernels of low rank such as differences of
+ *   Gaussians have a few terms. Kernels of higher dimensions are decomposed
+ *   only when they have a single term. The boundary condition must be zero
+ *   flux Neumann, periodic, or constant with a zero constant, which are the
+ *   boundary conditions that commute with the 1-D convolutions.
+ * - FFT computes the convolution with FFTConvolutionImageFilter.
+ * - AUTOMATIC, the default, estimates the cost of the possible algorithms
+ *   from the sizes of the kernel and of the image, and selects the cheapest
+ *   one. SEPARABLE and FFT are only selected for outputs of floating point
+ *   pixel types, as their round-off errors could change the truncation of
+ *   integer outputs, so that integer outputs are those of DIRECT.
+ *
+ * The algorithm used by the last update is given by GetSelectedAlgorithm().
+ *
  * \warning This filter ignores the spacing, origin, and orientation
  * of the kernel image and treats them as identical to those in the
  * input image.
@@ -98,10 +149,34 @@ public:
   using OutputRegionType = typename OutputImageType::RegionType;
   using KernelRegionType = typename KernelImageType::RegionType;
 
+  using ConvolutionAlgorithmEnum = ConvolutionImageFilterEnums::ConvolutionAlgorithm;
+
+  /** Set/Get the algorithm used to compute the convolution. Defaults to
+   * AUTOMATIC. */
+  itkSetEnumMacro(Algorithm, ConvolutionAlgorithmEnum);
+  itkGetEnumMacro(Algorithm, ConvolutionAlgorithmEnum);
+
+  /** Get the algorithm used by the last update. */
+  itkGetEnumMacro(SelectedAlgorithm, ConvolutionAlgorithmEnum);
+
+  /** Set/Get the tolerance of the decomposition of the kernel into 1-D
+   * kernels, relative to the largest singular value of 2-D kernels and to the
+   * largest absolute value of the other kernels. The terms of smaller
+   * singular values are dropped, and kernels of more than two dimensions are
+   * considered separable when they differ from a single outer product by less
+   * than the tolerance. Defaults to 1e-6. */
+  itkSetMacro(KernelDecompositionTolerance, double);
+  itkGetConstMacro(KernelDecompositionTolerance, double);
+
 protected:
   ConvolutionImageFilter() = default;
   ~ConvolutionImageFilter() override = default;
 
+  /** The 1-D kernels of an outer product, one per dimension, and the
+   * decomposition of a kernel into a sum of such products. */
+  using KernelFactorsType = std::vector<std::vector<double>>;
+  using KernelDecompositionType = std::vector<KernelFactorsType>;
+
   /** ConvolutionImageFilter needs the entire image kernel, which in
    * general is going to be a different size then the output requested
    * region. As such, this filter needs to provide an implementation
@@ -130,10 +205,50 @@ protected:
   KernelSizeType
   GetKernelRadius(const TImage * kernelImage) const;
 
+  /** Decompose the kernel, normalized if requested, into a sum of outer
+   * products of 1-D kernels. Returns false if the kernel cannot be
+   * decomposed. */
+  bool
+  DecomposeKernel(KernelDecompositionType & decomposition) const;
+
+  /** Select the algorithm for the requested algorithm, the kernel
+   * decomposition and the size of the output requested region. */
+  ConvolutionAlgorithmEnum
+  SelectAlgorithm(const KernelDecompositionType & decomposition, bool kernelIsDecomposed) const;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
 private:
+  /** Whether the output pixel type is floating point, which is required to
+   * select the separable and FFT algorithms automatically. */
+  static constexpr bool OutputIsFloatingPoint =
+    std::is_floating_point<typename NumericTraits<OutputPixelType>::ValueType>::value;
+
+  /** Image type of the 1-D convolutions of the separable algorithm. */
+  using SeparableImageType = Image<double, ImageDimension>;
+  using SeparableBoundaryConditionType = ImageBoundaryCondition<SeparableImageType>;
+
+  /** Create the boundary condition of the intermediate images of the
+   * separable algorithm, of the same kind as the boundary condition of the
+   * input. Returns nullptr if the boundary condition does not give the same
+   * result when the convolution is computed one dimension after the other. */
+  std::unique_ptr<SeparableBoundaryConditionType>
+  MakeSeparableBoundaryCondition() const;
+
   template <typename TImage>
   void
   ComputeConvolution(const TImage * kernelImage, ProgressAccumulator * progress);
+
+  void
+  ComputeSeparableConvolution(const KernelDecompositionType & decomposition, ProgressAccumulator * progress);
+
+  void
+  ComputeFFTConvolution(ProgressAccumulator * progress);
+
+  ConvolutionAlgorithmEnum m_Algorithm{ ConvolutionAlgorithmEnum::AUTOMATIC };
+  ConvolutionAlgorithmEnum m_SelectedAlgorithm{ ConvolutionAlgorithmEnum::DIRECT };
+  double                   m_KernelDecompositionTolerance{ 1e-6 };
 };
 } // namespace itk
 
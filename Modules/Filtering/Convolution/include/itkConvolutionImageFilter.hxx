@@ -20,13 +20,22 @@
 #define itkConvolutionImageFilter_hxx
 
 
+#include "itkAddImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkConstantBoundaryCondition.h"
 #include "itkConstantPadImageFilter.h"
 #include "itkCropImageFilter.h"
+#include "itkFFTConvolutionImageFilter.h"
 #include "itkFlipImageFilter.h"
 #include "itkImageBase.h"
 #include "itkImageKernelOperator.h"
+#include "itkImageRegionConstIterator.h"
 #include "itkNeighborhoodOperatorImageFilter.h"
 #include "itkNormalizeToConstantImageFilter.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "vnl/algo/vnl_svd.h"
+
+#include <cmath>
 
 namespace itk
 {
@@ -34,13 +43,32 @@ template <typename TInputImage, typename TKernelImage, typename TOutputImage>
 void
 ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::GenerateData()
 {
-  // Allocate the output
-  this->AllocateOutputs();
-
   // Create a process accumulator for tracking the progress of this minipipeline
   auto progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
 
+  KernelDecompositionType decomposition;
+  const bool              kernelIsDecomposed =
+    ((m_Algorithm == ConvolutionAlgorithmEnum::AUTOMATIC && OutputIsFloatingPoint) ||
+     m_Algorithm == ConvolutionAlgorithmEnum::SEPARABLE) &&
+    this->MakeSeparableBoundaryCondition() != nullptr && this->DecomposeKernel(decomposition);
+  m_SelectedAlgorithm = this->SelectAlgorithm(decomposition, kernelIsDecomposed);
+
+  if (m_SelectedAlgorithm == ConvolutionAlgorithmEnum::FFT)
+  {
+    this->ComputeFFTConvolution(progress);
+    return;
+  }
+
+  // Allocate the output
+  this->AllocateOutputs();
+
+  if (m_SelectedAlgorithm == ConvolutionAlgorithmEnum::SEPARABLE)
+  {
+    this->ComputeSeparableConvolution(decomposition, progress);
+    return;
+  }
+
   // Build a mini-pipeline that involves a
   // NeighborhoodOperatorImageFilter to compute the convolution, a
   // normalization filter for the kernel, and a pad filter for making
@@ -187,6 +215,346 @@ ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::ComputeConvolut
   }
 }
 
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+void
+ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::ComputeSeparableConvolution(
+  const KernelDecompositionType & decomposition,
+  ProgressAccumulator *           progress)
+{
+  using FirstFilterType = NeighborhoodOperatorImageFilter<InputImageType, SeparableImageType, double>;
+  using IntermediateFilterType = NeighborhoodOperatorImageFilter<SeparableImageType, SeparableImageType, double>;
+  using OperatorType = typename FirstFilterType::OutputNeighborhoodType;
+
+  // The convolution flips the 1-D kernels. Kernels of even size are padded
+  // at their lower bound, so that they are centered like the kernel of the
+  // direct convolution.
+  auto makeOperator = [](const std::vector<double> & kernel, unsigned int dimension) {
+    const SizeValueType            paddedSize = kernel.size() + 1 - kernel.size() % 2;
+    typename OperatorType::SizeType radius;
+    radius.Fill(0);
+    radius[dimension] = paddedSize / 2;
+    OperatorType op;
+    op.SetRadius(radius);
+    for (SizeValueType i = 0; i < paddedSize; ++i)
+    {
+      op[i] = 0.0;
+    }
+    for (SizeValueType i = 0; i < kernel.size(); ++i)
+    {
+      op[paddedSize - 1 - i] = kernel[i];
+    }
+    return op;
+  };
+
+  const std::unique_ptr<SeparableBoundaryConditionType> boundaryCondition = this->MakeSeparableBoundaryCondition();
+  const OutputRegionType                                requestedRegion = this->GetOutput()->GetRequestedRegion();
+  const float                                           passWeight =
+    1.0f / static_cast<float>(decomposition.size() * (ImageDimension + 1));
+
+  auto localInput = InputImageType::New();
+  localInput->Graft(this->GetInput());
+
+  // Convolve the input with the 1-D kernels of each term along each dimension
+  // in turn, and sum the terms.
+  typename SeparableImageType::Pointer sum;
+  for (const KernelFactorsType & factors : decomposition)
+  {
+    auto firstFilter = FirstFilterType::New();
+    firstFilter->SetOperator(makeOperator(factors[0], 0));
+    firstFilter->OverrideBoundaryCondition(this->GetBoundaryCondition());
+    firstFilter->SetInput(localInput);
+    firstFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    progress->RegisterInternalFilter(firstFilter, passWeight);
+
+    typename SeparableImageType::Pointer                  term = firstFilter->GetOutput();
+    std::vector<typename IntermediateFilterType::Pointer> filters;
+    for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+    {
+      auto filter = IntermediateFilterType::New();
+      filter->SetOperator(makeOperator(factors[dim], dim));
+      filter->OverrideBoundaryCondition(boundaryCondition.get());
+      filter->SetInput(term);
+      filter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+      progress->RegisterInternalFilter(filter, passWeight);
+      term->ReleaseDataFlagOn();
+      filters.push_back(filter);
+      term = filter->GetOutput();
+    }
+    term->SetRequestedRegion(requestedRegion);
+    term->Update();
+    term->DisconnectPipeline();
+
+    if (sum.IsNull())
+    {
+      sum = term;
+    }
+    else
+    {
+      using AddFilterType = AddImageFilter<SeparableImageType>;
+      auto addFilter = AddFilterType::New();
+      addFilter->SetInput1(sum);
+      addFilter->SetInput2(term);
+      addFilter->InPlaceOn();
+      addFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+      progress->RegisterInternalFilter(addFilter, passWeight);
+      addFilter->Update();
+      sum = addFilter->GetOutput();
+      sum->DisconnectPipeline();
+    }
+  }
+
+  using CastFilterType = CastImageFilter<SeparableImageType, OutputImageType>;
+  auto castFilter = CastFilterType::New();
+  castFilter->SetInput(sum);
+  castFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  castFilter->GraftOutput(this->GetOutput());
+  castFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+  progress->RegisterInternalFilter(castFilter, passWeight * decomposition.size());
+  castFilter->Update();
+
+  // Set the largest possible region to the one of the selected output region mode
+  if (this->GetOutputRegionMode() == ConvolutionImageFilterBaseEnums::ConvolutionImageFilterOutputRegion::SAME)
+  {
+    castFilter->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+  }
+  else
+  {
+    castFilter->GetOutput()->SetLargestPossibleRegion(this->GetValidRegion());
+  }
+  this->GraftOutput(castFilter->GetOutput());
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+void
+ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::ComputeFFTConvolution(ProgressAccumulator * progress)
+{
+  using FFTConvolutionFilterType = FFTConvolutionImageFilter<InputImageType, KernelImageType, OutputImageType>;
+
+  auto localInput = InputImageType::New();
+  localInput->Graft(this->GetInput());
+
+  auto fftConvolutionFilter = FFTConvolutionFilterType::New();
+  fftConvolutionFilter->SetInput(localInput);
+  fftConvolutionFilter->SetKernelImage(this->GetKernelImage());
+  fftConvolutionFilter->SetNormalize(this->GetNormalize());
+  fftConvolutionFilter->SetBoundaryCondition(this->GetBoundaryCondition());
+  fftConvolutionFilter->SetOutputRegionMode(this->GetOutputRegionMode());
+  fftConvolutionFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  progress->RegisterInternalFilter(fftConvolutionFilter, 1.0f);
+  fftConvolutionFilter->GetOutput()->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
+  fftConvolutionFilter->Update();
+
+  this->GraftOutput(fftConvolutionFilter->GetOutput());
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+bool
+ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::DecomposeKernel(
+  KernelDecompositionType & decomposition) const
+{
+  decomposition.clear();
+
+  const KernelImageType * kernel = this->GetKernelImage();
+  const KernelRegionType  kernelRegion = kernel->GetLargestPossibleRegion();
+  const KernelSizeType    kernelSize = kernelRegion.GetSize();
+
+  // The kernel values, with the first dimension varying fastest
+  std::vector<double> values;
+  values.reserve(kernelRegion.GetNumberOfPixels());
+  double sum = 0.0;
+  for (ImageRegionConstIterator<KernelImageType> it(kernel, kernelRegion); !it.IsAtEnd(); ++it)
+  {
+    values.push_back(static_cast<double>(it.Get()));
+    sum += values.back();
+  }
+  if (this->GetNormalize())
+  {
+    if (sum == 0.0)
+    {
+      return false;
+    }
+    for (double & value : values)
+    {
+      value /= sum;
+    }
+  }
+
+  if (ImageDimension == 2)
+  {
+    // The rows of the matrix are along the second dimension
+    vnl_matrix<double> matrix(values.size() / kernelSize[0], kernelSize[0]);
+    for (unsigned int row = 0; row < matrix.rows(); ++row)
+    {
+      for (unsigned int column = 0; column < matrix.cols(); ++column)
+      {
+        matrix(row, column) = values[row * matrix.cols() + column];
+      }
+    }
+    const vnl_svd<double>           svd(matrix);
+    const vnl_diag_matrix<double> & singularValues = svd.W();
+    const vnl_matrix<double> &      columnVectors = svd.V();
+    const vnl_matrix<double> &      rowVectors = svd.U();
+    if (singularValues(0, 0) == 0.0)
+    {
+      return false;
+    }
+    const double smallestSingularValue = m_KernelDecompositionTolerance * singularValues(0, 0);
+    for (unsigned int term = 0; term < singularValues.rows() && singularValues(term, term) > smallestSingularValue;
+         ++term)
+    {
+      KernelFactorsType factors(ImageDimension);
+      for (unsigned int column = 0; column < matrix.cols(); ++column)
+      {
+        factors[0].push_back(columnVectors(column, term));
+      }
+      for (unsigned int row = 0; row < matrix.rows(); ++row)
+      {
+        factors[1].push_back(singularValues(term, term) * rowVectors(row, term));
+      }
+      decomposition.push_back(factors);
+    }
+    return true;
+  }
+
+  // Other dimensions: the kernel is separable if it is the outer product of
+  // its lines through its value of largest magnitude.
+  SizeValueType largestOffset = 0;
+  for (SizeValueType i = 1; i < values.size(); ++i)
+  {
+    if (std::abs(values[i]) > std::abs(values[largestOffset]))
+    {
+      largestOffset = i;
+    }
+  }
+  const double largestValue = values[largestOffset];
+  if (largestValue == 0.0)
+  {
+    return false;
+  }
+
+  KernelFactorsType factors(ImageDimension);
+  SizeValueType     stride = 1;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    const SizeValueType position = (largestOffset / stride) % kernelSize[dim];
+    const SizeValueType lineStart = largestOffset - position * stride;
+    for (SizeValueType i = 0; i < kernelSize[dim]; ++i)
+    {
+      factors[dim].push_back(dim == 0 ? values[lineStart + i * stride] : values[lineStart + i * stride] / largestValue);
+    }
+    stride *= kernelSize[dim];
+  }
+
+  for (SizeValueType offset = 0; offset < values.size(); ++offset)
+  {
+    double        product = 1.0;
+    SizeValueType remainder = offset;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      product *= factors[dim][remainder % kernelSize[dim]];
+      remainder /= kernelSize[dim];
+    }
+    if (std::abs(values[offset] - product) > m_KernelDecompositionTolerance * std::abs(largestValue))
+    {
+      return false;
+    }
+  }
+  decomposition.push_back(factors);
+  return true;
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+auto
+ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::MakeSeparableBoundaryCondition() const
+  -> std::unique_ptr<SeparableBoundaryConditionType>
+{
+  const auto * boundaryCondition = this->GetBoundaryCondition();
+  if (dynamic_cast<const ZeroFluxNeumannBoundaryCondition<InputImageType> *>(boundaryCondition) != nullptr)
+  {
+    return std::make_unique<ZeroFluxNeumannBoundaryCondition<SeparableImageType>>();
+  }
+  if (dynamic_cast<const PeriodicBoundaryCondition<InputImageType> *>(boundaryCondition) != nullptr)
+  {
+    return std::make_unique<PeriodicBoundaryCondition<SeparableImageType>>();
+  }
+  const auto * constantBoundaryCondition =
+    dynamic_cast<const ConstantBoundaryCondition<InputImageType> *>(boundaryCondition);
+  if (constantBoundaryCondition != nullptr &&
+      Math::ExactlyEquals(constantBoundaryCondition->GetConstant(), NumericTraits<InputPixelType>::ZeroValue()))
+  {
+    return std::make_unique<ConstantBoundaryCondition<SeparableImageType>>();
+  }
+  return nullptr;
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+auto
+ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::SelectAlgorithm(
+  const KernelDecompositionType & decomposition,
+  bool                            kernelIsDecomposed) const -> ConvolutionAlgorithmEnum
+{
+  if (m_Algorithm == ConvolutionAlgorithmEnum::SEPARABLE && !kernelIsDecomposed)
+  {
+    itkExceptionMacro("The kernel cannot be decomposed into 1-D kernels, or the boundary condition "
+                      << this->GetBoundaryCondition()->GetNameOfClass()
+                      << " does not allow the separable convolution.");
+  }
+  if (m_Algorithm != ConvolutionAlgorithmEnum::AUTOMATIC)
+  {
+    return m_Algorithm;
+  }
+  // The round-off errors of the separable and FFT algorithms could change the
+  // truncation of integer outputs
+  if (!OutputIsFloatingPoint)
+  {
+    return ConvolutionAlgorithmEnum::DIRECT;
+  }
+
+  // Estimate the number of operations per output pixel of each algorithm
+  const KernelSizeType kernelSize = this->GetKernelImage()->GetLargestPossibleRegion().GetSize();
+  const OutputSizeType requestedSize = this->GetOutput()->GetRequestedRegion().GetSize();
+  double               directCost = 1.0;
+  double               separableCost = 0.0;
+  double               numberOfRequestedPixels = 1.0;
+  double               numberOfPaddedPixels = 1.0;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    directCost *= kernelSize[dim];
+    // Each 1-D pass also reads and writes a whole image
+    separableCost += kernelSize[dim] + 4.0;
+    numberOfRequestedPixels *= requestedSize[dim];
+    numberOfPaddedPixels *= requestedSize[dim] + 2 * (kernelSize[dim] / 2);
+  }
+  separableCost *= decomposition.size();
+
+  ConvolutionAlgorithmEnum algorithm = ConvolutionAlgorithmEnum::DIRECT;
+  double                   cost = directCost;
+  if (kernelIsDecomposed && separableCost < cost)
+  {
+    algorithm = ConvolutionAlgorithmEnum::SEPARABLE;
+    cost = separableCost;
+  }
+
+  // The forward transforms of the input and of the kernel, the inverse
+  // transform, and the padding and cropping of the images, measured in
+  // multiply-adds of the direct convolution
+  const double fftCost =
+    numberOfPaddedPixels / numberOfRequestedPixels * (3.0 * std::log2(numberOfPaddedPixels) + 10.0);
+  if (fftCost < cost)
+  {
+    using FFTConvolutionFilterType = FFTConvolutionImageFilter<InputImageType, KernelImageType, OutputImageType>;
+    try
+    {
+      // Check that an FFT implementation is available
+      FFTConvolutionFilterType::New();
+      algorithm = ConvolutionAlgorithmEnum::FFT;
+    }
+    catch (const ExceptionObject &)
+    {}
+  }
+  return algorithm;
+}
+
 template <typename TInputImage, typename TKernelImage, typename TOutputImage>
 bool
 ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::GetKernelNeedsPadding() const
@@ -280,5 +648,16 @@ ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::GenerateInputRe
     kernelPtr->SetRequestedRegionToLargestPossibleRegion();
   }
 }
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+void
+ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Algorithm: " << m_Algorithm << std::endl;
+  os << indent << "SelectedAlgorithm: " << m_SelectedAlgorithm << std::endl;
+  os << indent << "KernelDecompositionTolerance: " << m_KernelDecompositionTolerance << std::endl;
+}
 } // namespace itk
 #endif
@@ -41,6 +41,15 @@ namespace itk
  * of the kernel image and treats them as identical to those in the
  * input image.
  *
+ * With CacheKernelSpectrumOn(), the Fourier transform of the padded kernel
+ * is kept between updates, and reused as long as the kernel image is not
+ * modified or regenerated, and the size of the padded input and the
+ * normalization do not change, so that images of the same size are convolved
+ * with the same kernel without transforming the kernel again. The cache holds
+ * an image of the size of the Fourier transform of the padded input until the
+ * next update or the destruction of the filter, so it is off by default. The
+ * blocks of an update (BlockSize) always share the transform of the kernel.
+ *
  * This code was adapted from the Insight Journal contribution:
  *
  * "FFT Based Convolution"
@@ -112,6 +121,24 @@ public:
   itkSetMacro(SizeGreatestPrimeFactor, SizeValueType);
   itkGetMacro(SizeGreatestPrimeFactor, SizeValueType);
 
+  /** Set/Get whether the Fourier transform of the kernel is kept to be
+   * reused by the next updates. Defaults to false. */
+  itkSetMacro(CacheKernelSpectrum, bool);
+  itkGetConstMacro(CacheKernelSpectrum, bool);
+  itkBooleanMacro(CacheKernelSpectrum);
+
+  /** Set/Get the size of the blocks in which the output is computed. When the
+   * requested output region is larger than a block, it is tiled in blocks that
+   * are convolved one after the other with the overlap-save method: each block
+   * is padded with the kernel radius, multiplied by the Fourier transform of
+   * the kernel, and the valid part of the result is written to the output. The
+   * memory used by the Fourier transforms is then bounded by the block size
+   * rather than by the size of the image. A zero size in a dimension leaves
+   * that dimension undivided. Defaults to zero, i.e. the requested region is
+   * convolved in a single block. */
+  itkSetMacro(BlockSize, OutputSizeType);
+  itkGetConstReferenceMacro(BlockSize, OutputSizeType);
+
 protected:
   FFTConvolutionImageFilter();
   ~FFTConvolutionImageFilter() override = default;
@@ -134,6 +161,16 @@ protected:
   void
   GenerateData() override;
 
+  /** Convolve the requested output region block by block. */
+  void
+  GenerateDataInBlocks();
+
+  /** Get the size of the blocks the requested output region is tiled in. The
+   * block size is enlarged so that the padded blocks have sizes suitable for the
+   * FFT, and is limited to the size of the requested output region. */
+  OutputSizeType
+  GetFFTBlockSize() const;
+
   /** Prepare the input images for operations in the Fourier
    * domain. This includes resizing the input and kernel images,
    * normalizing the kernel if requested, shifting the kernel, and
@@ -170,7 +207,10 @@ protected:
 
   /** Prepare the kernel. This includes resizing the input and kernel
    * images, normalizing the kernel if requested, shifting the kernel,
-   * and taking the Fourier transform of the padded kernel. */
+   * and taking the Fourier transform of the padded kernel. The prepared
+   * kernel of the previous call is reused if the kernel and the size of the
+   * padded input have not changed, and CacheKernelSpectrum is on. The prepared
+   * kernel must not be modified. */
   void
   PrepareKernel(const KernelImageType *           kernel,
                 InternalComplexImagePointerType & preparedKernel,
@@ -208,8 +248,18 @@ protected:
 
 private:
   SizeValueType      m_SizeGreatestPrimeFactor;
+  OutputSizeType     m_BlockSize{ 0 };
   InternalSizeType   m_FFTPadSize{ 0 };
   InternalRegionType m_PaddedInputRegion;
+
+  // The Fourier transform of the last prepared kernel, with the times of the
+  // kernel and the parameters it was computed with
+  bool                            m_CacheKernelSpectrum{ false };
+  InternalComplexImagePointerType m_KernelSpectrum;
+  ModifiedTimeType                m_KernelSpectrumKernelMTime{ 0 };
+  ModifiedTimeType                m_KernelSpectrumKernelUpdateMTime{ 0 };
+  InternalSizeType                m_KernelSpectrumPaddedInputSize{ 0 };
+  bool                            m_KernelSpectrumNormalize{ false };
 };
 } // namespace itk
 
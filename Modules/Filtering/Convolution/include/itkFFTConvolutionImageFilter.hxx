@@ -25,6 +25,7 @@
 #include "itkCyclicShiftImageFilter.h"
 #include "itkExtractImageFilter.h"
 #include "itkFFTPadImageFilter.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageBase.h"
 #include "itkMultiplyImageFilter.h"
 #include "itkNormalizeToConstantImageFilter.h"
@@ -82,6 +83,17 @@ template <typename TInputImage, typename TKernelImage, typename TOutputImage, ty
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateData()
 {
+  const OutputSizeType requestedSize = this->GetOutput()->GetRequestedRegion().GetSize();
+  const OutputSizeType blockSize = this->GetFFTBlockSize();
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    if (blockSize[dim] < requestedSize[dim])
+    {
+      this->GenerateDataInBlocks();
+      return;
+    }
+  }
+
   // Create a process accumulator for tracking the progress of this minipipeline
   auto progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
@@ -112,6 +124,101 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
   this->ProduceOutput(multiplyFilter->GetOutput(), progress, 0.2);
 }
 
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateDataInBlocks()
+{
+  auto progress = ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+
+  this->AllocateOutputs();
+  OutputImageType *      output = this->GetOutput();
+  const OutputRegionType requestedRegion = output->GetRequestedRegion();
+  const OutputSizeType   blockSize = this->GetFFTBlockSize();
+
+  OutputSizeType numberOfBlocksPerDimension;
+  SizeValueType  numberOfBlocks = 1;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    numberOfBlocksPerDimension[dim] = (requestedRegion.GetSize()[dim] + blockSize[dim] - 1) / blockSize[dim];
+    numberOfBlocks *= numberOfBlocksPerDimension[dim];
+  }
+
+  auto localInput = InputImageType::New();
+  localInput->Graft(this->GetInput());
+  auto localKernel = KernelImageType::New();
+  localKernel->Graft(this->GetKernelImage());
+
+  // A single filter convolves all the blocks, so that the Fourier transform of
+  // the kernel is computed once for all the blocks of the same size.
+  auto blockFilter = Self::New();
+  blockFilter->SetInput(localInput);
+  blockFilter->SetKernelImage(localKernel);
+  blockFilter->SetBoundaryCondition(this->GetBoundaryCondition());
+  blockFilter->SetNormalize(this->GetNormalize());
+  blockFilter->SetOutputRegionMode(this->GetOutputRegionMode());
+  blockFilter->SetSizeGreatestPrimeFactor(m_SizeGreatestPrimeFactor);
+  blockFilter->SetCacheKernelSpectrum(true);
+  blockFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  progress->RegisterInternalFilter(blockFilter, 1.0f / numberOfBlocks);
+
+  OutputImageType * blockOutput = blockFilter->GetOutput();
+  for (SizeValueType block = 0; block < numberOfBlocks; ++block)
+  {
+    OutputIndexType blockIndex;
+    OutputSizeType  blockRegionSize;
+    SizeValueType   remainder = block;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      const SizeValueType offset = (remainder % numberOfBlocksPerDimension[dim]) * blockSize[dim];
+      remainder /= numberOfBlocksPerDimension[dim];
+      blockIndex[dim] = requestedRegion.GetIndex()[dim] + static_cast<IndexValueType>(offset);
+      blockRegionSize[dim] = std::min(blockSize[dim], requestedRegion.GetSize()[dim] - offset);
+    }
+    const OutputRegionType blockRegion(blockIndex, blockRegionSize);
+
+    blockOutput->SetRequestedRegion(blockRegion);
+    blockFilter->Update();
+    ImageAlgorithm::Copy(blockOutput, output, blockRegion, blockRegion);
+  }
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+auto
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GetFFTBlockSize() const
+  -> OutputSizeType
+{
+  const OutputSizeType requestedSize = this->GetOutput()->GetRequestedRegion().GetSize();
+  const KernelSizeType kernelRadius = this->GetKernelRadius();
+
+  OutputSizeType blockSize;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    if (m_BlockSize[dim] == 0 || m_BlockSize[dim] >= requestedSize[dim])
+    {
+      blockSize[dim] = requestedSize[dim];
+      continue;
+    }
+
+    // Enlarge the block up to the size the padded block would be given by the
+    // FFT padding, so that the padding contributes to the output.
+    SizeValueType paddedSize = m_BlockSize[dim] + 2 * kernelRadius[dim];
+    if (m_SizeGreatestPrimeFactor > 1)
+    {
+      while (Math::GreatestPrimeFactor(paddedSize) > m_SizeGreatestPrimeFactor)
+      {
+        ++paddedSize;
+      }
+    }
+    else if (m_SizeGreatestPrimeFactor == 1)
+    {
+      paddedSize += paddedSize % 2;
+    }
+    blockSize[dim] = std::min(paddedSize - 2 * kernelRadius[dim], requestedSize[dim]);
+  }
+  return blockSize;
+}
+
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::PrepareInputs(
@@ -336,6 +443,28 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
   ProgressAccumulator *             progress,
   float                             progressWeight)
 {
+  if (m_CacheKernelSpectrum && m_KernelSpectrum && m_KernelSpectrumKernelMTime == kernel->GetMTime() &&
+      m_KernelSpectrumKernelUpdateMTime == kernel->GetUpdateMTime() &&
+      m_KernelSpectrumPaddedInputSize == m_PaddedInputRegion.GetSize() &&
+      m_KernelSpectrumNormalize == this->GetNormalize())
+  {
+    if (m_KernelSpectrum->GetLargestPossibleRegion().GetIndex() == m_PaddedInputRegion.GetIndex())
+    {
+      preparedKernel = m_KernelSpectrum;
+    }
+    else
+    {
+      // The spectrum does not depend on the position of the padded input: share
+      // its buffer with the region moved to the padded input region.
+      preparedKernel = InternalComplexImageType::New();
+      preparedKernel->Graft(m_KernelSpectrum);
+      preparedKernel->SetRegions(
+        InternalRegionType(m_PaddedInputRegion.GetIndex(), m_KernelSpectrum->GetLargestPossibleRegion().GetSize()));
+    }
+    return;
+  }
+  m_KernelSpectrum = nullptr;
+
   KernelRegionType kernelRegion = kernel->GetLargestPossibleRegion();
   KernelSizeType   kernelSize = kernelRegion.GetSize();
 
@@ -429,6 +558,16 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
   kernelInfoFilter->Update();
 
   preparedKernel = kernelInfoFilter->GetOutput();
+
+  if (m_CacheKernelSpectrum)
+  {
+    preparedKernel->DisconnectPipeline();
+    m_KernelSpectrum = preparedKernel;
+    m_KernelSpectrumKernelMTime = kernel->GetMTime();
+    m_KernelSpectrumKernelUpdateMTime = kernel->GetUpdateMTime();
+    m_KernelSpectrumPaddedInputSize = m_PaddedInputRegion.GetSize();
+    m_KernelSpectrumNormalize = this->GetNormalize();
+  }
 }
 
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
@@ -525,6 +664,9 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "SizeGreatestPrimeFactor: " << m_SizeGreatestPrimeFactor << std::endl;
+  os << indent << "BlockSize: " << static_cast<typename NumericTraits<OutputSizeType>::PrintType>(m_BlockSize)
+     << std::endl;
+  os << indent << "CacheKernelSpectrum: " << (m_CacheKernelSpectrum ? "On" : "Off") << std::endl;
 }
 
 } // namespace itk
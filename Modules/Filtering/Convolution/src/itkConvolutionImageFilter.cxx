@@ -0,0 +1,42 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkConvolutionImageFilter.h"
+
+namespace itk
+{
+/** Define how to print enumerations */
+std::ostream &
+operator<<(std::ostream & out, const ConvolutionImageFilterEnums::ConvolutionAlgorithm value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case ConvolutionImageFilterEnums::ConvolutionAlgorithm::AUTOMATIC:
+        return "ConvolutionImageFilterEnums::ConvolutionAlgorithm::AUTOMATIC";
+      case ConvolutionImageFilterEnums::ConvolutionAlgorithm::DIRECT:
+        return "ConvolutionImageFilterEnums::ConvolutionAlgorithm::DIRECT";
+      case ConvolutionImageFilterEnums::ConvolutionAlgorithm::SEPARABLE:
+        return "ConvolutionImageFilterEnums::ConvolutionAlgorithm::SEPARABLE";
+      case ConvolutionImageFilterEnums::ConvolutionAlgorithm::FFT:
+        return "ConvolutionImageFilterEnums::ConvolutionAlgorithm::FFT";
+      default:
+        return "INVALID VALUE FOR ConvolutionImageFilterEnums::ConvolutionAlgorithm";
+    }
+  }();
+}
+} // namespace itk
@@ -0,0 +1,258 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkConvolutionImageFilter.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkConvolutionImageFilterTestHelpers.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Convolve images with separable, low rank and full rank kernels, with the
+ * direct, separable, FFT and automatically selected algorithms, and check that
+ * the algorithms give the same output.
+ */
+namespace
+{
+using AlgorithmEnum = itk::ConvolutionImageFilterEnums::ConvolutionAlgorithm;
+using OutputRegionModeEnum = itk::ConvolutionImageFilterBaseEnums::ConvolutionImageFilterOutputRegion;
+
+template <typename TImage>
+int
+itkConvolutionImageFilterAlgorithmTestCompare(const TImage *                        image,
+                                              const TImage *                        kernel,
+                                              itk::ImageBoundaryCondition<TImage> * boundaryCondition,
+                                              bool                                  normalize,
+                                              OutputRegionModeEnum                  outputRegionMode,
+                                              AlgorithmEnum                         algorithm,
+                                              AlgorithmEnum                         expectedSelectedAlgorithm,
+                                              double                                tolerance)
+{
+  using ConvolutionFilterType = itk::ConvolutionImageFilter<TImage>;
+
+  std::cout << "Kernel size: " << kernel->GetLargestPossibleRegion().GetSize()
+            << ", boundary condition: " << boundaryCondition->GetNameOfClass() << ", normalize: " << normalize
+            << ", output region mode: " << outputRegionMode << ", algorithm: " << algorithm << std::endl;
+
+  auto referenceFilter = ConvolutionFilterType::New();
+  referenceFilter->SetInput(image);
+  referenceFilter->SetKernelImage(kernel);
+  referenceFilter->SetBoundaryCondition(boundaryCondition);
+  referenceFilter->SetNormalize(normalize);
+  referenceFilter->SetOutputRegionMode(outputRegionMode);
+  referenceFilter->SetAlgorithm(AlgorithmEnum::DIRECT);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+
+  auto filter = ConvolutionFilterType::New();
+  filter->SetInput(image);
+  filter->SetKernelImage(kernel);
+  filter->SetBoundaryCondition(boundaryCondition);
+  filter->SetNormalize(normalize);
+  filter->SetOutputRegionMode(outputRegionMode);
+  filter->SetAlgorithm(algorithm);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(filter->GetSelectedAlgorithm(), expectedSelectedAlgorithm);
+
+  ITK_TEST_EXPECT_EQUAL(filter->GetOutput()->GetLargestPossibleRegion(),
+                        referenceFilter->GetOutput()->GetLargestPossibleRegion());
+  return itkConvolutionImageFilterTestCompareImages<TImage>(
+    filter->GetOutput(), referenceFilter->GetOutput(), tolerance);
+}
+} // namespace
+
+int
+itkConvolutionImageFilterAlgorithmTest(int, char *[])
+{
+  constexpr auto SAME = OutputRegionModeEnum::SAME;
+  constexpr auto VALID = OutputRegionModeEnum::VALID;
+
+  using ImageType = itk::Image<float, 2>;
+  using IndexType = ImageType::IndexType;
+
+  auto filter = itk::ConvolutionImageFilter<ImageType>::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, ConvolutionImageFilter, ConvolutionImageFilterBase);
+  ITK_TEST_SET_GET_VALUE(AlgorithmEnum::AUTOMATIC, filter->GetAlgorithm());
+  filter->SetAlgorithm(AlgorithmEnum::SEPARABLE);
+  ITK_TEST_SET_GET_VALUE(AlgorithmEnum::SEPARABLE, filter->GetAlgorithm());
+  ITK_TEST_SET_GET_VALUE(1e-6, filter->GetKernelDecompositionTolerance());
+  filter->SetKernelDecompositionTolerance(1e-4);
+  ITK_TEST_SET_GET_VALUE(1e-4, filter->GetKernelDecompositionTolerance());
+
+  const ImageType::Pointer image = itkConvolutionImageFilterTestCreateImage<ImageType>(
+    ImageType::SizeType{ { 64, 53 } }, [](IndexType index) {
+      return static_cast<float>(100.0 * std::sin(0.3 * index[0]) * std::cos(0.2 * index[1]) + index[0] - index[1]);
+    });
+
+  // Separable, low rank and full rank kernels
+  auto gaussian = [](double sigma, IndexType index, double center) {
+    return std::exp(-((index[0] - center) * (index[0] - center) + (index[1] - center) * (index[1] - center)) /
+                    (2.0 * sigma * sigma));
+  };
+  const ImageType::Pointer smallKernel = itkConvolutionImageFilterTestCreateImage<ImageType>(
+    ImageType::SizeType{ { 3, 3 } }, [&](IndexType index) { return static_cast<float>(gaussian(1.0, index, 1.0)); });
+  const ImageType::Pointer gaussianKernel = itkConvolutionImageFilterTestCreateImage<ImageType>(
+    ImageType::SizeType{ { 13, 13 } }, [&](IndexType index) { return static_cast<float>(gaussian(2.5, index, 6.0)); });
+  const ImageType::Pointer boxKernel = itkConvolutionImageFilterTestCreateImage<ImageType>(
+    ImageType::SizeType{ { 8, 5 } }, [](IndexType) { return 1.0f; });
+  const ImageType::Pointer differenceOfGaussiansKernel = itkConvolutionImageFilterTestCreateImage<ImageType>(
+    ImageType::SizeType{ { 9, 9 } },
+    [&](IndexType index) { return static_cast<float>(gaussian(1.5, index, 4.0) - 0.5 * gaussian(3.0, index, 4.0)); });
+  const ImageType::Pointer fullRankKernel = itkConvolutionImageFilterTestCreateImage<ImageType>(
+    ImageType::SizeType{ { 31, 31 } },
+    [](IndexType index) { return static_cast<float>(((index[0] * 7 + index[1] * 13) % 17) - 8.0); });
+
+  itk::ZeroFluxNeumannBoundaryCondition<ImageType> zeroFluxNeumannBoundaryCondition;
+  itk::ConstantBoundaryCondition<ImageType>        zeroBoundaryCondition;
+  itk::PeriodicBoundaryCondition<ImageType>        periodicBoundaryCondition;
+  itk::ConstantBoundaryCondition<ImageType>        constantBoundaryCondition;
+  constantBoundaryCondition.SetConstant(5.0f);
+
+  struct TestCase
+  {
+    const ImageType *                        kernel;
+    itk::ImageBoundaryCondition<ImageType> * boundaryCondition;
+    bool                                     normalize;
+    OutputRegionModeEnum                     outputRegionMode;
+    AlgorithmEnum                            algorithm;
+    AlgorithmEnum                            expectedSelectedAlgorithm;
+  };
+  const TestCase testCases[] = {
+    { smallKernel, &zeroFluxNeumannBoundaryCondition, false, SAME, AlgorithmEnum::AUTOMATIC, AlgorithmEnum::DIRECT },
+    { smallKernel, &zeroFluxNeumannBoundaryCondition, false, SAME, AlgorithmEnum::SEPARABLE, AlgorithmEnum::SEPARABLE },
+    { gaussianKernel, &zeroFluxNeumannBoundaryCondition, true, SAME, AlgorithmEnum::AUTOMATIC,
+      AlgorithmEnum::SEPARABLE },
+    { gaussianKernel, &zeroBoundaryCondition, false, VALID, AlgorithmEnum::SEPARABLE, AlgorithmEnum::SEPARABLE },
+    { gaussianKernel, &periodicBoundaryCondition, false, SAME, AlgorithmEnum::SEPARABLE, AlgorithmEnum::SEPARABLE },
+    { gaussianKernel, &constantBoundaryCondition, false, SAME, AlgorithmEnum::AUTOMATIC, AlgorithmEnum::FFT },
+    { gaussianKernel, &zeroFluxNeumannBoundaryCondition, false, SAME, AlgorithmEnum::FFT, AlgorithmEnum::FFT },
+    { boxKernel, &zeroFluxNeumannBoundaryCondition, true, SAME, AlgorithmEnum::SEPARABLE, AlgorithmEnum::SEPARABLE },
+    { boxKernel, &zeroBoundaryCondition, false, VALID, AlgorithmEnum::SEPARABLE, AlgorithmEnum::SEPARABLE },
+    { differenceOfGaussiansKernel, &zeroFluxNeumannBoundaryCondition, false, SAME, AlgorithmEnum::AUTOMATIC,
+      AlgorithmEnum::SEPARABLE },
+    { fullRankKernel, &zeroFluxNeumannBoundaryCondition, false, SAME, AlgorithmEnum::AUTOMATIC, AlgorithmEnum::FFT },
+    { fullRankKernel, &zeroFluxNeumannBoundaryCondition, false, VALID, AlgorithmEnum::SEPARABLE,
+      AlgorithmEnum::SEPARABLE },
+  };
+  for (const TestCase & testCase : testCases)
+  {
+    if (itkConvolutionImageFilterAlgorithmTestCompare<ImageType>(image,
+                                                                 testCase.kernel,
+                                                                 testCase.boundaryCondition,
+                                                                 testCase.normalize,
+                                                                 testCase.outputRegionMode,
+                                                                 testCase.algorithm,
+                                                                 testCase.expectedSelectedAlgorithm,
+                                                                 1e-2) != EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The separable convolution needs a boundary condition that commutes with the 1-D convolutions
+  filter->SetInput(image);
+  filter->SetKernelImage(gaussianKernel);
+  filter->SetBoundaryCondition(&constantBoundaryCondition);
+  filter->SetAlgorithm(AlgorithmEnum::SEPARABLE);
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+
+  // The separable and FFT algorithms are not selected automatically for integer outputs, so that they
+  // are exactly those of the direct convolution
+  using IntegerImageType = itk::Image<short, 2>;
+  using IntegerIndexType = IntegerImageType::IndexType;
+  const IntegerImageType::Pointer integerImage = itkConvolutionImageFilterTestCreateImage<IntegerImageType>(
+    IntegerImageType::SizeType{ { 64, 53 } },
+    [](IntegerIndexType index) { return static_cast<short>((index[0] * 3 + index[1] * 5) % 23); });
+  const IntegerImageType::Pointer squareIntegerImage = itkConvolutionImageFilterTestCreateImage<IntegerImageType>(
+    IntegerImageType::SizeType{ { 64, 64 } },
+    [](IntegerIndexType index) { return static_cast<short>((index[0] * 7 + index[1] * 11) % 31); });
+  const IntegerImageType::Pointer integerBoxKernel = itkConvolutionImageFilterTestCreateImage<IntegerImageType>(
+    IntegerImageType::SizeType{ { 5, 5 } }, [](IntegerIndexType) { return static_cast<short>(1); });
+  const IntegerImageType::Pointer integerKernel = itkConvolutionImageFilterTestCreateImage<IntegerImageType>(
+    IntegerImageType::SizeType{ { 31, 31 } },
+    [](IntegerIndexType index) { return static_cast<short>(((index[0] * 7 + index[1] * 13) % 17) - 8); });
+  itk::ZeroFluxNeumannBoundaryCondition<IntegerImageType> integerBoundaryCondition;
+  if (itkConvolutionImageFilterAlgorithmTestCompare<IntegerImageType>(integerImage,
+                                                                      integerKernel,
+                                                                      &integerBoundaryCondition,
+                                                                      false,
+                                                                      SAME,
+                                                                      AlgorithmEnum::AUTOMATIC,
+                                                                      AlgorithmEnum::DIRECT,
+                                                                      0.0) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  for (bool normalize : { false, true })
+  {
+    if (itkConvolutionImageFilterAlgorithmTestCompare<IntegerImageType>(squareIntegerImage,
+                                                                        integerBoxKernel,
+                                                                        &integerBoundaryCondition,
+                                                                        normalize,
+                                                                        SAME,
+                                                                        AlgorithmEnum::AUTOMATIC,
+                                                                        AlgorithmEnum::DIRECT,
+                                                                        0.0) != EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Kernels of three dimensions are separable when they are a single outer product
+  using VolumeType = itk::Image<float, 3>;
+  using VolumeIndexType = VolumeType::IndexType;
+  const VolumeType::Pointer volume = itkConvolutionImageFilterTestCreateImage<VolumeType>(
+    VolumeType::SizeType{ { 20, 17, 15 } }, [](VolumeIndexType index) {
+      return static_cast<float>(10.0 * std::sin(0.4 * index[0] + 0.3 * index[1]) + index[2]);
+    });
+  const VolumeType::Pointer separableVolumeKernel = itkConvolutionImageFilterTestCreateImage<VolumeType>(
+    VolumeType::SizeType{ { 7, 6, 5 } }, [](VolumeIndexType index) {
+      return static_cast<float>((1.0 + index[0]) * (3.0 - index[1]) * std::exp(-0.5 * index[2]));
+    });
+  const VolumeType::Pointer volumeKernel = itkConvolutionImageFilterTestCreateImage<VolumeType>(
+    VolumeType::SizeType{ { 3, 3, 3 } },
+    [](VolumeIndexType index) { return static_cast<float>(index[0] + index[1] * index[2]); });
+  itk::ZeroFluxNeumannBoundaryCondition<VolumeType> volumeBoundaryCondition;
+  if (itkConvolutionImageFilterAlgorithmTestCompare<VolumeType>(volume,
+                                                                separableVolumeKernel,
+                                                                &volumeBoundaryCondition,
+                                                                false,
+                                                                SAME,
+                                                                AlgorithmEnum::AUTOMATIC,
+                                                                AlgorithmEnum::SEPARABLE,
+                                                                1e-2) != EXIT_SUCCESS ||
+      itkConvolutionImageFilterAlgorithmTestCompare<VolumeType>(volume,
+                                                                volumeKernel,
+                                                                &volumeBoundaryCondition,
+                                                                false,
+                                                                SAME,
+                                                                AlgorithmEnum::AUTOMATIC,
+                                                                AlgorithmEnum::DIRECT,
+                                                                1e-2) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  auto volumeFilter = itk::ConvolutionImageFilter<VolumeType>::New();
+  volumeFilter->SetInput(volume);
+  volumeFilter->SetKernelImage(volumeKernel);
+  volumeFilter->SetAlgorithm(AlgorithmEnum::SEPARABLE);
+  ITK_TRY_EXPECT_EXCEPTION(volumeFilter->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkConvolutionImageFilterTestHelpers_h
+#define itkConvolutionImageFilterTestHelpers_h
+
+/* Images and comparisons shared by the tests that check that convolutions
+ * computed in different ways give the same output. */
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <cmath>
+#include <iostream>
+
+/* Create an image of the given size whose pixels are the values of a function
+ * of their index. */
+template <typename TImage, typename TFunction>
+typename TImage::Pointer
+itkConvolutionImageFilterTestCreateImage(const typename TImage::SizeType & size, TFunction function)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    it.Set(function(it.GetIndex()));
+  }
+  return image;
+}
+
+/* Create a 2-D float image of waves of the given frequency along a ramp. */
+inline itk::Image<float, 2>::Pointer
+itkConvolutionImageFilterTestCreateWaveImage(itk::SizeValueType width, itk::SizeValueType height, double frequency)
+{
+  using ImageType = itk::Image<float, 2>;
+  return itkConvolutionImageFilterTestCreateImage<ImageType>(
+    ImageType::SizeType{ { width, height } }, [frequency](const ImageType::IndexType & index) {
+      return static_cast<float>(std::sin(frequency * index[0]) * std::cos(0.7 * frequency * index[1]) +
+                                0.1 * index[0]);
+    });
+}
+
+/* Check that an output has the buffered region of a reference output, and
+ * that their pixels differ by no more than the tolerance. */
+template <typename TImage>
+int
+itkConvolutionImageFilterTestCompareImages(const TImage * output, const TImage * referenceOutput, double tolerance)
+{
+  if (output->GetBufferedRegion() != referenceOutput->GetBufferedRegion())
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The output region " << output->GetBufferedRegion() << " differs from the reference output region "
+              << referenceOutput->GetBufferedRegion() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  itk::ImageRegionConstIterator<TImage> it(output, output->GetBufferedRegion());
+  itk::ImageRegionConstIterator<TImage> referenceIt(referenceOutput, output->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it, ++referenceIt)
+  {
+    if (std::abs(static_cast<double>(it.Get()) - static_cast<double>(referenceIt.Get())) > tolerance)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The output pixel at " << it.GetIndex() << " is " << it.Get() << " instead of " << referenceIt.Get()
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkConvolutionImageFilterTestHelpers.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Convolve an image block by block, with several block sizes, output region
+ * modes and streaming, and check that the output is the same as the output of
+ * the convolution of the whole image.
+ */
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+using ConvolutionFilterType = itk::FFTConvolutionImageFilter<ImageType>;
+
+int
+itkFFTConvolutionImageFilterBlockTestCompare(const ImageType *                             image,
+                                             const ImageType *                             kernel,
+                                             ConvolutionFilterType::OutputRegionModeEnum   outputRegionMode,
+                                             const ConvolutionFilterType::OutputSizeType & blockSize,
+                                             unsigned int                                  numberOfStreamDivisions)
+{
+  std::cout << "Output region mode: " << outputRegionMode << ", block size: " << blockSize
+            << ", number of stream divisions: " << numberOfStreamDivisions << std::endl;
+
+  auto referenceFilter = ConvolutionFilterType::New();
+  referenceFilter->SetInput(image);
+  referenceFilter->SetKernelImage(kernel);
+  referenceFilter->SetOutputRegionMode(outputRegionMode);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+
+  auto blockFilter = ConvolutionFilterType::New();
+  blockFilter->SetInput(image);
+  blockFilter->SetKernelImage(kernel);
+  blockFilter->SetOutputRegionMode(outputRegionMode);
+  blockFilter->SetBlockSize(blockSize);
+  ITK_TEST_SET_GET_VALUE(blockSize, blockFilter->GetBlockSize());
+
+  using StreamingFilterType = itk::StreamingImageFilter<ImageType, ImageType>;
+  auto streamer = StreamingFilterType::New();
+  streamer->SetInput(blockFilter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  return itkConvolutionImageFilterTestCompareImages<ImageType>(
+    streamer->GetOutput(), referenceFilter->GetOutput(), 1e-3);
+}
+} // namespace
+
+int
+itkFFTConvolutionImageFilterBlockTest(int, char *[])
+{
+  const ImageType::Pointer image = itkConvolutionImageFilterTestCreateWaveImage(101, 77, 0.3);
+  const ImageType::Pointer kernel = itkConvolutionImageFilterTestCreateWaveImage(9, 7, 1.1);
+
+  using SizeType = ConvolutionFilterType::OutputSizeType;
+  constexpr auto SAME = ConvolutionFilterType::OutputRegionModeEnum::SAME;
+  constexpr auto VALID = ConvolutionFilterType::OutputRegionModeEnum::VALID;
+
+  if (itkFFTConvolutionImageFilterBlockTestCompare(image, kernel, SAME, SizeType{ { 0, 0 } }, 1) != EXIT_SUCCESS ||
+      itkFFTConvolutionImageFilterBlockTestCompare(image, kernel, SAME, SizeType{ { 16, 16 } }, 1) != EXIT_SUCCESS ||
+      itkFFTConvolutionImageFilterBlockTestCompare(image, kernel, SAME, SizeType{ { 20, 0 } }, 1) != EXIT_SUCCESS ||
+      itkFFTConvolutionImageFilterBlockTestCompare(image, kernel, SAME, SizeType{ { 1, 1 } }, 1) != EXIT_SUCCESS ||
+      itkFFTConvolutionImageFilterBlockTestCompare(image, kernel, VALID, SizeType{ { 16, 16 } }, 1) != EXIT_SUCCESS ||
+      itkFFTConvolutionImageFilterBlockTestCompare(image, kernel, SAME, SizeType{ { 16, 16 } }, 5) != EXIT_SUCCESS ||
+      itkFFTConvolutionImageFilterBlockTestCompare(image, kernel, VALID, SizeType{ { 32, 8 } }, 3) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
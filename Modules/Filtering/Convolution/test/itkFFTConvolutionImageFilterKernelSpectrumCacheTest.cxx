@@ -0,0 +1,189 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkConvolutionImageFilterTestHelpers.h"
+#include "itkVnlRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkVersion.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Convolve several images with a filter that keeps the Fourier transform of
+ * the kernel between updates, and check that its outputs are the same as the
+ * outputs of a filter that transforms the kernel at every update, when the
+ * input, the kernel and the normalization change. The forward Fourier
+ * transforms are counted to check that the kernel is transformed only once
+ * for several updates with the same kernel.
+ */
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+using ConvolutionFilterType = itk::FFTConvolutionImageFilter<ImageType>;
+
+unsigned int numberOfForwardFFTs = 0;
+
+// A forward FFT filter that counts its instances
+class CountingForwardFFTImageFilter
+  : public itk::VnlRealToHalfHermitianForwardFFTImageFilter<ConvolutionFilterType::InternalImageType,
+                                                            ConvolutionFilterType::InternalComplexImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CountingForwardFFTImageFilter);
+
+  using Self = CountingForwardFFTImageFilter;
+  using Superclass = itk::VnlRealToHalfHermitianForwardFFTImageFilter<ConvolutionFilterType::InternalImageType,
+                                                                      ConvolutionFilterType::InternalComplexImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkFactorylessNewMacro(Self);
+  itkTypeMacro(CountingForwardFFTImageFilter, VnlRealToHalfHermitianForwardFFTImageFilter);
+
+protected:
+  CountingForwardFFTImageFilter() { ++numberOfForwardFFTs; }
+  ~CountingForwardFFTImageFilter() override = default;
+};
+
+class CountingForwardFFTFactory : public itk::ObjectFactoryBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CountingForwardFFTFactory);
+
+  using Self = CountingForwardFFTFactory;
+  using Superclass = itk::ObjectFactoryBase;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  const char *
+  GetITKSourceVersion() const override
+  {
+    return ITK_SOURCE_VERSION;
+  }
+  const char *
+  GetDescription() const override
+  {
+    return "Counting forward FFT factory";
+  }
+
+  itkFactorylessNewMacro(Self);
+  itkTypeMacro(CountingForwardFFTFactory, itk::ObjectFactoryBase);
+
+private:
+  CountingForwardFFTFactory()
+  {
+    this->RegisterOverride(typeid(CountingForwardFFTImageFilter::Superclass::Superclass).name(),
+                           typeid(CountingForwardFFTImageFilter).name(),
+                           "Counting forward FFT",
+                           true,
+                           itk::CreateObjectFunction<CountingForwardFFTImageFilter>::New());
+  }
+};
+
+int
+itkFFTConvolutionImageFilterKernelSpectrumCacheTestCompare(ConvolutionFilterType * cachingFilter,
+                                                           const ImageType *       input,
+                                                           const ImageType *       kernel,
+                                                           bool                    normalize,
+                                                           const char *            description)
+{
+  std::cout << description << std::endl;
+
+  cachingFilter->SetInput(input);
+  cachingFilter->SetKernelImage(kernel);
+  cachingFilter->SetNormalize(normalize);
+  ITK_TRY_EXPECT_NO_EXCEPTION(cachingFilter->UpdateLargestPossibleRegion());
+
+  auto referenceFilter = ConvolutionFilterType::New();
+  referenceFilter->CacheKernelSpectrumOff();
+  referenceFilter->SetInput(input);
+  referenceFilter->SetKernelImage(kernel);
+  referenceFilter->SetNormalize(normalize);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+
+  return itkConvolutionImageFilterTestCompareImages<ImageType>(
+    cachingFilter->GetOutput(), referenceFilter->GetOutput(), 0.0);
+}
+} // namespace
+
+int
+itkFFTConvolutionImageFilterKernelSpectrumCacheTest(int, char *[])
+{
+  auto filter = ConvolutionFilterType::New();
+
+  ITK_TEST_EXPECT_TRUE(!filter->GetCacheKernelSpectrum());
+  ITK_TEST_SET_GET_BOOLEAN(filter, CacheKernelSpectrum, true);
+
+  const ImageType::Pointer firstInput = itkConvolutionImageFilterTestCreateWaveImage(40, 30, 0.3);
+  const ImageType::Pointer secondInput = itkConvolutionImageFilterTestCreateWaveImage(40, 30, 0.5);
+  const ImageType::Pointer largerInput = itkConvolutionImageFilterTestCreateWaveImage(45, 33, 0.4);
+  const ImageType::Pointer kernel = itkConvolutionImageFilterTestCreateWaveImage(7, 5, 1.1);
+
+  if (itkFFTConvolutionImageFilterKernelSpectrumCacheTestCompare(
+        filter, firstInput, kernel, false, "First convolution") != EXIT_SUCCESS ||
+      itkFFTConvolutionImageFilterKernelSpectrumCacheTestCompare(
+        filter, secondInput, kernel, false, "New input of the same size") != EXIT_SUCCESS ||
+      itkFFTConvolutionImageFilterKernelSpectrumCacheTestCompare(
+        filter, secondInput, kernel, true, "Normalized kernel") != EXIT_SUCCESS ||
+      itkFFTConvolutionImageFilterKernelSpectrumCacheTestCompare(
+        filter, largerInput, kernel, true, "Larger input") != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Modify the kernel in place
+  kernel->SetPixel({ { 3, 2 } }, 10.0f);
+  kernel->Modified();
+  if (itkFFTConvolutionImageFilterKernelSpectrumCacheTestCompare(
+        filter, largerInput, kernel, true, "Modified kernel") != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A new kernel of the same size
+  const ImageType::Pointer otherKernel = itkConvolutionImageFilterTestCreateWaveImage(7, 5, 0.2);
+  if (itkFFTConvolutionImageFilterKernelSpectrumCacheTestCompare(
+        filter, firstInput, otherKernel, false, "New kernel") != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The kernel is transformed once for the updates with the same kernel
+  auto factory = CountingForwardFFTFactory::New();
+  itk::ObjectFactoryBase::RegisterFactory(factory, itk::ObjectFactoryEnums::InsertionPosition::INSERT_AT_FRONT);
+
+  auto countingFilter = ConvolutionFilterType::New();
+  countingFilter->SetKernelImage(kernel);
+  countingFilter->CacheKernelSpectrumOn();
+  numberOfForwardFFTs = 0;
+  countingFilter->SetInput(firstInput);
+  ITK_TRY_EXPECT_NO_EXCEPTION(countingFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(numberOfForwardFFTs, 2);
+  countingFilter->SetInput(secondInput);
+  ITK_TRY_EXPECT_NO_EXCEPTION(countingFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(numberOfForwardFFTs, 3);
+
+  // Without cache, the kernel is transformed at every update
+  countingFilter->CacheKernelSpectrumOff();
+  countingFilter->SetInput(firstInput);
+  ITK_TRY_EXPECT_NO_EXCEPTION(countingFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(numberOfForwardFFTs, 5);
+  itk::ObjectFactoryBase::UnRegisterFactory(factory);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
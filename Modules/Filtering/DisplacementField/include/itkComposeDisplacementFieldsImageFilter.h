@@ -29,6 +29,14 @@ namespace itk
  *
  * \brief Compose two displacement fields.
  *
+ * When the displacement field and the warping field share the same grid
+ * (origin, spacing and direction) and the default linear interpolator is
+ * used, the composition is computed in index space: the warping vectors are
+ * mapped to index offsets with a single matrix product and the displacement
+ * field is linearly interpolated directly from its buffer, which avoids the
+ * per-voxel index to physical point conversions and the virtual interpolator
+ * calls.
+ *
  * \author Nick Tustison
  * \author Brian Avants
  *
@@ -143,10 +151,17 @@ protected:
   void
   DynamicThreadedGenerateData(const RegionType &) override;
 
+  /** Composition in index space, when both fields share the same grid and
+   * the displacement field is linearly interpolated. */
+  void
+  DynamicThreadedGenerateDataOnSharedGrid(const RegionType &);
+
 
 private:
   /** The interpolator. */
   typename InterpolatorType::Pointer m_Interpolator;
+
+  bool m_FieldsShareGrid{ false };
 };
 
 } // end namespace itk
@@ -21,6 +21,7 @@
 
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkVectorLinearInterpolateImageFunction.h"
 
 namespace itk
@@ -68,12 +69,29 @@ ComposeDisplacementFieldsImageFilter<InputImage, TOutputImage>::BeforeThreadedGe
   {
     itkExceptionMacro("Displacement field not set in interpolator.");
   }
+
+  using LinearInterpolatorType = VectorLinearInterpolateImageFunction<InputFieldType, RealType>;
+
+  const InputFieldType * displacementField = this->GetDisplacementField();
+  const InputFieldType * warpingField = this->GetWarpingField();
+
+  this->m_FieldsShareGrid = dynamic_cast<const LinearInterpolatorType *>(this->m_Interpolator.GetPointer()) &&
+                            this->m_Interpolator->GetInputImage() == displacementField &&
+                            displacementField->GetOrigin() == warpingField->GetOrigin() &&
+                            displacementField->GetSpacing() == warpingField->GetSpacing() &&
+                            displacementField->GetDirection() == warpingField->GetDirection();
 }
 
 template <typename InputImage, typename TOutputImage>
 void
 ComposeDisplacementFieldsImageFilter<InputImage, TOutputImage>::DynamicThreadedGenerateData(const RegionType & region)
 {
+  if (this->m_FieldsShareGrid)
+  {
+    this->DynamicThreadedGenerateDataOnSharedGrid(region);
+    return;
+  }
+
   typename OutputFieldType::Pointer     output = this->GetOutput();
   typename InputFieldType::ConstPointer warpingField = this->GetWarpingField();
 
@@ -114,6 +132,116 @@ ComposeDisplacementFieldsImageFilter<InputImage, TOutputImage>::DynamicThreadedG
   }
 }
 
+template <typename InputImage, typename TOutputImage>
+void
+ComposeDisplacementFieldsImageFilter<InputImage, TOutputImage>::DynamicThreadedGenerateDataOnSharedGrid(
+  const RegionType & region)
+{
+  using InputPixelType = typename InputFieldType::PixelType;
+  constexpr unsigned int numberOfNeighbors = 1u << ImageDimension;
+
+  const InputFieldType * displacementField = this->GetDisplacementField();
+  const InputFieldType * warpingField = this->GetWarpingField();
+  OutputFieldType *      output = this->GetOutput();
+
+  // Index space bounds of the displacement field buffer, as used by the linear interpolator
+  const RegionType &      bufferedRegion = displacementField->GetBufferedRegion();
+  const IndexType         startIndex = bufferedRegion.GetIndex();
+  IndexType               endIndex;
+  RealType                startContinuousIndex[ImageDimension];
+  RealType                endContinuousIndex[ImageDimension];
+  const OffsetValueType * offsetTable = displacementField->GetOffsetTable();
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    endIndex[d] = startIndex[d] + static_cast<IndexValueType>(bufferedRegion.GetSize()[d]) - 1;
+    startContinuousIndex[d] = static_cast<RealType>(startIndex[d]) - 0.5;
+    endContinuousIndex[d] = static_cast<RealType>(endIndex[d]) + 0.5;
+  }
+  const InputPixelType * buffer = displacementField->GetBufferPointer();
+
+  // Maps a physical displacement to an index displacement
+  typename InputFieldType::DirectionType physicalPointToIndex = displacementField->GetInverseDirection();
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    for (unsigned int j = 0; j < ImageDimension; ++j)
+    {
+      physicalPointToIndex[i][j] /= displacementField->GetSpacing()[i];
+    }
+  }
+
+  ImageScanlineConstIterator<InputFieldType> ItW(warpingField, region);
+  ImageScanlineIterator<OutputFieldType>     ItF(output, region);
+
+  while (!ItW.IsAtEnd())
+  {
+    IndexType index = ItW.GetIndex();
+    while (!ItW.IsAtEndOfLine())
+    {
+      const VectorType warpVector = ItW.Get();
+      VectorType       outDisplacement = warpVector;
+
+      // Continuous index of the warped point, and its linear interpolation weights
+      bool           isInside = true;
+      IndexValueType baseIndex[ImageDimension];
+      RealType       distance[ImageDimension];
+      for (unsigned int i = 0; i < ImageDimension && isInside; ++i)
+      {
+        RealType continuousIndex = static_cast<RealType>(index[i]);
+        for (unsigned int j = 0; j < ImageDimension; ++j)
+        {
+          continuousIndex += static_cast<RealType>(physicalPointToIndex[i][j]) * warpVector[j];
+        }
+        // Test for negative of a positive so we can catch NaN's
+        if (!(continuousIndex >= startContinuousIndex[i] && continuousIndex < endContinuousIndex[i]))
+        {
+          isInside = false;
+        }
+        baseIndex[i] = Math::Floor<IndexValueType>(continuousIndex);
+        distance[i] = continuousIndex - static_cast<RealType>(baseIndex[i]);
+      }
+
+      if (isInside)
+      {
+        for (unsigned int counter = 0; counter < numberOfNeighbors; ++counter)
+        {
+          RealType        overlap = 1.0;
+          OffsetValueType offset = 0;
+          for (unsigned int d = 0; d < ImageDimension; ++d)
+          {
+            IndexValueType neighborIndex;
+            if (counter & (1u << d))
+            {
+              neighborIndex = std::min(baseIndex[d] + 1, endIndex[d]);
+              overlap *= distance[d];
+            }
+            else
+            {
+              neighborIndex = std::max(baseIndex[d], startIndex[d]);
+              overlap *= 1.0 - distance[d];
+            }
+            offset += (neighborIndex - startIndex[d]) * offsetTable[d];
+          }
+          if (overlap != 0.0)
+          {
+            const InputPixelType & neighbor = buffer[offset];
+            for (unsigned int k = 0; k < ImageDimension; ++k)
+            {
+              outDisplacement[k] += overlap * neighbor[k];
+            }
+          }
+        }
+      }
+
+      ItF.Set(outDisplacement);
+      ++ItW;
+      ++ItF;
+      ++index[0];
+    }
+    ItW.NextLine();
+    ItF.NextLine();
+  }
+}
+
 template <typename InputImage, typename TOutputImage>
 void
 ComposeDisplacementFieldsImageFilter<InputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
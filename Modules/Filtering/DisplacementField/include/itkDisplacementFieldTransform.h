@@ -214,6 +214,17 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & inputPoint) const override;
 
+  /** Method to transform the equally spaced points firstPoint + k * step.
+   * When the points are the grid points of a line of the displacement field,
+   * and the interpolator returns the pixel values at the grid points (linear
+   * or nearest neighbor interpolation), the displacements are read directly
+   * from the field buffer. */
+  void
+  TransformPointsAlongLine(const InputPointType &  firstPoint,
+                           const InputVectorType & step,
+                           SizeValueType           numberOfPoints,
+                           OutputPointType *       outputPoints) const override;
+
   /**  Method to transform a vector. */
   using Superclass::TransformVector;
   OutputVectorType
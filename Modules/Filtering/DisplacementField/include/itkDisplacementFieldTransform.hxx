@@ -19,6 +19,7 @@
 #define itkDisplacementFieldTransform_hxx
 
 #include "itkVectorLinearInterpolateImageFunction.h"
+#include "itkVectorNearestNeighborInterpolateImageFunction.h"
 #include "itkImageToImageFilter.h"
 
 #include "itkImageRegionIteratorWithIndex.h"
@@ -100,6 +101,87 @@ DisplacementFieldTransform<TParametersValueType, VDimension>::TransformPoint(con
   return outputPoint;
 }
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+DisplacementFieldTransform<TParametersValueType, VDimension>::TransformPointsAlongLine(
+  const InputPointType &  firstPoint,
+  const InputVectorType & step,
+  SizeValueType           numberOfPoints,
+  OutputPointType *       outputPoints) const
+{
+  if (!this->m_DisplacementField)
+  {
+    itkExceptionMacro("No displacement field is specified.");
+  }
+  if (!this->m_Interpolator)
+  {
+    itkExceptionMacro("No interpolator is specified.");
+  }
+
+  using LinearInterpolatorType = VectorLinearInterpolateImageFunction<DisplacementFieldType, ScalarType>;
+  using NearestNeighborInterpolatorType =
+    VectorNearestNeighborInterpolateImageFunction<DisplacementFieldType, ScalarType>;
+  const bool interpolatesGridPoints =
+    (dynamic_cast<const LinearInterpolatorType *>(this->m_Interpolator.GetPointer()) != nullptr ||
+     dynamic_cast<const NearestNeighborInterpolatorType *>(this->m_Interpolator.GetPointer()) != nullptr) &&
+    this->m_Interpolator->GetInputImage() == this->m_DisplacementField.GetPointer();
+
+  // The points are the grid points of a line of the displacement field when the first
+  // point maps to an index and the step maps to the next index along the first axis.
+  constexpr double tolerance = 1.0e-6;
+  const RegionType bufferedRegion = this->m_DisplacementField->GetBufferedRegion();
+  const auto       firstIndex =
+    this->m_DisplacementField->template TransformPhysicalPointToContinuousIndex<double>(firstPoint);
+  const auto &     inverseDirection = this->m_DisplacementField->GetInverseDirection();
+  IndexType        lineIndex;
+  bool             onGrid = interpolatesGridPoints;
+  bool             lineInside = true;
+  for (unsigned int i = 0; i < VDimension && onGrid; ++i)
+  {
+    double indexStep = 0.0;
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      indexStep += inverseDirection[i][j] * step[j];
+    }
+    indexStep /= this->m_DisplacementField->GetSpacing()[i];
+    lineIndex[i] = Math::RoundHalfIntegerUp<IndexValueType>(firstIndex[i]);
+    onGrid = Math::abs(firstIndex[i] - lineIndex[i]) <= tolerance &&
+             Math::abs(indexStep - (i == 0 ? 1.0 : 0.0)) <= tolerance;
+    if (i > 0)
+    {
+      lineInside = lineInside && lineIndex[i] >= bufferedRegion.GetIndex(i) &&
+                   lineIndex[i] < bufferedRegion.GetIndex(i) + static_cast<IndexValueType>(bufferedRegion.GetSize(i));
+    }
+  }
+  if (!onGrid)
+  {
+    Superclass::TransformPointsAlongLine(firstPoint, step, numberOfPoints, outputPoints);
+    return;
+  }
+
+  // Points outside of the buffer are returned with zero displacement
+  const IndexValueType     firstIndexOfLine = lineIndex[0];
+  const IndexValueType     bufferStart = bufferedRegion.GetIndex(0);
+  const IndexValueType     bufferEnd = bufferStart + static_cast<IndexValueType>(bufferedRegion.GetSize(0));
+  const OutputVectorType * lineBuffer = nullptr;
+  if (lineInside)
+  {
+    lineIndex[0] = bufferStart;
+    lineBuffer = this->m_DisplacementField->GetBufferPointer() + this->m_DisplacementField->ComputeOffset(lineIndex);
+  }
+  for (SizeValueType k = 0; k < numberOfPoints; ++k)
+  {
+    OutputPointType & outputPoint = outputPoints[k];
+    outputPoint = firstPoint + step * static_cast<ScalarType>(k);
+
+    const IndexValueType index = firstIndexOfLine + static_cast<IndexValueType>(k);
+    if (lineBuffer != nullptr && index >= bufferStart && index < bufferEnd)
+    {
+      outputPoint += lineBuffer[index - bufferStart];
+    }
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension>
 bool
 DisplacementFieldTransform<TParametersValueType, VDimension>::GetInverse(Self * inverse) const
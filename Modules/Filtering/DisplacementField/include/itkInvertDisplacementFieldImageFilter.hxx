@@ -109,20 +109,24 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   float oldProgress = 0.0f;
 
+  // The inverse field shares the grid of the displacement field, so the composer takes
+  // its index space path. It is reused across iterations to also reuse its output buffer.
+  using ComposerType = ComposeDisplacementFieldsImageFilter<DisplacementFieldType>;
+  auto composer = ComposerType::New();
+  composer->SetDisplacementField(displacementField);
+  composer->SetWarpingField(inverseDisplacementField);
+  composer->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->m_ComposedField = composer->GetOutput();
+
   while (iteration++ < this->m_MaximumNumberOfIterations && this->m_MaxErrorNorm > this->m_MaxErrorToleranceThreshold &&
          this->m_MeanErrorNorm > this->m_MeanErrorToleranceThreshold)
   {
     itkDebugMacro("Iteration " << iteration << ": mean error norm = " << this->m_MeanErrorNorm
                                << ", max error norm = " << this->m_MaxErrorNorm);
 
-    using ComposerType = ComposeDisplacementFieldsImageFilter<DisplacementFieldType>;
-    auto composer = ComposerType::New();
-    composer->SetDisplacementField(displacementField);
-    composer->SetWarpingField(inverseDisplacementField);
-
-    this->m_ComposedField = composer->GetOutput();
-    this->m_ComposedField->Update();
-    this->m_ComposedField->DisconnectPipeline();
+    // The inverse field was updated in place during the previous iteration
+    composer->Modified();
+    composer->Update();
 
     // Multithread processing to multiply each element of the composed field by 1 / spacing
     this->m_MeanErrorNorm = NumericTraits<RealType>::ZeroValue();
@@ -161,6 +165,8 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::GenerateData()
     oldProgress = newProgress;
   }
 
+  this->m_ComposedField->DisconnectPipeline();
+
   this->UpdateProgress(1.0f);
 }
 
@@ -18,6 +18,9 @@
 
 #include "itkComposeDisplacementFieldsImageFilter.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkVectorLinearInterpolateImageFunction.h"
+#include "itkTestingMacros.h"
 
 int
 itkComposeDisplacementFieldsImageFilterTest(int, char *[])
@@ -81,5 +84,83 @@ itkComposeDisplacementFieldsImageFilterTest(int, char *[])
 
   composer->Print(std::cout, 3);
 
+  // Fields sharing their grid are composed in index space. Compare with the
+  // composition computed through physical space, for a rotated grid and a
+  // displacement field pointing partly outside of the grid.
+  auto rotatedDirection = direction;
+  rotatedDirection[0][0] = 0.6;
+  rotatedDirection[0][1] = -0.8;
+  rotatedDirection[1][0] = 0.8;
+  rotatedDirection[1][1] = 0.6;
+  origin[0] = -3.0;
+  origin[1] = 7.0;
+  size[0] = 40;
+  size[1] = 30;
+
+  auto displacementField = DisplacementFieldType::New();
+  auto warpingField = DisplacementFieldType::New();
+  for (auto & image : { displacementField, warpingField })
+  {
+    image->SetOrigin(origin);
+    image->SetSpacing(spacing);
+    image->SetRegions(size);
+    image->SetDirection(rotatedDirection);
+    image->Allocate();
+  }
+  for (itk::ImageRegionIteratorWithIndex<DisplacementFieldType> it(displacementField,
+                                                                  displacementField->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const auto & idx = it.GetIndex();
+    VectorType   displacement;
+    displacement[0] = 2.0 * std::sin(0.3 * idx[0]) + 0.1 * idx[1];
+    displacement[1] = 1.5 * std::cos(0.2 * idx[1]) - 0.05 * idx[0];
+    it.Set(displacement);
+    VectorType warping;
+    warping[0] = 3.0 * std::cos(0.17 * idx[0] + 0.11 * idx[1]);
+    warping[1] = -2.5 * std::sin(0.13 * idx[1]) - 0.04 * idx[0];
+    warpingField->SetPixel(idx, warping);
+  }
+
+  auto sharedGridComposer = ComposerType::New();
+  sharedGridComposer->SetDisplacementField(displacementField);
+  sharedGridComposer->SetWarpingField(warpingField);
+  ITK_TRY_EXPECT_NO_EXCEPTION(sharedGridComposer->Update());
+
+  using InterpolatorType = itk::VectorLinearInterpolateImageFunction<DisplacementFieldType, double>;
+  auto interpolator = InterpolatorType::New();
+  interpolator->SetInputImage(displacementField);
+
+  double maxError = 0.0;
+  for (itk::ImageRegionIteratorWithIndex<DisplacementFieldType> it(warpingField, warpingField->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    DisplacementFieldType::PointType point;
+    warpingField->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+    const VectorType warping = it.Get();
+    point += warping;
+
+    VectorType expected = warping;
+    if (interpolator->IsInsideBuffer(point))
+    {
+      const InterpolatorType::OutputType displacement = interpolator->Evaluate(point);
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        expected[d] += displacement[d];
+      }
+    }
+    const VectorType composed = sharedGridComposer->GetOutput()->GetPixel(it.GetIndex());
+    maxError = std::max(maxError, static_cast<double>((composed - expected).GetNorm()));
+  }
+  std::cout << "Maximum difference with the physical space composition: " << maxError << std::endl;
+  if (maxError > 1e-4)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The index space composition differs from the physical space composition by " << maxError << std::endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
@@ -601,6 +601,44 @@ itkDisplacementFieldTransformTest(int argc, char * argv[])
   }
 
 
+  // Test transforming the points of a line, on the grid of the field and off the grid.
+  // The line starts and ends outside of the field.
+  {
+    const FieldType::SizeType fieldSize = field->GetLargestPossibleRegion().GetSize();
+    FieldType::IndexType      lineStartIndex;
+    lineStartIndex[0] = -2;
+    lineStartIndex[1] = 3;
+    FieldType::IndexType lineNextIndex = lineStartIndex;
+    ++lineNextIndex[0];
+
+    DisplacementTransformType::InputPointType lineStart;
+    DisplacementTransformType::InputPointType lineNext;
+    field->TransformIndexToPhysicalPoint(lineStartIndex, lineStart);
+    field->TransformIndexToPhysicalPoint(lineNextIndex, lineNext);
+    const DisplacementTransformType::InputVectorType onGridStep = lineNext - lineStart;
+    const DisplacementTransformType::InputVectorType offGridStep = onGridStep * 0.7;
+
+    const itk::SizeValueType                                numberOfPoints = fieldSize[0] + 4;
+    std::vector<DisplacementTransformType::OutputPointType> linePoints(numberOfPoints);
+    for (const auto & step : { onGridStep, offGridStep })
+    {
+      displacementTransform->TransformPointsAlongLine(lineStart, step, numberOfPoints, linePoints.data());
+      for (itk::SizeValueType k = 0; k < numberOfPoints; ++k)
+      {
+        const DisplacementTransformType::OutputPointType expected =
+          displacementTransform->TransformPoint(lineStart + step * static_cast<double>(k));
+        if (linePoints[k].EuclideanDistanceTo(expected) > 1e-8)
+        {
+          std::cout << "Test failed!" << std::endl;
+          std::cout << "TransformPointsAlongLine: point " << k << " is " << linePoints[k] << ", expected " << expected
+                    << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+
   // Exercise other methods to improve coverage
   //
 
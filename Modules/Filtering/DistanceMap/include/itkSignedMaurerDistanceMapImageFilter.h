@@ -37,7 +37,9 @@ namespace itk
  *  output image is of type "int".  Obviously, if the user wishes to utilize
  *  the image spacing or to have a filter with the Euclidean distance (as
  *  opposed to the squared distance), output image types of float or double
- *  should be used.
+ *  should be used. The distances are computed with the output pixel type, so
+ *  an output image of float uses half of the memory of an output image of
+ *  double.
  *
  *  The inside is considered as having negative distances. Outside is
  *  treated as having positive distances. To change the convention, use the
@@ -184,9 +186,21 @@ protected:
   }
 
 private:
+  /** Mark the object pixels which have a background pixel among their neighbors with zero and the other pixels with
+   * the largest output value, in a single pass over the input. */
   void
-       Voronoi(unsigned int, OutputIndexType idx, OutputImageType * output);
-  bool Remove(OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType);
+  ExtractBoundary(const OutputImageRegionType & outputRegion);
+
+  /** Compute the squared distances along a contiguous line of length pixels, in place. */
+  void
+  Voronoi(OutputPixelType *       line,
+          OutputSizeValueType     length,
+          const OutputPixelType * positions,
+          OutputPixelType *       g,
+          OutputPixelType *       h);
+
+  bool
+  Remove(OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType);
 
   InputPixelType   m_BackgroundValue;
   InputSpacingType m_Spacing;
@@ -18,15 +18,13 @@
 #ifndef itkSignedMaurerDistanceMapImageFilter_hxx
 #define itkSignedMaurerDistanceMapImageFilter_hxx
 
-#include "itkImageRegionIteratorWithIndex.h"
-#include "itkImageRegionIterator.h"
-#include "itkBinaryThresholdImageFilter.h"
-#include "itkBinaryContourImageFilter.h"
+#include "itkImageScanlineIterator.h"
+#include "itkIndexRange.h"
 #include "itkProgressReporter.h"
-#include "itkProgressAccumulator.h"
-#include "itkMath.h"
-#include "vnl/vnl_vector.h"
+#include "itkProgressTransformer.h"
 #include "itkMath.h"
+#include <algorithm>
+#include <vector>
 
 namespace itk
 {
@@ -103,56 +101,33 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::GenerateData()
 {
   ThreadIdType numberOfWorkUnits = this->GetNumberOfWorkUnits();
 
-  OutputImageType *      outputPtr = this->GetOutput();
-  const InputImageType * inputPtr = this->GetInput();
+  OutputImageType * outputPtr = this->GetOutput();
   m_InputCache = this->GetInput();
 
   // prepare the data
   this->AllocateOutputs();
   this->m_Spacing = outputPtr->GetSpacing();
 
-  // store the binary image in an image with a pixel type as small as possible
-  // instead of keeping the native input pixel type to avoid using too much
-  // memory.
-  using BinaryFilterType = BinaryThresholdImageFilter<InputImageType, OutputImageType>;
-
-  auto progressAcc = ProgressAccumulator::New();
-  progressAcc->SetMiniPipelineFilter(this);
-
-  // compute the boundary of the binary object.
-  // To do that, we erode the binary object. The eroded pixels are the ones
-  // on the boundary. We mark them with the value 2
-  auto binaryFilter = BinaryFilterType::New();
-
-  binaryFilter->SetLowerThreshold(this->m_BackgroundValue);
-  binaryFilter->SetUpperThreshold(this->m_BackgroundValue);
-  binaryFilter->SetInsideValue(NumericTraits<OutputPixelType>::max());
-  binaryFilter->SetOutsideValue(NumericTraits<OutputPixelType>::ZeroValue());
-  binaryFilter->SetInput(inputPtr);
-  binaryFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
-  progressAcc->RegisterInternalFilter(binaryFilter, 0.1f);
-  binaryFilter->GraftOutput(outputPtr);
-  binaryFilter->Update();
-
-  // Dilate the inverted image by 1 pixel to give it the same boundary
-  // as the univerted inputPtr.
-  using BorderFilterType = BinaryContourImageFilter<OutputImageType, OutputImageType>;
-  auto borderFilter = BorderFilterType::New();
-  borderFilter->SetInput(binaryFilter->GetOutput());
-  borderFilter->SetForegroundValue(NumericTraits<OutputPixelType>::ZeroValue());
-  borderFilter->SetBackgroundValue(NumericTraits<OutputPixelType>::max());
-  borderFilter->SetFullyConnected(true);
-  borderFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
-  progressAcc->RegisterInternalFilter(borderFilter, 0.23f);
-  borderFilter->Update();
-
-  this->GraftOutput(borderFilter->GetOutput());
+  this->GetMultiThreader()->SetNumberOfWorkUnits(numberOfWorkUnits);
+
+  // compute the boundary of the binary object directly in the output, without
+  // the intermediate images of a threshold and a contour filter.
+  // The region is not split along the X axis, so that each line can be
+  // compared with its neighbor lines in a single sweep.
+  {
+    ProgressTransformer progress(0.0f, 0.33f, this);
+    constexpr unsigned int restrictedDirection = 0;
+    this->GetMultiThreader()->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+      restrictedDirection,
+      outputPtr->GetRequestedRegion(),
+      [this](const OutputImageRegionType & outputRegionForThread) { this->ExtractBoundary(outputRegionForThread); },
+      progress.GetProcessObject());
+  }
 
   // Set up the multithreaded processing
   typename ImageSource<OutputImageType>::ThreadStruct str;
   str.Filter = this;
 
-  this->GetMultiThreader()->SetNumberOfWorkUnits(numberOfWorkUnits);
   this->GetMultiThreader()->SetSingleMethod(this->ThreaderCallback, &str);
 
   // multithread the execution
@@ -165,102 +140,174 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::GenerateData()
 
 template <typename TInputImage, typename TOutputImage>
 void
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
-  const OutputImageRegionType & outputRegionForThread,
-  ThreadIdType                  threadId)
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::ExtractBoundary(
+  const OutputImageRegionType & outputRegion)
 {
-  OutputImageType * outputImage = this->GetOutput();
-
-  InputRegionType region = outputRegionForThread;
-  InputSizeType   size = region.GetSize();
-  InputIndexType  startIndex = outputRegionForThread.GetIndex();
-
-  OutputImageType * outputPtr = this->GetOutput();
+  OutputImageType *             outputPtr = this->GetOutput();
+  const OutputImageRegionType & requestedRegion = outputPtr->GetRequestedRegion();
+  const OutputSizeValueType     lineLength = outputRegion.GetSize(0);
+
+  // The offsets of the lines in the 3^(N-1) neighborhood of a line, including
+  // the line itself. The neighbors are face, edge and vertex connected.
+  unsigned int numberOfNeighborLines = 1;
+  for (unsigned int d = 1; d < ImageDimension; ++d)
+  {
+    numberOfNeighborLines *= 3;
+  }
+  std::vector<typename OutputImageType::OffsetType> neighborLineOffsets(numberOfNeighborLines);
+  for (unsigned int n = 0; n < numberOfNeighborLines; ++n)
+  {
+    unsigned int code = n;
+    neighborLineOffsets[n][0] = 0;
+    for (unsigned int d = 1; d < ImageDimension; ++d)
+    {
+      neighborLineOffsets[n][d] = static_cast<OffsetValueType>(code % 3) - 1;
+      code /= 3;
+    }
+  }
 
-  // compute the number of rows first, so we can setup a progress reporter
-  std::vector<InputSizeValueType> NumberOfRows;
-  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  // backgroundNearby[x + 1] is set when one of the neighbor lines has a
+  // background pixel at x, so that a pixel has a background neighbor when one
+  // of backgroundNearby[x], backgroundNearby[x + 1] and backgroundNearby[x + 2]
+  // is set.
+  std::vector<unsigned char> backgroundNearby(lineLength + 2);
+  const InputSizeType        lineSize = [lineLength] {
+    InputSizeType size;
+    size.Fill(1);
+    size[0] = lineLength;
+    return size;
+  }();
+
+  OutputImageRegionType lineStartRegion = outputRegion;
+  lineStartRegion.SetSize(0, 1);
+  for (const OutputIndexType & lineIndex : ImageRegionIndexRange<ImageDimension>(lineStartRegion))
   {
-    NumberOfRows.push_back(1);
-    for (unsigned int d = 0; d < InputImageDimension; ++d)
+    std::fill(backgroundNearby.begin(), backgroundNearby.end(), 0);
+    for (const auto & neighborLineOffset : neighborLineOffsets)
     {
-      if (d != i)
+      const OutputIndexType neighborLineIndex = lineIndex + neighborLineOffset;
+      if (!requestedRegion.IsInside(neighborLineIndex))
       {
-        NumberOfRows[i] *= size[d];
+        continue;
       }
+      ImageScanlineConstIterator<InputImageType> inputIt(m_InputCache, InputRegionType(neighborLineIndex, lineSize));
+      for (OutputSizeValueType x = 1; !inputIt.IsAtEndOfLine(); ++inputIt, ++x)
+      {
+        backgroundNearby[x] |= static_cast<unsigned char>(Math::ExactlyEquals(inputIt.Get(), m_BackgroundValue));
+      }
+    }
+
+    ImageScanlineConstIterator<InputImageType> inputIt(m_InputCache, InputRegionType(lineIndex, lineSize));
+    OutputPixelType * outputLine = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(lineIndex);
+    for (OutputSizeValueType x = 0; x < lineLength; ++x, ++inputIt)
+    {
+      const bool isOnBoundary = Math::NotExactlyEquals(inputIt.Get(), m_BackgroundValue) &&
+                                (backgroundNearby[x] | backgroundNearby[x + 1] | backgroundNearby[x + 2]);
+      outputLine[x] =
+        isOnBoundary ? NumericTraits<OutputPixelType>::ZeroValue() : NumericTraits<OutputPixelType>::max();
     }
   }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread,
+  ThreadIdType                  threadId)
+{
+  OutputImageType * outputPtr = this->GetOutput();
+
+  const unsigned int        d = m_CurrentDimension;
+  const OutputSizeValueType nd = outputRegionForThread.GetSize(d);
+  const OffsetValueType     lineStride = outputPtr->GetOffsetTable()[d];
+
+  // The lines along the current dimension are processed in batches of lines
+  // which are neighbors along the fastest axis other than the current one.
+  // A batch is gathered in a contiguous buffer, so that the strided lines are
+  // read and written a whole cache line at a time instead of a pixel at a time.
+  const unsigned int batchAxis = (d == 0 && ImageDimension > 1) ? 1 : 0;
+  OutputImageRegionType batchRegion = outputRegionForThread;
+  batchRegion.SetSize(d, 1);
+  const OutputSizeValueType numberOfLines = batchRegion.GetNumberOfPixels();
+  OutputSizeValueType       linesAlongBatchAxis = 1;
+  OffsetValueType           batchStride = 0;
+  SizeValueType             linesPerBatch = 1;
+  if (batchAxis != d)
+  {
+    linesAlongBatchAxis = batchRegion.GetSize(batchAxis);
+    batchStride = outputPtr->GetOffsetTable()[batchAxis];
+    linesPerBatch = 16;
+    batchRegion.SetSize(batchAxis, (linesAlongBatchAxis + linesPerBatch - 1) / linesPerBatch);
+  }
 
   // set the progress reporter. Use a pointer to be able to destroy it before
   // the creation of progress2
   // so it won't set wrong progress at the end of ThreadedGenerateData()
-  float progressPerDimension = 0.67f / static_cast<float>(ImageDimension);
-  if (!this->m_SquaredDistance)
-  {
-    progressPerDimension = 0.67f / (static_cast<float>(ImageDimension) + 1);
-  }
-  auto progress =
-    std::make_unique<ProgressReporter>(this,
-                                       threadId,
-                                       NumberOfRows[m_CurrentDimension],
-                                       30,
-                                       0.33f + static_cast<float>(m_CurrentDimension * progressPerDimension),
-                                       progressPerDimension);
-
-  // This variable provides the amount by which to divide the dimensionless index in order to get the index for each
-  // dimension.
-  vnl_vector<unsigned int> k(InputImageDimension - 1);
-  unsigned int             count = 0;
-  k[count] = 1;
-  for (unsigned int d = m_CurrentDimension + InputImageDimension - 1; d > m_CurrentDimension + 1; d--)
+  const float progressPerDimension = 0.67f / (static_cast<float>(ImageDimension) + 1);
+  auto        progress = std::make_unique<ProgressReporter>(this,
+                                                     threadId,
+                                                     numberOfLines,
+                                                     30,
+                                                     0.33f + static_cast<float>(d * progressPerDimension),
+                                                     progressPerDimension);
+
+  // The positions of the pixels along the lines
+  std::vector<OutputPixelType> positions(nd);
+  for (OutputSizeValueType i = 0; i < nd; ++i)
   {
-    k[count + 1] = k[count] * size[d % InputImageDimension];
-    ++count;
+    positions[i] = this->GetUseImageSpacing() ? static_cast<OutputPixelType>(i * this->m_Spacing[d])
+                                              : static_cast<OutputPixelType>(i);
   }
-  k.flip();
-
-  // The index is defined as the dimensionless index into the pixel.
-  // It must be divided by each dimension size in order to get the index for that dimension.
-  // The result of this division is the offsetIndex, which is the index offset relative to the region of this thread.
-  // The true pixel location (idx) is provided by the sum of the offsetIndex and the startIndex.
-  InputSizeValueType index;
-  OutputIndexType    offsetIndex;
-  offsetIndex.Fill(0);
-  InputSizeValueType tempRow = NumberOfRows[m_CurrentDimension];
-  OutputIndexType    idx;
-  idx.Fill(0);
-
-  for (InputSizeValueType n = 0; n < tempRow; ++n)
+
+  std::vector<OutputPixelType> lines(linesPerBatch * nd);
+  std::vector<OutputPixelType> g(nd);
+  std::vector<OutputPixelType> h(nd);
+
+  const OutputIndexType & startIndex = outputRegionForThread.GetIndex();
+  for (OutputIndexType lineIndex : ImageRegionIndexRange<ImageDimension>(batchRegion))
   {
-    index = n;
-    count = 0;
-    for (unsigned int d = m_CurrentDimension + 1; d < m_CurrentDimension + InputImageDimension; ++d)
+    SizeValueType numberOfLinesInBatch = 1;
+    if (batchAxis != d)
+    {
+      const SizeValueType firstLine = (lineIndex[batchAxis] - startIndex[batchAxis]) * linesPerBatch;
+      lineIndex[batchAxis] = startIndex[batchAxis] + static_cast<OutputIndexValueType>(firstLine);
+      numberOfLinesInBatch = std::min(linesPerBatch, linesAlongBatchAxis - firstLine);
+    }
+    OutputPixelType * const batchStart = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(lineIndex);
+
+    for (OutputSizeValueType i = 0; i < nd; ++i)
+    {
+      const OutputPixelType * pixel = batchStart + static_cast<OffsetValueType>(i) * lineStride;
+      for (SizeValueType b = 0; b < numberOfLinesInBatch; ++b, pixel += batchStride)
+      {
+        lines[b * nd + i] = *pixel;
+      }
+    }
+
+    for (SizeValueType b = 0; b < numberOfLinesInBatch; ++b)
     {
-      offsetIndex[d % InputImageDimension] =
-        static_cast<OutputIndexValueType>(static_cast<double>(index) / static_cast<double>(k[count]));
-      idx[d % InputImageDimension] =
-        offsetIndex[d % InputImageDimension] + static_cast<OutputIndexValueType>(startIndex[d % InputImageDimension]);
+      this->Voronoi(lines.data() + b * nd, nd, positions.data(), g.data(), h.data());
+      progress->CompletedPixel();
+    }
 
-      index %= k[count];
-      ++count;
+    for (OutputSizeValueType i = 0; i < nd; ++i)
+    {
+      OutputPixelType * pixel = batchStart + static_cast<OffsetValueType>(i) * lineStride;
+      for (SizeValueType b = 0; b < numberOfLinesInBatch; ++b, pixel += batchStride)
+      {
+        *pixel = lines[b * nd + i];
+      }
     }
-    this->Voronoi(m_CurrentDimension, idx, outputImage);
-    progress->CompletedPixel();
   }
   progress.reset();
 
-  if (m_CurrentDimension == ImageDimension - 1 && !this->m_SquaredDistance)
+  // The squared distances are unsigned until all the dimensions are processed.
+  // The sign, and the square root, are then applied in a single pass over the
+  // region of this thread, which holds whole lines along the last dimension.
+  if (d == ImageDimension - 1)
   {
-    using OutputIterator = ImageRegionIterator<OutputImageType>;
-    using InputIterator = ImageRegionConstIterator<InputImageType>;
-
-    typename OutputImageType::RegionType outputRegion = outputRegionForThread;
-
-    OutputIterator Ot(outputPtr, outputRegion);
-    InputIterator  It(m_InputCache, outputRegion);
-
-    Ot.GoToBegin();
-    It.GoToBegin();
+    ImageScanlineIterator<OutputImageType>     Ot(outputPtr, outputRegionForThread);
+    ImageScanlineConstIterator<InputImageType> It(m_InputCache, outputRegionForThread);
 
     ProgressReporter progress2(this,
                                threadId,
@@ -273,95 +320,55 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::ThreadedGenerateD
 
     while (!Ot.IsAtEnd())
     {
-      // cast to a real type is required on some platforms
-      const auto outputValue =
-        static_cast<OutputPixelType>(std::sqrt(static_cast<OutputRealType>(itk::Math::abs(Ot.Get()))));
-
-      if (Math::NotExactlyEquals(It.Get(), this->m_BackgroundValue))
+      while (!Ot.IsAtEndOfLine())
       {
-        if (this->GetInsideIsPositive())
+        OutputPixelType outputValue = Ot.Get();
+        // the pixels of the lines without any boundary pixel keep the largest
+        // value, without sign, in the squared distance map
+        if (!this->m_SquaredDistance || Math::NotExactlyEquals(outputValue, NumericTraits<OutputPixelType>::max()))
         {
-          Ot.Set(outputValue);
-        }
-        else
-        {
-          Ot.Set(-outputValue);
+          if (!this->m_SquaredDistance)
+          {
+            // cast to a real type is required on some platforms
+            outputValue = static_cast<OutputPixelType>(std::sqrt(static_cast<OutputRealType>(outputValue)));
+          }
+          const bool isInside = Math::NotExactlyEquals(It.Get(), this->m_BackgroundValue);
+          Ot.Set(isInside == this->m_InsideIsPositive ? outputValue : -outputValue);
         }
+        ++Ot;
+        ++It;
+        progress2.CompletedPixel();
       }
-      else
-      {
-        if (this->GetInsideIsPositive())
-        {
-          Ot.Set(-outputValue);
-        }
-        else
-        {
-          Ot.Set(outputValue);
-        }
-      }
-
-      ++Ot;
-      ++It;
-      progress2.CompletedPixel();
+      Ot.NextLine();
+      It.NextLine();
     }
   }
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned int      d,
-                                                                       OutputIndexType   idx,
-                                                                       OutputImageType * output)
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(OutputPixelType *       line,
+                                                                       OutputSizeValueType     length,
+                                                                       const OutputPixelType * positions,
+                                                                       OutputPixelType *       g,
+                                                                       OutputPixelType *       h)
 {
-  OutputRegionType    oRegion = output->GetRequestedRegion();
-  OutputSizeValueType nd = oRegion.GetSize()[d];
-
-  vnl_vector<OutputPixelType> g(nd, 0);
-  vnl_vector<OutputPixelType> h(nd, 0);
-
-
-  InputRegionType iRegion = m_InputCache->GetRequestedRegion();
-  InputIndexType  startIndex = iRegion.GetIndex();
-
-  OutputPixelType di;
+  OffsetValueType l = -1;
 
-  int l = -1;
-
-  for (unsigned int i = 0; i < nd; ++i)
+  for (OutputSizeValueType i = 0; i < length; ++i)
   {
-    idx[d] = i + startIndex[d];
-
-    di = output->GetPixel(idx);
-
-    OutputPixelType iw;
-
-    if (this->GetUseImageSpacing())
-    {
-      iw = static_cast<OutputPixelType>(i) * static_cast<OutputPixelType>(this->m_Spacing[d]);
-    }
-    else
-    {
-      iw = static_cast<OutputPixelType>(i);
-    }
+    const OutputPixelType di = line[i];
 
     if (Math::NotExactlyEquals(di, NumericTraits<OutputPixelType>::max()))
     {
-      if (l < 1)
+      const OutputPixelType iw = positions[i];
+      while ((l >= 1) && this->Remove(g[l - 1], g[l], di, h[l - 1], h[l], iw))
       {
-        ++l;
-        g(l) = di;
-        h(l) = iw;
-      }
-      else
-      {
-        while ((l >= 1) && this->Remove(g(l - 1), g(l), di, h(l - 1), h(l), iw))
-        {
-          --l;
-        }
-        ++l;
-        g(l) = di;
-        h(l) = iw;
+        --l;
       }
+      ++l;
+      g[l] = di;
+      h[l] = iw;
     }
   }
 
@@ -370,29 +377,20 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned
     return;
   }
 
-  int ns = l;
+  const OffsetValueType ns = l;
 
   l = 0;
 
-  for (unsigned int i = 0; i < nd; ++i)
+  for (OutputSizeValueType i = 0; i < length; ++i)
   {
-    OutputPixelType iw;
+    const OutputPixelType iw = positions[i];
 
-    if (this->GetUseImageSpacing())
-    {
-      iw = static_cast<OutputPixelType>(i * this->m_Spacing[d]);
-    }
-    else
-    {
-      iw = static_cast<OutputPixelType>(i);
-    }
-
-    OutputPixelType d1 = itk::Math::abs(g(l)) + (h(l) - iw) * (h(l) - iw);
+    OutputPixelType d1 = g[l] + (h[l] - iw) * (h[l] - iw);
 
     while (l < ns)
     {
       // be sure to compute d2 *only* if l < ns
-      OutputPixelType d2 = itk::Math::abs(g(l + 1)) + (h(l + 1) - iw) * (h(l + 1) - iw);
+      const OutputPixelType d2 = g[l + 1] + (h[l + 1] - iw) * (h[l + 1] - iw);
       // then compare d1 and d2
       if (d1 <= d2)
       {
@@ -401,30 +399,7 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned
       ++l;
       d1 = d2;
     }
-    idx[d] = i + startIndex[d];
-
-    if (Math::NotExactlyEquals(m_InputCache->GetPixel(idx), this->m_BackgroundValue))
-    {
-      if (this->m_InsideIsPositive)
-      {
-        output->SetPixel(idx, d1);
-      }
-      else
-      {
-        output->SetPixel(idx, -d1);
-      }
-    }
-    else
-    {
-      if (this->m_InsideIsPositive)
-      {
-        output->SetPixel(idx, -d1);
-      }
-      else
-      {
-        output->SetPixel(idx, d1);
-      }
-    }
+    line[i] = d1;
   }
 }
 
@@ -0,0 +1,194 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSignedMaurerDistanceMapImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingComparisonImageFilter.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Compute the signed distance maps of 2-D and 3-D binary images with several
+ * combinations of the parameters of the filter, and check them against the
+ * distances to the boundary pixels of the objects computed by brute force.
+ */
+namespace
+{
+template <typename TInputImage>
+typename TInputImage::Pointer
+itkSignedMaurerDistanceMapImageFilterBruteForceTestCreateImage(const typename TInputImage::SizeType & size,
+                                                               typename TInputImage::PixelType       backgroundValue)
+{
+  auto image = TInputImage::New();
+  image->SetRegions(size);
+  typename TInputImage::SpacingType spacing;
+  for (unsigned int d = 0; d < TInputImage::ImageDimension; ++d)
+  {
+    spacing[d] = 0.7 + 0.4 * d;
+  }
+  image->SetSpacing(spacing);
+  image->Allocate();
+
+  // Two overlapping balls with a hole, and a line of isolated pixels
+  itk::ImageRegionIteratorWithIndex<TInputImage> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    double       firstBall = 0.0;
+    double       secondBall = 0.0;
+    double       hole = 0.0;
+    for (unsigned int d = 0; d < TInputImage::ImageDimension; ++d)
+    {
+      firstBall += itk::Math::sqr(index[d] - 0.3 * size[d]);
+      secondBall += itk::Math::sqr(index[d] - 0.6 * size[d]);
+      hole += itk::Math::sqr(index[d] - 0.35 * size[d]);
+    }
+    const bool isObject = ((firstBall < itk::Math::sqr(0.25 * size[0]) || secondBall < itk::Math::sqr(0.2 * size[0])) &&
+                           hole > 2.0) ||
+                          (index[1] == 1 && index[0] % 4 == 0);
+    it.Set(isObject ? 1 : backgroundValue);
+  }
+  return image;
+}
+
+template <typename TInputImage, typename TOutputImage>
+int
+itkSignedMaurerDistanceMapImageFilterBruteForceTestCompare(const TInputImage *             image,
+                                                           typename TInputImage::PixelType backgroundValue,
+                                                           bool                            squaredDistance,
+                                                           bool                            insideIsPositive,
+                                                           bool                            useImageSpacing)
+{
+  constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+  using IndexType = typename TInputImage::IndexType;
+
+  std::cout << "Dimension: " << ImageDimension << ", squared distance: " << squaredDistance
+            << ", inside is positive: " << insideIsPositive << ", use image spacing: " << useImageSpacing << std::endl;
+
+  using FilterType = itk::SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>;
+  auto filter = FilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, SignedMaurerDistanceMapImageFilter, ImageToImageFilter);
+
+  filter->SetInput(image);
+  filter->SetBackgroundValue(backgroundValue);
+  ITK_TEST_SET_GET_VALUE(backgroundValue, filter->GetBackgroundValue());
+  ITK_TEST_SET_GET_BOOLEAN(filter, SquaredDistance, squaredDistance);
+  ITK_TEST_SET_GET_BOOLEAN(filter, InsideIsPositive, insideIsPositive);
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseImageSpacing, useImageSpacing);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  // The boundary pixels are the object pixels with a background pixel among
+  // their face, edge and vertex connected neighbors
+  const typename TInputImage::RegionType              region = image->GetLargestPossibleRegion();
+  std::vector<IndexType>                              boundary;
+  itk::ImageRegionConstIteratorWithIndex<TInputImage> it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() == backgroundValue)
+    {
+      continue;
+    }
+    bool hasBackgroundNeighbor = false;
+    for (unsigned int n = 0; n < itk::Math::UnsignedPower(3, ImageDimension) && !hasBackgroundNeighbor; ++n)
+    {
+      IndexType    neighbor = it.GetIndex();
+      unsigned int code = n;
+      for (unsigned int d = 0; d < ImageDimension; ++d, code /= 3)
+      {
+        neighbor[d] += static_cast<itk::IndexValueType>(code % 3) - 1;
+      }
+      hasBackgroundNeighbor = region.IsInside(neighbor) && image->GetPixel(neighbor) == backgroundValue;
+    }
+    if (hasBackgroundNeighbor)
+    {
+      boundary.push_back(it.GetIndex());
+    }
+  }
+
+  auto expectedImage = TOutputImage::New();
+  expectedImage->CopyInformation(filter->GetOutput());
+  expectedImage->SetRegions(region);
+  expectedImage->Allocate();
+  double maximumDistance = 1.0;
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    double squaredDistanceToBoundary = itk::NumericTraits<double>::max();
+    for (const IndexType & boundaryIndex : boundary)
+    {
+      double sum = 0.0;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        const double spacing = useImageSpacing ? image->GetSpacing()[d] : 1.0;
+        sum += itk::Math::sqr((it.GetIndex()[d] - boundaryIndex[d]) * spacing);
+      }
+      squaredDistanceToBoundary = std::min(squaredDistanceToBoundary, sum);
+    }
+    double expected = squaredDistance ? squaredDistanceToBoundary : std::sqrt(squaredDistanceToBoundary);
+    maximumDistance = std::max(maximumDistance, expected);
+    if ((it.Get() != backgroundValue) != insideIsPositive)
+    {
+      expected = -expected;
+    }
+    expectedImage->SetPixel(it.GetIndex(), static_cast<typename TOutputImage::PixelType>(expected));
+  }
+
+  using ComparisonFilterType = itk::Testing::ComparisonImageFilter<TOutputImage, TOutputImage>;
+  auto comparison = ComparisonFilterType::New();
+  comparison->SetValidInput(expectedImage);
+  comparison->SetTestInput(filter->GetOutput());
+  comparison->SetDifferenceThreshold(static_cast<typename TOutputImage::PixelType>(1e-4 * maximumDistance));
+  comparison->SetToleranceRadius(0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(comparison->Update());
+  ITK_TEST_EXPECT_EQUAL(comparison->GetNumberOfPixelsWithDifferences(), 0);
+
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkSignedMaurerDistanceMapImageFilterBruteForceTest(int, char *[])
+{
+  using ImageType2D = itk::Image<unsigned char, 2>;
+  using ImageType3D = itk::Image<short, 3>;
+
+  constexpr unsigned char backgroundValue2D = 0;
+  constexpr short         backgroundValue3D = -3;
+
+  const ImageType2D::Pointer image2D = itkSignedMaurerDistanceMapImageFilterBruteForceTestCreateImage<ImageType2D>(
+    ImageType2D::SizeType{ { 41, 29 } }, backgroundValue2D);
+  const ImageType3D::Pointer image3D = itkSignedMaurerDistanceMapImageFilterBruteForceTestCreateImage<ImageType3D>(
+    ImageType3D::SizeType{ { 23, 19, 17 } }, backgroundValue3D);
+
+  for (unsigned int parameters = 0; parameters < 8; ++parameters)
+  {
+    const bool squaredDistance = parameters & 1;
+    const bool insideIsPositive = parameters & 2;
+    const bool useImageSpacing = parameters & 4;
+    if (itkSignedMaurerDistanceMapImageFilterBruteForceTestCompare<ImageType2D, itk::Image<float, 2>>(
+          image2D, backgroundValue2D, squaredDistance, insideIsPositive, useImageSpacing) != EXIT_SUCCESS ||
+        itkSignedMaurerDistanceMapImageFilterBruteForceTestCompare<ImageType3D, itk::Image<double, 3>>(
+          image3D, backgroundValue3D, squaredDistance, insideIsPositive, useImageSpacing) != EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
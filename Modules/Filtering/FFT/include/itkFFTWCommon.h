@@ -60,6 +60,45 @@ protected:
   ~Proxy() = default;
 };
 
+#if (defined(ITK_USE_FFTWF) || defined(ITK_USE_FFTWD)) && !defined(ITK_USE_CUFFTW)
+/** Build the key of a plan in the plan cache of FFTWGlobalConfiguration. The
+ * plan can be executed on any arrays with the same alignment as the arrays it
+ * was created with, so the alignment is part of the key. */
+inline FFTWGlobalConfiguration::PlanCacheKeyType
+MakePlanCacheKey(int          kind,
+                 int          rank,
+                 const int *  n,
+                 unsigned int flags,
+                 int          threads,
+                 int          inAlignment,
+                 int          outAlignment,
+                 bool         inPlace)
+{
+  FFTWGlobalConfiguration::PlanCacheKeyType key{ kind, rank };
+  key.insert(key.end(), n, n + rank);
+  key.insert(key.end(), { static_cast<int>(flags), threads, inAlignment, outAlignment, inPlace });
+  return key;
+}
+
+/** Get the plan with the given key from the plan cache of
+ * FFTWGlobalConfiguration, or create it with the planner and add it to the
+ * cache. When isCachedPlan is false, the caller owns the plan. */
+template <typename TPlan, typename TPlanner>
+TPlan
+GetCachedPlan(const FFTWGlobalConfiguration::PlanCacheKeyType & key, TPlanner planner, bool & isCachedPlan)
+{
+  TPlan plan = nullptr;
+  if (FFTWGlobalConfiguration::GetCachedPlan(key, plan))
+  {
+    isCachedPlan = true;
+    return plan;
+  }
+  plan = planner();
+  isCachedPlan = FFTWGlobalConfiguration::AddCachedPlan(key, plan);
+  return plan;
+}
+#endif
+
 #if defined(ITK_USE_FFTWF)
 
 template <>
@@ -379,11 +418,116 @@ public:
   }
 
 
+  /** Get the plans of the transforms from the plan cache of
+   * FFTWGlobalConfiguration, or create them if they are not cached. A plan
+   * may be executed on other arrays with the same alignment with the
+   * Execute_dft functions. When isCachedPlan is false, the caller owns the
+   * plan and must destroy it. */
+  static PlanType
+  GetCachedPlan_dft_c2r(int           rank,
+                        const int *   n,
+                        ComplexType * in,
+                        PixelType *   out,
+                        unsigned int  flags,
+                        int           threads,
+                        bool &        isCachedPlan,
+                        bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto key = MakePlanCacheKey(0,
+                                      rank,
+                                      n,
+                                      flags,
+                                      threads,
+                                      fftwf_alignment_of(reinterpret_cast<PixelType *>(in)),
+                                      fftwf_alignment_of(out),
+                                      static_cast<void *>(in) == static_cast<void *>(out));
+    return GetCachedPlan<PlanType>(
+      key, [&]() { return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput); }, isCachedPlan);
+#  else
+    isCachedPlan = false;
+    return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+#  endif
+  }
+
+  static PlanType
+  GetCachedPlan_dft_r2c(int           rank,
+                        const int *   n,
+                        PixelType *   in,
+                        ComplexType * out,
+                        unsigned int  flags,
+                        int           threads,
+                        bool &        isCachedPlan,
+                        bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto key = MakePlanCacheKey(1,
+                                      rank,
+                                      n,
+                                      flags,
+                                      threads,
+                                      fftwf_alignment_of(in),
+                                      fftwf_alignment_of(reinterpret_cast<PixelType *>(out)),
+                                      static_cast<void *>(in) == static_cast<void *>(out));
+    return GetCachedPlan<PlanType>(
+      key, [&]() { return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput); }, isCachedPlan);
+#  else
+    isCachedPlan = false;
+    return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+#  endif
+  }
+
+  static PlanType
+  GetCachedPlan_dft(int           rank,
+                    const int *   n,
+                    ComplexType * in,
+                    ComplexType * out,
+                    int           sign,
+                    unsigned int  flags,
+                    int           threads,
+                    bool &        isCachedPlan,
+                    bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto key = MakePlanCacheKey(sign < 0 ? 2 : 3,
+                                      rank,
+                                      n,
+                                      flags,
+                                      threads,
+                                      fftwf_alignment_of(reinterpret_cast<PixelType *>(in)),
+                                      fftwf_alignment_of(reinterpret_cast<PixelType *>(out)),
+                                      in == out);
+    return GetCachedPlan<PlanType>(
+      key, [&]() { return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput); }, isCachedPlan);
+#  else
+    isCachedPlan = false;
+    return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput);
+#  endif
+  }
+
   static void
   Execute(PlanType p)
   {
     fftwf_execute(p);
   }
+
+  /** Execute a plan on other arrays than the ones it was created with, which
+   * must have the same sizes and alignment. */
+  static void
+  Execute_dft_c2r(PlanType p, ComplexType * in, PixelType * out)
+  {
+    fftwf_execute_dft_c2r(p, in, out);
+  }
+  static void
+  Execute_dft_r2c(PlanType p, PixelType * in, ComplexType * out)
+  {
+    fftwf_execute_dft_r2c(p, in, out);
+  }
+  static void
+  Execute_dft(PlanType p, ComplexType * in, ComplexType * out)
+  {
+    fftwf_execute_dft(p, in, out);
+  }
   static void
   DestroyPlan(PlanType p)
   {
@@ -714,11 +858,116 @@ public:
   }
 
 
+  /** Get the plans of the transforms from the plan cache of
+   * FFTWGlobalConfiguration, or create them if they are not cached. A plan
+   * may be executed on other arrays with the same alignment with the
+   * Execute_dft functions. When isCachedPlan is false, the caller owns the
+   * plan and must destroy it. */
+  static PlanType
+  GetCachedPlan_dft_c2r(int           rank,
+                        const int *   n,
+                        ComplexType * in,
+                        PixelType *   out,
+                        unsigned int  flags,
+                        int           threads,
+                        bool &        isCachedPlan,
+                        bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto key = MakePlanCacheKey(0,
+                                      rank,
+                                      n,
+                                      flags,
+                                      threads,
+                                      fftw_alignment_of(reinterpret_cast<PixelType *>(in)),
+                                      fftw_alignment_of(out),
+                                      static_cast<void *>(in) == static_cast<void *>(out));
+    return GetCachedPlan<PlanType>(
+      key, [&]() { return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput); }, isCachedPlan);
+#  else
+    isCachedPlan = false;
+    return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+#  endif
+  }
+
+  static PlanType
+  GetCachedPlan_dft_r2c(int           rank,
+                        const int *   n,
+                        PixelType *   in,
+                        ComplexType * out,
+                        unsigned int  flags,
+                        int           threads,
+                        bool &        isCachedPlan,
+                        bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto key = MakePlanCacheKey(1,
+                                      rank,
+                                      n,
+                                      flags,
+                                      threads,
+                                      fftw_alignment_of(in),
+                                      fftw_alignment_of(reinterpret_cast<PixelType *>(out)),
+                                      static_cast<void *>(in) == static_cast<void *>(out));
+    return GetCachedPlan<PlanType>(
+      key, [&]() { return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput); }, isCachedPlan);
+#  else
+    isCachedPlan = false;
+    return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+#  endif
+  }
+
+  static PlanType
+  GetCachedPlan_dft(int           rank,
+                    const int *   n,
+                    ComplexType * in,
+                    ComplexType * out,
+                    int           sign,
+                    unsigned int  flags,
+                    int           threads,
+                    bool &        isCachedPlan,
+                    bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto key = MakePlanCacheKey(sign < 0 ? 2 : 3,
+                                      rank,
+                                      n,
+                                      flags,
+                                      threads,
+                                      fftw_alignment_of(reinterpret_cast<PixelType *>(in)),
+                                      fftw_alignment_of(reinterpret_cast<PixelType *>(out)),
+                                      in == out);
+    return GetCachedPlan<PlanType>(
+      key, [&]() { return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput); }, isCachedPlan);
+#  else
+    isCachedPlan = false;
+    return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput);
+#  endif
+  }
+
   static void
   Execute(PlanType p)
   {
     fftw_execute(p);
   }
+
+  /** Execute a plan on other arrays than the ones it was created with, which
+   * must have the same sizes and alignment. */
+  static void
+  Execute_dft_c2r(PlanType p, ComplexType * in, PixelType * out)
+  {
+    fftw_execute_dft_c2r(p, in, out);
+  }
+  static void
+  Execute_dft_r2c(PlanType p, PixelType * in, ComplexType * out)
+  {
+    fftw_execute_dft_r2c(p, in, out);
+  }
+  static void
+  Execute_dft(PlanType p, ComplexType * in, ComplexType * out)
+  {
+    fftw_execute_dft(p, in, out);
+  }
   static void
   DestroyPlan(PlanType p)
   {
@@ -93,11 +93,15 @@ FFTWComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGen
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan =
-    FFTWProxyType::Plan_dft(ImageDimension, sizes, in, out, transformDirection, flags, this->GetNumberOfWorkUnits());
+  bool isCachedPlan = false;
+  plan = FFTWProxyType::GetCachedPlan_dft(
+    ImageDimension, sizes, in, out, transformDirection, flags, this->GetNumberOfWorkUnits(), isCachedPlan);
 
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  FFTWProxyType::Execute_dft(plan, in, out);
+  if (!isCachedPlan)
+  {
+    FFTWProxyType::DestroyPlan(plan);
+  }
 }
 
 
@@ -107,14 +107,15 @@ FFTWForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_r2c(ImageDimension,
-                                     sizes,
-                                     in,
-                                     (typename FFTWProxyType::ComplexType *)fftwOutput->GetBufferPointer(),
-                                     flags,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  auto * out = (typename FFTWProxyType::ComplexType *)fftwOutput->GetBufferPointer();
+  bool   isCachedPlan = false;
+  plan = FFTWProxyType::GetCachedPlan_dft_r2c(
+    ImageDimension, sizes, in, out, flags, MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), isCachedPlan);
+  FFTWProxyType::Execute_dft_r2c(plan, in, out);
+  if (!isCachedPlan)
+  {
+    FFTWProxyType::DestroyPlan(plan);
+  }
 
   // Expand the half image to the full image size
   using HalfToFullFilterType = HalfToFullHermitianImageFilter<OutputImageType>;
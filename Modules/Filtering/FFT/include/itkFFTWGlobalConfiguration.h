@@ -35,6 +35,8 @@
 #  endif
 #  include <algorithm>
 #  include <cctype>
+#  include <map>
+#  include <vector>
 
 struct FFTWGlobalConfigurationGlobals;
 
@@ -56,6 +58,9 @@ struct FFTWGlobalConfigurationGlobals;
 //                             file to be generated.  If this is
 //                             set, then ITK_FFTW_WISDOM_CACHE_BASE
 //                             is ignored.
+// ITK_FFTW_PLAN_CACHE_SIZE   - Defines the maximum number of plans kept
+//                             in the plan cache for each precision
+//                             (64 by default, 0 disables the cache).
 //
 // The above behaviors can also be controlled by the application.
 //
@@ -348,6 +353,51 @@ public:
   static bool
   ExportDefaultWisdomFile();
 
+  /** Key of a plan in the plan cache: the kind of transform, its sizes, the
+   * planner flags, the number of threads and the alignment of the arrays. */
+  using PlanCacheKeyType = std::vector<int>;
+
+  /**
+   * \brief Set/Get the maximum number of plans kept in the plan cache, for
+   * each precision.
+   *
+   * The FFTW filters take their plans from the plan cache, so that repeated
+   * transforms of the same size are not planned again. The plans are kept
+   * until ClearPlanCache() is called or the process ends. When the cache is
+   * full, the new plans are destroyed after their execution. Zero disables
+   * the cache. If the environmental variable "ITK_FFTW_PLAN_CACHE_SIZE" is
+   * set, then the environmental setting overrides the default setting.
+   */
+  static void
+  SetPlanCacheSize(const SizeValueType v);
+  static SizeValueType
+  GetPlanCacheSize();
+
+  /** Destroy the plans of the plan cache. This must not be called while an
+   * FFTW filter is running. */
+  static void
+  ClearPlanCache();
+
+#  if defined(ITK_USE_FFTWF)
+  /** Get the plan of the cache with the given key. Returns false if there is
+   * none. */
+  static bool
+  GetCachedPlan(const PlanCacheKeyType & key, fftwf_plan & plan);
+
+  /** Add a plan to the cache, which then owns it. Returns false, and leaves
+   * the plan to the caller, if the cache is full or already has a plan with
+   * the given key. */
+  static bool
+  AddCachedPlan(const PlanCacheKeyType & key, fftwf_plan plan);
+#  endif
+
+#  if defined(ITK_USE_FFTWD)
+  static bool
+  GetCachedPlan(const PlanCacheKeyType & key, fftw_plan & plan);
+  static bool
+  AddCachedPlan(const PlanCacheKeyType & key, fftw_plan plan);
+#  endif
+
 private:
   FFTWGlobalConfiguration();           // This will process env variables
   ~FFTWGlobalConfiguration() override; // This will write cache file if requested.
@@ -376,6 +426,15 @@ private:
   // m_WriteWisdomCache Controls the behavior of default
   // wisdom file creation policies.
   WisdomFilenameGeneratorBase * m_WisdomFilenameGenerator;
+
+  std::mutex    m_PlanCacheLock;
+  SizeValueType m_PlanCacheSize{ 64 };
+#  if defined(ITK_USE_FFTWF)
+  std::map<PlanCacheKeyType, fftwf_plan> m_FloatPlanCache;
+#  endif
+#  if defined(ITK_USE_FFTWD)
+  std::map<PlanCacheKeyType, fftw_plan> m_DoublePlanCache;
+#  endif
 };
 } // namespace itk
 #endif
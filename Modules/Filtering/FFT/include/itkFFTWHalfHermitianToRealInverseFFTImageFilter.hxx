@@ -98,13 +98,15 @@ FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeT
   {
     sizes[(ImageDimension - 1) - i] = outputSize[i];
   }
-  plan = FFTWProxyType::Plan_dft_c2r(ImageDimension,
-                                     sizes,
-                                     in,
-                                     out,
-                                     m_PlanRigor,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
-                                     !m_CanUseDestructiveAlgorithm);
+  bool isCachedPlan = false;
+  plan = FFTWProxyType::GetCachedPlan_dft_c2r(ImageDimension,
+                                              sizes,
+                                              in,
+                                              out,
+                                              m_PlanRigor,
+                                              MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
+                                              isCachedPlan,
+                                              !m_CanUseDestructiveAlgorithm);
   if (!m_CanUseDestructiveAlgorithm)
   {
     // complex<double> and double[2] types are compatible memory layouts.
@@ -113,10 +115,13 @@ FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeT
     std::copy_n(
       inputPtr->GetBufferPointer(), totalInputSize, reinterpret_cast<typename InputImageType::PixelType *>(in));
   }
-  FFTWProxyType::Execute(plan);
+  FFTWProxyType::Execute_dft_c2r(plan, in, out);
 
   // Some cleanup.
-  FFTWProxyType::DestroyPlan(plan);
+  if (!isCachedPlan)
+  {
+    FFTWProxyType::DestroyPlan(plan);
+  }
   if (!m_CanUseDestructiveAlgorithm)
   {
     delete[] in;
@@ -91,12 +91,16 @@ FFTWInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData
     sizes[(ImageDimension - 1) - i] = outputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_c2r(
-    ImageDimension, sizes, in, out, m_PlanRigor, MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), false);
-  FFTWProxyType::Execute(plan);
+  bool isCachedPlan = false;
+  plan = FFTWProxyType::GetCachedPlan_dft_c2r(
+    ImageDimension, sizes, in, out, m_PlanRigor, MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), isCachedPlan);
+  FFTWProxyType::Execute_dft_c2r(plan, in, out);
 
   // Some cleanup.
-  FFTWProxyType::DestroyPlan(plan);
+  if (!isCachedPlan)
+  {
+    FFTWProxyType::DestroyPlan(plan);
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
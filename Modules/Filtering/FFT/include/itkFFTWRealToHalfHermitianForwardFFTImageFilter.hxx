@@ -90,10 +90,14 @@ FFTWRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generat
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_r2c(
-    ImageDimension, sizes, in, out, flags, MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  bool isCachedPlan = false;
+  plan = FFTWProxyType::GetCachedPlan_dft_r2c(
+    ImageDimension, sizes, in, out, flags, MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), isCachedPlan);
+  FFTWProxyType::Execute_dft_r2c(plan, in, out);
+  if (!isCachedPlan)
+  {
+    FFTWProxyType::DestroyPlan(plan);
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -38,6 +38,7 @@
 #  endif
 
 #  include "itkObjectFactory.h"
+#  include <sstream>
 
 namespace itk
 {
@@ -410,6 +411,23 @@ FFTWGlobalConfiguration::FFTWGlobalConfiguration()
     }
   }
 
+  {
+    std::string planCacheSizeString;
+    if (itksys::SystemTools::GetEnv("ITK_FFTW_PLAN_CACHE_SIZE", planCacheSizeString))
+    {
+      std::istringstream planCacheSizeStream(planCacheSizeString);
+      SizeValueType      planCacheSize = 0;
+      if (planCacheSizeStream >> planCacheSize)
+      {
+        this->m_PlanCacheSize = planCacheSize;
+      }
+      else
+      {
+        itkWarningMacro("Warning: Invalid FFTW plan cache size: " << planCacheSizeString);
+      }
+    }
+  }
+
 #  if defined(ITK_USE_FFTWF)
   // TODO:  Investigate if this is really a warnable situation.
   //       fftw should work just fine without threads
@@ -491,6 +509,20 @@ FFTWGlobalConfiguration::FFTWGlobalConfiguration()
 
 FFTWGlobalConfiguration::~FFTWGlobalConfiguration()
 {
+  // The plans must be destroyed before the cleanup of FFTW
+#  if defined(ITK_USE_FFTWF)
+  for (const auto & keyAndPlan : this->m_FloatPlanCache)
+  {
+    fftwf_destroy_plan(keyAndPlan.second);
+  }
+#  endif
+#  if defined(ITK_USE_FFTWD)
+  for (const auto & keyAndPlan : this->m_DoublePlanCache)
+  {
+    fftw_destroy_plan(keyAndPlan.second);
+  }
+#  endif
+
   if (this->m_WriteWisdomCache && this->m_NewWisdomAvailable)
   {
     std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -830,6 +862,121 @@ FFTWGlobalConfiguration::GetWisdomCacheBase()
   return GetInstance()->m_WisdomCacheBase;
 }
 
+void
+FFTWGlobalConfiguration::SetPlanCacheSize(const SizeValueType v)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(GetInstance()->m_PlanCacheLock);
+  GetInstance()->m_PlanCacheSize = v;
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetPlanCacheSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(GetInstance()->m_PlanCacheLock);
+  return GetInstance()->m_PlanCacheSize;
+}
+
+void
+FFTWGlobalConfiguration::ClearPlanCache()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer instance = GetInstance();
+
+  // The plans are destroyed with the FFTW lock, as required by FFTW
+  const std::lock_guard<std::mutex> fftwLock(instance->m_Lock);
+  const std::lock_guard<std::mutex> lock(instance->m_PlanCacheLock);
+#  if defined(ITK_USE_FFTWF)
+  for (const auto & keyAndPlan : instance->m_FloatPlanCache)
+  {
+    fftwf_destroy_plan(keyAndPlan.second);
+  }
+  instance->m_FloatPlanCache.clear();
+#  endif
+#  if defined(ITK_USE_FFTWD)
+  for (const auto & keyAndPlan : instance->m_DoublePlanCache)
+  {
+    fftw_destroy_plan(keyAndPlan.second);
+  }
+  instance->m_DoublePlanCache.clear();
+#  endif
+}
+
+namespace
+{
+template <typename TPlan>
+bool
+GetPlanFromCache(std::mutex &                                                         cacheLock,
+                 const std::map<FFTWGlobalConfiguration::PlanCacheKeyType, TPlan> & cache,
+                 const FFTWGlobalConfiguration::PlanCacheKeyType &                  key,
+                 TPlan &                                                            plan)
+{
+  const std::lock_guard<std::mutex> lock(cacheLock);
+  const auto                        it = cache.find(key);
+  if (it == cache.end())
+  {
+    return false;
+  }
+  plan = it->second;
+  return true;
+}
+
+template <typename TPlan>
+bool
+AddPlanToCache(std::mutex &                                                   cacheLock,
+               const SizeValueType                                            cacheSize,
+               std::map<FFTWGlobalConfiguration::PlanCacheKeyType, TPlan> & cache,
+               const FFTWGlobalConfiguration::PlanCacheKeyType &            key,
+               TPlan                                                          plan)
+{
+  const std::lock_guard<std::mutex> lock(cacheLock);
+  if (cache.size() >= cacheSize)
+  {
+    return false;
+  }
+  return cache.emplace(key, plan).second;
+}
+} // namespace
+
+#  if defined(ITK_USE_FFTWF)
+bool
+FFTWGlobalConfiguration::GetCachedPlan(const PlanCacheKeyType & key, fftwf_plan & plan)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer instance = GetInstance();
+  return GetPlanFromCache(instance->m_PlanCacheLock, instance->m_FloatPlanCache, key, plan);
+}
+
+bool
+FFTWGlobalConfiguration::AddCachedPlan(const PlanCacheKeyType & key, fftwf_plan plan)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer instance = GetInstance();
+  return AddPlanToCache(
+    instance->m_PlanCacheLock, instance->m_PlanCacheSize, instance->m_FloatPlanCache, key, plan);
+}
+#  endif
+
+#  if defined(ITK_USE_FFTWD)
+bool
+FFTWGlobalConfiguration::GetCachedPlan(const PlanCacheKeyType & key, fftw_plan & plan)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer instance = GetInstance();
+  return GetPlanFromCache(instance->m_PlanCacheLock, instance->m_DoublePlanCache, key, plan);
+}
+
+bool
+FFTWGlobalConfiguration::AddCachedPlan(const PlanCacheKeyType & key, fftw_plan plan)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer instance = GetInstance();
+  return AddPlanToCache(
+    instance->m_PlanCacheLock, instance->m_PlanCacheSize, instance->m_DoublePlanCache, key, plan);
+}
+#  endif
+
 } // end namespace itk
 
 #endif
@@ -0,0 +1,159 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTWRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include <cmath>
+#include <vector>
+
+/*
+ * Check that the FFTW plans are taken from the plan cache of
+ * FFTWGlobalConfiguration, that a cached plan transforms new images as a new
+ * plan does, and that a plan cache of size zero leaves the plans to the
+ * caller.
+ */
+#if (defined(ITK_USE_FFTWF) || defined(ITK_USE_FFTWD)) && !defined(ITK_USE_CUFFTW)
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+itkFFTWPlanCacheTestCreateImage(double frequency)
+{
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::SizeType{ { 12, 10 } });
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const typename TImage::IndexType index = it.GetIndex();
+    it.Set(static_cast<typename TImage::PixelType>(std::sin(frequency * index[0]) + std::cos(frequency * index[1])));
+  }
+  return image;
+}
+
+template <typename TPixel>
+int
+itkFFTWPlanCacheTestRun()
+{
+  using ImageType = itk::Image<TPixel, 2>;
+  using ComplexImageType = itk::Image<std::complex<TPixel>, 2>;
+  using FFTType = itk::FFTWRealToHalfHermitianForwardFFTImageFilter<ImageType, ComplexImageType>;
+  using FFTWProxyType = itk::fftw::Proxy<TPixel>;
+  using PlanType = typename FFTWProxyType::PlanType;
+  using ComplexType = typename FFTWProxyType::ComplexType;
+
+  const itk::SizeValueType planCacheSize = itk::FFTWGlobalConfiguration::GetPlanCacheSize();
+
+  // Reference transforms, planned for each update
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  itk::FFTWGlobalConfiguration::SetPlanCacheSize(0);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 0);
+
+  const std::vector<typename ImageType::Pointer> inputs{ itkFFTWPlanCacheTestCreateImage<ImageType>(0.3),
+                                                         itkFFTWPlanCacheTestCreateImage<ImageType>(0.7) };
+  std::vector<typename ComplexImageType::Pointer> references;
+  for (const auto & input : inputs)
+  {
+    auto fft = FFTType::New();
+    fft->SetInput(input);
+    ITK_TRY_EXPECT_NO_EXCEPTION(fft->Update());
+    references.push_back(fft->GetOutput());
+  }
+
+  // Without plan cache, the caller owns the plan
+  int                 sizes[2] = { 10, 12 };
+  std::vector<TPixel> in(10 * 12);
+  std::vector<TPixel> out(2 * 10 * 7);
+  auto *              complexOut = reinterpret_cast<ComplexType *>(out.data());
+  bool                isCachedPlan = true;
+
+  PlanType plan = FFTWProxyType::GetCachedPlan_dft_r2c(2, sizes, in.data(), complexOut, FFTW_ESTIMATE, 1, isCachedPlan);
+  ITK_TEST_EXPECT_TRUE(!isCachedPlan);
+  FFTWProxyType::DestroyPlan(plan);
+
+  // With a plan cache, the same transform is planned once
+  itk::FFTWGlobalConfiguration::SetPlanCacheSize(planCacheSize > 0 ? planCacheSize : 64);
+  plan = FFTWProxyType::GetCachedPlan_dft_r2c(2, sizes, in.data(), complexOut, FFTW_ESTIMATE, 1, isCachedPlan);
+  ITK_TEST_EXPECT_TRUE(isCachedPlan);
+  const PlanType cachedPlan =
+    FFTWProxyType::GetCachedPlan_dft_r2c(2, sizes, in.data(), complexOut, FFTW_ESTIMATE, 1, isCachedPlan);
+  ITK_TEST_EXPECT_TRUE(isCachedPlan);
+  ITK_TEST_EXPECT_TRUE(cachedPlan == plan);
+
+  // The cached plans transform the images of the filters as new plans do
+  for (unsigned int update = 0; update < 2; ++update)
+  {
+    for (unsigned int i = 0; i < inputs.size(); ++i)
+    {
+      auto fft = FFTType::New();
+      fft->SetInput(inputs[i]);
+      ITK_TRY_EXPECT_NO_EXCEPTION(fft->Update());
+
+      itk::ImageRegionConstIterator<ComplexImageType> it(fft->GetOutput(),
+                                                         fft->GetOutput()->GetLargestPossibleRegion());
+      itk::ImageRegionConstIterator<ComplexImageType> referenceIt(references[i],
+                                                                  references[i]->GetLargestPossibleRegion());
+      for (; !it.IsAtEnd(); ++it, ++referenceIt)
+      {
+        if (std::abs(it.Get() - referenceIt.Get()) > 1e-4 * (1.0 + std::abs(referenceIt.Get())))
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "Update " << update << " of input " << i << ": " << it.Get() << " != " << referenceIt.Get()
+                    << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  itk::FFTWGlobalConfiguration::SetPlanCacheSize(planCacheSize);
+  return EXIT_SUCCESS;
+}
+} // namespace
+#endif
+
+int
+itkFFTWPlanCacheTest(int, char *[])
+{
+#if (defined(ITK_USE_FFTWF) || defined(ITK_USE_FFTWD)) && !defined(ITK_USE_CUFFTW)
+#  if defined(ITK_USE_FFTWF)
+  std::cout << "FFTWF plan cache" << std::endl;
+  if (itkFFTWPlanCacheTestRun<float>() != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+#  endif
+#  if defined(ITK_USE_FFTWD)
+  std::cout << "FFTWD plan cache" << std::endl;
+  if (itkFFTWPlanCacheTestRun<double>() != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+#  endif
+#else
+  std::cout << "The FFTW plan cache is not used with cuFFTW." << std::endl;
+#endif
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
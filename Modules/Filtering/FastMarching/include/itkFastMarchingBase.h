@@ -22,9 +22,9 @@
 #include "itkIntTypes.h"
 #include "itkFastMarchingStoppingCriterionBase.h"
 #include "itkFastMarchingTraits.h"
+#include "itkFastMarchingTrialHeap.h"
 #include "ITKFastMarchingExport.h"
 
-#include <queue>
 #include <functional>
 
 namespace itk
@@ -63,8 +63,9 @@ extern ITKFastMarching_EXPORT std::ostream &
  *
  * Updates are performed using an entropy satisfy scheme where only
  * "upwind" neighborhoods are used. This implementation of Fast Marching
- * uses a std::priority_queue to locate the next proper node to
- * update.
+ * uses a FastMarchingTrialHeap to locate the next proper node to
+ * update. The value of a trial node is updated in place in the heap, so
+ * that each node is in the heap at most once.
  *
  * Fast Marching sweeps through N points in (N log N) steps to obtain
  * the arrival time value as the front propagates through the domain.
@@ -91,10 +92,6 @@ extern ITKFastMarching_EXPORT std::ostream &
  *    \li Superclass (itk::ImageToImageFilter or
  * itk::QuadEdgeMeshToQuadEdgeMeshFilter )
  *
- * \todo In the current implementation, std::priority_queue only allows
- * taking nodes out from the front and putting nodes in from the back.
- * Use itk::PriorityQueueContainer instead.
- *
  * \par Topology constraints:
  * Additional flexibility in this class includes the implementation of
  * topology constraints for image-based fast marching.  Further details
@@ -163,18 +160,6 @@ public:
   using StoppingCriterionType = FastMarchingStoppingCriterionBase<TInput, TOutput>;
   using StoppingCriterionPointer = typename StoppingCriterionType::Pointer;
 
-  /*
-  using ElementIdentifier = long;
-
-  using PriorityQueueElementType = MinPriorityQueueElementWrapper< NodeType,
-    OutputPixelType,
-    ElementIdentifier >;
-
-  using PriorityQueueType = PriorityQueueContainer< PriorityQueueElementType,
-    PriorityQueueElementType, OutputPixelType, ElementIdentifier >;
-  using PriorityQueuePointer = typename PriorityQueueType::Pointer;
-  */
-
   using TopologyCheckEnum = FastMarchingTraitsEnums::TopologyCheck;
 #if !defined(ITK_LEGACY_REMOVE)
   using TopologyCheckType = FastMarchingTraitsEnums::TopologyCheck;
@@ -254,11 +239,9 @@ protected:
 
   bool m_CollectPoints;
 
-  // PriorityQueuePointer m_Heap;
-  using HeapContainerType = std::vector<NodePairType>;
-  using NodeComparerType = std::greater<NodePairType>;
-
-  using PriorityQueueType = std::priority_queue<NodePairType, HeapContainerType, NodeComparerType>;
+  /** Trial nodes, identified in the heap by their offset in the output image
+   * or their point identifier in the output mesh. */
+  using PriorityQueueType = FastMarchingTrialHeap<NodePairType>;
 
   PriorityQueueType m_Heap;
 
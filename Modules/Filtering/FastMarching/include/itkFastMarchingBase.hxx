@@ -36,7 +36,6 @@ FastMarchingBase<TInput, TOutput>::FastMarchingBase()
   m_ProcessedPoints = nullptr;
   m_ForbiddenPoints = nullptr;
 
-  // m_Heap = PriorityQueueType::New();
   m_SpeedConstant = 1.;
   m_InverseSpeed = -1.;
   m_NormalizationFactor = 1.;
@@ -91,16 +90,7 @@ FastMarchingBase<TInput, TOutput>::Initialize(OutputDomainType * oDomain)
   }
 
   // make sure the heap is empty
-  while (!m_Heap.empty())
-  {
-    m_Heap.pop();
-  }
-  /*
-  while ( !m_Heap->Empty() )
-    {
-    m_Heap->Pop();
-    }
-  */
+  m_Heap.Clear();
 
   this->InitializeOutput(oDomain);
 
@@ -127,50 +117,40 @@ FastMarchingBase<TInput, TOutput>::GenerateData()
 
   try
   {
-    // while( !m_Heap->Empty() )
-    while (!m_Heap.empty())
+    while (!m_Heap.Empty())
     {
-      // PriorityQueueElementType element = m_Heap->Peek();
-      // m_Heap->Pop();
-      //
-      // NodeType current_node = element.m_Element;
-      // OutputPixelType current_value = element.m_Priority;
-
-
-      NodePairType current_node_pair = m_Heap.top();
-      m_Heap.pop();
+      // each node is in the heap only once, with its current value
+      NodePairType current_node_pair = m_Heap.Top();
+      m_Heap.Pop();
 
       NodeType current_node = current_node_pair.GetNode();
-      current_value = this->GetOutputValue(output, current_node);
+      current_value = current_node_pair.GetValue();
 
-      if (Math::ExactlyEquals(current_value, current_node_pair.GetValue()))
+      // is this node already alive ?
+      if (this->GetLabelValueForGivenNode(current_node) != Traits::Alive)
       {
-        // is this node already alive ?
-        if (this->GetLabelValueForGivenNode(current_node) != Traits::Alive)
+        m_StoppingCriterion->SetCurrentNodePair(current_node_pair);
+
+        if (m_StoppingCriterion->IsSatisfied())
         {
-          m_StoppingCriterion->SetCurrentNodePair(current_node_pair);
+          break;
+        }
 
-          if (m_StoppingCriterion->IsSatisfied())
+        if (this->CheckTopology(output, current_node))
+        {
+          if (m_CollectPoints)
           {
-            break;
+            m_ProcessedPoints->push_back(current_node_pair);
           }
 
-          if (this->CheckTopology(output, current_node))
-          {
-            if (m_CollectPoints)
-            {
-              m_ProcessedPoints->push_back(current_node_pair);
-            }
-
-            // set this node as alive
-            this->SetLabelValueForGivenNode(current_node, Traits::Alive);
+          // set this node as alive
+          this->SetLabelValueForGivenNode(current_node, Traits::Alive);
 
-            // update its neighbors
-            this->UpdateNeighbors(output, current_node);
-          }
+          // update its neighbors
+          this->UpdateNeighbors(output, current_node);
         }
-        progress.CompletedPixel();
       }
+      progress.CompletedPixel();
     }
   }
   catch (const ProcessAborted &)
@@ -181,14 +161,7 @@ FastMarchingBase<TInput, TOutput>::GenerateData()
     // it.
     //
     // RELEASE MEMORY!!!
-    while (!m_Heap.empty())
-    {
-      m_Heap.pop();
-    }
-    /*while( !m_Heap->Empty() )
-      {
-      m_Heap->Pop();
-      }*/
+    m_Heap.Clear();
 
     throw ProcessAborted(__FILE__, __LINE__);
   }
@@ -196,14 +169,7 @@ FastMarchingBase<TInput, TOutput>::GenerateData()
   m_TargetReachedValue = current_value;
 
   // let's release some useless memory...
-  while (!m_Heap.empty())
-  {
-    m_Heap.pop();
-  }
-  /*while( !m_Heap->Empty() )
-    {
-    m_Heap->Pop();
-    }*/
+  m_Heap.Clear();
 }
 // -----------------------------------------------------------------------------
 
@@ -20,12 +20,12 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkFastMarchingTrialHeap.h"
 #include "itkLevelSet.h"
 #include "itkMath.h"
 #include "ITKFastMarchingExport.h"
 
 #include <functional>
-#include <queue>
 #include "itkMath.h"
 
 namespace itk
@@ -68,8 +68,9 @@ extern ITKFastMarching_EXPORT std::ostream &
  *
  * Updates are performed using an entropy satisfy scheme where only
  * "upwind" neighborhoods are used. This implementation of Fast Marching
- * uses a std::priority_queue to locate the next proper grid position to
- * update.
+ * uses a FastMarchingTrialHeap to locate the next proper grid position to
+ * update. The value of a trial point is updated in place in the heap, so
+ * that each point is in the heap at most once.
  *
  * Fast Marching sweeps through N grid points in (N log N) steps to obtain
  * the arrival time value as the front propagates through the grid.
@@ -115,18 +116,6 @@ extern ITKFastMarching_EXPORT std::ostream &
  *
  * For an alternative implementation, see itk::FastMarchingImageFilter.
  *
- * Possible Improvements:
- * In the current implementation, std::priority_queue only allows
- * taking nodes out from the front and putting nodes in from the back.
- * To update a value already on the heap, a new node is added to the heap.
- * The defunct old node is left on the heap. When it is removed from the
- * top, it will be recognized as invalid and not used.
- * Future implementations can implement the heap in a different way
- * allowing the values to be updated. This will generally require
- * some sift-up and sift-down functions and
- * an image of back-pointers going from the image to heap in order
- * to locate the node which is to be updated.
- *
  * \sa FastMarchingImageFilterBase
  * \sa LevelSetTypeDefault
  * \ingroup LevelSetSegmentation
@@ -454,10 +443,9 @@ private:
 
   /** Trial points are stored in a min-heap. This allow efficient access
    * to the trial point with minimum value which is the next grid point
-   * the algorithm processes. */
-  using HeapContainer = std::vector<AxisNodeType>;
-  using NodeComparer = std::greater<AxisNodeType>;
-  using HeapType = std::priority_queue<AxisNodeType, HeapContainer, NodeComparer>;
+   * the algorithm processes. The points are identified in the heap by their
+   * offset in the output image. */
+  using HeapType = FastMarchingTrialHeap<NodeType>;
 
   HeapType m_TrialHeap;
 
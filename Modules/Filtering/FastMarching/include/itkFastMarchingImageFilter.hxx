@@ -222,10 +222,7 @@ FastMarchingImageFilter<TLevelSet, TSpeedImage>::Initialize(LevelSetImageType *
   }
 
   // make sure the heap is empty
-  while (!m_TrialHeap.empty())
-  {
-    m_TrialHeap.pop();
-  }
+  m_TrialHeap.Clear();
 
   // process the input trial points
   if (m_TrialPoints)
@@ -248,7 +245,7 @@ FastMarchingImageFilter<TLevelSet, TSpeedImage>::Initialize(LevelSetImageType *
         outputPixel = node.GetValue();
         output->SetPixel(idx, outputPixel);
 
-        m_TrialHeap.push(node);
+        m_TrialHeap.Push(output->ComputeOffset(idx), node);
       }
       ++pointsIter;
     }
@@ -285,56 +282,57 @@ FastMarchingImageFilter<TLevelSet, TSpeedImage>::GenerateData()
   this->UpdateProgress(0.0); // Send first progress event
 
   // CACHE
-  while (!m_TrialHeap.empty())
+  while (!m_TrialHeap.Empty())
   {
-    // get the node with the smallest value
-    node = m_TrialHeap.top();
-    m_TrialHeap.pop();
+    // get the node with the smallest value, each node being in the heap
+    // only once, with its current value
+    node = m_TrialHeap.Top();
+    m_TrialHeap.Pop();
 
-    // does this node contain the current value ?
-    currentValue = static_cast<double>(output->GetPixel(node.GetIndex()));
+    currentValue = static_cast<double>(node.GetValue());
 
-    if (Math::ExactlyEquals(node.GetValue(), currentValue))
+    // is this node already alive ?
+    if (m_LabelImage->GetPixel(node.GetIndex()) != LabelEnum::AlivePoint)
     {
-      // is this node already alive ?
-      if (m_LabelImage->GetPixel(node.GetIndex()) != LabelEnum::AlivePoint)
+      if (currentValue > m_StoppingValue)
       {
-        if (currentValue > m_StoppingValue)
-        {
-          this->UpdateProgress(1.0);
-          break;
-        }
+        this->UpdateProgress(1.0);
+        break;
+      }
 
-        if (m_CollectPoints)
-        {
-          m_ProcessedPoints->InsertElement(m_ProcessedPoints->Size(), node);
-        }
+      if (m_CollectPoints)
+      {
+        m_ProcessedPoints->InsertElement(m_ProcessedPoints->Size(), node);
+      }
 
-        // set this node as alive
-        m_LabelImage->SetPixel(node.GetIndex(), LabelEnum::AlivePoint);
+      // set this node as alive
+      m_LabelImage->SetPixel(node.GetIndex(), LabelEnum::AlivePoint);
 
-        // update its neighbors
-        this->UpdateNeighbors(node.GetIndex(), speedImage, output);
+      // update its neighbors
+      this->UpdateNeighbors(node.GetIndex(), speedImage, output);
 
-        // Send events every certain number of points.
-        const double newProgress = currentValue / m_StoppingValue;
-        if (newProgress - oldProgress > 0.01) // update every 1%
+      // Send events every certain number of points.
+      const double newProgress = currentValue / m_StoppingValue;
+      if (newProgress - oldProgress > 0.01) // update every 1%
+      {
+        this->UpdateProgress(newProgress);
+        oldProgress = newProgress;
+        if (this->GetAbortGenerateData())
         {
-          this->UpdateProgress(newProgress);
-          oldProgress = newProgress;
-          if (this->GetAbortGenerateData())
-          {
-            this->InvokeEvent(AbortEvent());
-            this->ResetPipeline();
-            ProcessAborted e(__FILE__, __LINE__);
-            e.SetDescription("Process aborted.");
-            e.SetLocation(ITK_LOCATION);
-            throw e;
-          }
+          m_TrialHeap.Clear();
+          this->InvokeEvent(AbortEvent());
+          this->ResetPipeline();
+          ProcessAborted e(__FILE__, __LINE__);
+          e.SetDescription("Process aborted.");
+          e.SetLocation(ITK_LOCATION);
+          throw e;
         }
       }
     }
   }
+
+  // release the memory of the heap
+  m_TrialHeap.Clear();
 }
 
 template <typename TLevelSet, typename TSpeedImage>
@@ -493,7 +491,7 @@ FastMarchingImageFilter<TLevelSet, TSpeedImage>::UpdateValue(const IndexType &
     m_LabelImage->SetPixel(index, LabelEnum::TrialPoint);
     node.SetValue(outputPixel);
     node.SetIndex(index);
-    m_TrialHeap.push(node);
+    m_TrialHeap.Push(output->ComputeOffset(index), node);
   }
 
   return solution;
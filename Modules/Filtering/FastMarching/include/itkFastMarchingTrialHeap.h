@@ -0,0 +1,214 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkFastMarchingTrialHeap_h
+#define itkFastMarchingTrialHeap_h
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class FastMarchingTrialHeap
+ * \brief Min-heap of the trial nodes of fast marching, which updates in place
+ * the value of the nodes it already contains
+ *
+ * std::priority_queue cannot change the value of an element it contains, so
+ * each update of a trial node used to push a new copy of the node, and the
+ * outdated copies were skipped when they reached the top of the heap. This
+ * heap stores the position of each node in a hash table keyed by an
+ * identifier of the node, its offset in the output image or its point
+ * identifier in the output mesh. Pushing a node which is already in the heap moves it to the
+ * place of its new value, so that each node is in the heap at most once, and
+ * is popped only once.
+ *
+ * It is a d-ary heap, VArity children per element, which is shallower and
+ * accesses less memory than a binary heap. The elements are ordered with
+ * TCompare, and the top element is the smallest one.
+ *
+ * The table of positions holds the nodes of the heap only, so the memory of
+ * the heap grows with the number of trial nodes, not with the size of the
+ * output. It is released by Clear().
+ *
+ * \ingroup ITKFastMarching
+ */
+template <typename TElement, typename TCompare = std::less<TElement>, unsigned int VArity = 4>
+class FastMarchingTrialHeap
+{
+public:
+  using ElementType = TElement;
+  using CompareType = TCompare;
+
+  static_assert(VArity >= 2, "The heap must have at least two children per element.");
+
+  /** Whether the heap is empty. */
+  bool
+  Empty() const
+  {
+    return m_Heap.empty();
+  }
+
+  /** Number of elements in the heap. */
+  SizeValueType
+  Size() const
+  {
+    return m_Heap.size();
+  }
+
+  /** Whether the node of the given identifier is in the heap. */
+  bool
+  Contains(IdentifierType identifier) const
+  {
+    return m_Positions.find(identifier) != m_Positions.end();
+  }
+
+  /** Smallest element of the heap. The heap must not be empty. */
+  const ElementType &
+  Top() const
+  {
+    return m_Heap.front().m_Element;
+  }
+
+  /** Remove the smallest element of the heap. The heap must not be empty. */
+  void
+  Pop()
+  {
+    m_Positions.erase(m_Heap.front().m_Identifier);
+    if (m_Heap.size() > 1)
+    {
+      HeapEntry last = std::move(m_Heap.back());
+      m_Heap.pop_back();
+      this->SiftDown(0, std::move(last));
+    }
+    else
+    {
+      m_Heap.pop_back();
+    }
+  }
+
+  /** Insert the node of the given identifier, or replace it if it is already
+   * in the heap. */
+  void
+  Push(IdentifierType identifier, const ElementType & element)
+  {
+    const auto it = m_Positions.find(identifier);
+    if (it == m_Positions.end())
+    {
+      if (m_Heap.size() >= static_cast<SizeValueType>(std::numeric_limits<PositionType>::max()))
+      {
+        itkGenericExceptionMacro(<< "Too many elements in the fast marching trial heap");
+      }
+      m_Heap.emplace_back();
+      this->SiftUp(static_cast<PositionType>(m_Heap.size() - 1), HeapEntry{ element, identifier });
+    }
+    else if (m_Compare(element, m_Heap[it->second].m_Element))
+    {
+      this->SiftUp(it->second, HeapEntry{ element, identifier });
+    }
+    else
+    {
+      this->SiftDown(it->second, HeapEntry{ element, identifier });
+    }
+  }
+
+  /** Remove all the elements, and release the memory. */
+  void
+  Clear()
+  {
+    std::vector<HeapEntry>().swap(m_Heap);
+    std::unordered_map<IdentifierType, PositionType>().swap(m_Positions);
+  }
+
+private:
+  using PositionType = uint32_t;
+
+  struct HeapEntry
+  {
+    ElementType    m_Element;
+    IdentifierType m_Identifier;
+  };
+
+  /** Move the entry from the hole at the given position toward the top. */
+  void
+  SiftUp(PositionType hole, HeapEntry entry)
+  {
+    while (hole > 0)
+    {
+      const PositionType parent = (hole - 1) / VArity;
+      if (!m_Compare(entry.m_Element, m_Heap[parent].m_Element))
+      {
+        break;
+      }
+      this->Place(hole, std::move(m_Heap[parent]));
+      hole = parent;
+    }
+    this->Place(hole, std::move(entry));
+  }
+
+  /** Move the entry from the hole at the given position toward the bottom. */
+  void
+  SiftDown(PositionType hole, HeapEntry entry)
+  {
+    const auto size = static_cast<SizeValueType>(m_Heap.size());
+    for (;;)
+    {
+      const SizeValueType firstChild = static_cast<SizeValueType>(hole) * VArity + 1;
+      if (firstChild >= size)
+      {
+        break;
+      }
+      const SizeValueType endChild = std::min(firstChild + VArity, size);
+      SizeValueType       smallest = firstChild;
+      for (SizeValueType child = firstChild + 1; child < endChild; ++child)
+      {
+        if (m_Compare(m_Heap[child].m_Element, m_Heap[smallest].m_Element))
+        {
+          smallest = child;
+        }
+      }
+      if (!m_Compare(m_Heap[smallest].m_Element, entry.m_Element))
+      {
+        break;
+      }
+      this->Place(hole, std::move(m_Heap[smallest]));
+      hole = static_cast<PositionType>(smallest);
+    }
+    this->Place(hole, std::move(entry));
+  }
+
+  void
+  Place(PositionType position, HeapEntry && entry)
+  {
+    m_Positions[entry.m_Identifier] = position;
+    m_Heap[position] = std::move(entry);
+  }
+
+  std::vector<HeapEntry>                           m_Heap;
+  std::unordered_map<IdentifierType, PositionType> m_Positions;
+  CompareType                                      m_Compare;
+};
+} // namespace itk
+
+#endif // itkFastMarchingTrialHeap_h
@@ -0,0 +1,113 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFastMarchingTrialHeap.h"
+#include "itkNodePair.h"
+#include <iostream>
+#include <map>
+#include <random>
+
+/*
+ * Push, update and pop random nodes, and check that the heap always gives
+ * the node of smallest current value, each node only once.
+ */
+namespace
+{
+template <unsigned int VArity>
+int
+itkFastMarchingTrialHeapTestRun()
+{
+  using NodePairType = itk::NodePair<itk::IdentifierType, double>;
+  using HeapType = itk::FastMarchingTrialHeap<NodePairType, std::less<NodePairType>, VArity>;
+
+  HeapType                                    heap;
+  std::map<itk::IdentifierType, double>       values;
+  std::mt19937                                generator(VArity);
+  std::uniform_int_distribution<unsigned int> identifiers(0, 499);
+  std::uniform_real_distribution<double>      distribution(0.0, 100.0);
+
+  for (unsigned int iteration = 0; iteration < 20000; ++iteration)
+  {
+    if (generator() % 3 != 0)
+    {
+      // insert a node, or update its value up or down
+      const itk::IdentifierType identifier = identifiers(generator);
+      const double              value = distribution(generator);
+      heap.Push(identifier, NodePairType(identifier, value));
+      values[identifier] = value;
+    }
+    else if (!heap.Empty())
+    {
+      const NodePairType top = heap.Top();
+      heap.Pop();
+
+      auto smallest = values.begin();
+      for (auto it = values.begin(); it != values.end(); ++it)
+      {
+        if (it->second < smallest->second)
+        {
+          smallest = it;
+        }
+      }
+      if (top.GetValue() != smallest->second || values[top.GetNode()] != top.GetValue())
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Popped the node " << top.GetNode() << " of value " << top.GetValue()
+                  << " instead of the node " << smallest->first << " of value " << smallest->second << std::endl;
+        return EXIT_FAILURE;
+      }
+      values.erase(top.GetNode());
+      if (heap.Contains(top.GetNode()))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "The node " << top.GetNode() << " is still in the heap after being popped." << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    if (heap.Size() != values.size())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The heap has " << heap.Size() << " elements instead of " << values.size() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  heap.Clear();
+  if (!heap.Empty() || heap.Contains(0))
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The heap is not empty after Clear()." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkFastMarchingTrialHeapTest(int, char *[])
+{
+  if (itkFastMarchingTrialHeapTestRun<2>() != EXIT_SUCCESS || itkFastMarchingTrialHeapTestRun<4>() != EXIT_SUCCESS ||
+      itkFastMarchingTrialHeapTestRun<7>() != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -21,6 +21,7 @@
 #include "itkInPlaceImageFilter.h"
 #include "itkNumericTraits.h"
 #include "itkVariableLengthVector.h"
+#include <type_traits>
 
 namespace itk
 {
@@ -45,6 +46,12 @@ namespace itk
  * Filters". J Math Imaging Vis 26, 293–299 (2006).
  * https://doi.org/10.1007/s10851-006-8464-z
  *
+ * When the pixels are scalars, blocks of adjacent lines are filtered
+ * together, with the values of the same position along the lines stored
+ * contiguously, so that the image is read and written with contiguous memory
+ * accesses whatever the direction, and the recursion is vectorized across
+ * the lines of a block.
+ *
  * \ingroup ImageFilters
  * \ingroup ITKImageFilterBase
  */
@@ -140,6 +147,19 @@ protected:
   void
   FilterDataArray(RealType * outs, const RealType * data, RealType * scratch, SizeValueType ln) const;
 
+  /** Number of lines filtered together by FilterDataBlock, so that a block
+   * of values of the same position along the lines fills a cache line. */
+  static constexpr unsigned int LineBlockSize = 64 / sizeof(RealType) > 1 ? 64 / sizeof(RealType) : 1;
+
+  /** Apply the Recursive Filter to a block of LineBlockSize lines of ln
+   * values each.  The lines are interleaved: value i of line k is at
+   * i * LineBlockSize + k in "outs", "data" and "scratch".  The recursion
+   * runs along the lines and is computed for all the lines of the block at
+   * once, which lets the compiler vectorize it across the lines. This
+   * method is used when RealType is a scalar type. */
+  void
+  FilterDataBlock(RealType * outs, const RealType * data, RealType * scratch, SizeValueType ln) const;
+
 protected:
   /** Causal coefficients that multiply the input data. */
   ScalarRealType m_N0;
@@ -252,6 +272,18 @@ protected:
   }
 
 private:
+  /** Filter the lines of the region by blocks of LineBlockSize adjacent
+   * lines, which are copied to and from interleaved buffers with contiguous
+   * memory accesses.  Returns false when the region cannot be filtered by
+   * blocks, in which case it is filtered line by line. */
+  bool
+  DynamicThreadedGenerateDataOnLineBlocks(const OutputImageRegionType & outputRegionForThread, std::true_type);
+  bool
+  DynamicThreadedGenerateDataOnLineBlocks(const OutputImageRegionType &, std::false_type)
+  {
+    return false;
+  }
+
   /** Direction in which the filter is to be applied
    * this should be in the range [0,ImageDimension-1]. */
   unsigned int m_Direction{ 0 };
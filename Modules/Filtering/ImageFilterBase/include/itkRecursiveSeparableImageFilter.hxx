@@ -21,6 +21,8 @@
 #include "itkObjectFactory.h"
 #include "itkImageLinearIteratorWithIndex.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -165,6 +167,118 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataArray(RealTy
   }
 }
 
+/**
+ * Apply Recursive Filter to a block of interleaved lines
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataBlock(RealType * const       outs,
+                                                                          const RealType * const data,
+                                                                          RealType * const       scratch,
+                                                                          const SizeValueType    ln) const
+{
+  constexpr unsigned int B = LineBlockSize;
+
+  /**
+   * Causal direction pass, with the same border initialization as FilterDataArray
+   */
+  for (unsigned int k = 0; k < B; ++k)
+  {
+    const RealType outV1 = data[k];
+
+    MathEMAMAMAM(outs[k], outV1, m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(outs[B + k], data[B + k], m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(outs[2 * B + k], data[2 * B + k], m_N0, data[B + k], m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(outs[3 * B + k], data[3 * B + k], m_N0, data[2 * B + k], m_N1, data[B + k], m_N2, outV1, m_N3);
+
+    MathSMAMAMAM(outs[k], outV1, m_BN1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(outs[B + k], outs[k], m_D1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(outs[2 * B + k], outs[B + k], m_D1, outs[k], m_D2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(outs[3 * B + k], outs[2 * B + k], m_D1, outs[B + k], m_D2, outs[k], m_D3, outV1, m_BN4);
+  }
+
+  for (SizeValueType i = 4; i < ln; ++i)
+  {
+    RealType * const       out0 = outs + i * B;
+    const RealType * const out1 = out0 - B;
+    const RealType * const out2 = out1 - B;
+    const RealType * const out3 = out2 - B;
+    const RealType * const out4 = out3 - B;
+    const RealType * const data0 = data + i * B;
+    const RealType * const data1 = data0 - B;
+    const RealType * const data2 = data1 - B;
+    const RealType * const data3 = data2 - B;
+    for (unsigned int k = 0; k < B; ++k)
+    {
+      MathEMAMAMAM(out0[k], data0[k], m_N0, data1[k], m_N1, data2[k], m_N2, data3[k], m_N3);
+      MathSMAMAMAM(out0[k], out1[k], m_D1, out2[k], m_D2, out3[k], m_D3, out4[k], m_D4);
+    }
+  }
+
+  /**
+   * AntiCausal direction pass
+   */
+  const SizeValueType last = (ln - 1) * B;
+  for (unsigned int k = 0; k < B; ++k)
+  {
+    const RealType outV2 = data[last + k];
+
+    MathEMAMAMAM(scratch[last + k], outV2, m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(scratch[last - B + k], data[last + k], m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(
+      scratch[last - 2 * B + k], data[last - B + k], m_M1, data[last + k], m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(scratch[last - 3 * B + k],
+                 data[last - 2 * B + k],
+                 m_M1,
+                 data[last - B + k],
+                 m_M2,
+                 data[last + k],
+                 m_M3,
+                 outV2,
+                 m_M4);
+
+    MathSMAMAMAM(scratch[last + k], outV2, m_BM1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(scratch[last - B + k], scratch[last + k], m_D1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(
+      scratch[last - 2 * B + k], scratch[last - B + k], m_D1, scratch[last + k], m_D2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(scratch[last - 3 * B + k],
+                 scratch[last - 2 * B + k],
+                 m_D1,
+                 scratch[last - B + k],
+                 m_D2,
+                 scratch[last + k],
+                 m_D3,
+                 outV2,
+                 m_BM4);
+  }
+
+  for (SizeValueType i = ln - 4; i > 0; --i)
+  {
+    RealType * const       out0 = scratch + (i - 1) * B;
+    const RealType * const out1 = out0 + B;
+    const RealType * const out2 = out1 + B;
+    const RealType * const out3 = out2 + B;
+    const RealType * const out4 = out3 + B;
+    const RealType * const data1 = data + i * B;
+    const RealType * const data2 = data1 + B;
+    const RealType * const data3 = data2 + B;
+    const RealType * const data4 = data3 + B;
+    for (unsigned int k = 0; k < B; ++k)
+    {
+      MathEMAMAMAM(out0[k], data1[k], m_M1, data2[k], m_M2, data3[k], m_M3, data4[k], m_M4);
+      MathSMAMAMAM(out0[k], out1[k], m_D1, out2[k], m_D2, out3[k], m_D3, out4[k], m_D4);
+    }
+  }
+
+  /**
+   * Roll the antiCausal part into the output
+   */
+  for (SizeValueType i = 0; i < ln * B; ++i)
+  {
+    outs[i] += scratch[i];
+  }
+}
+
 //
 // we need all of the image in just the "Direction" we are separated into
 //
@@ -271,6 +385,11 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerat
   typename TInputImage::ConstPointer inputImage(this->GetInputImage());
   typename TOutputImage::Pointer     outputImage(this->GetOutput());
 
+  if (this->DynamicThreadedGenerateDataOnLineBlocks(outputRegionForThread, std::is_arithmetic<RealType>{}))
+  {
+    return;
+  }
+
   RegionType region = outputRegionForThread;
 
   InputConstIteratorType inputIterator(inputImage, region);
@@ -311,6 +430,105 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerat
   }
 }
 
+/**
+ * Compute Recursive filter
+ * by blocks of adjacent lines
+ */
+template <typename TInputImage, typename TOutputImage>
+bool
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDataOnLineBlocks(
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  using OutputPixelType = typename TOutputImage::PixelType;
+
+  using InputConstIteratorType = ImageLinearConstIteratorWithIndex<TInputImage>;
+  using OutputIteratorType = ImageLinearIteratorWithIndex<TOutputImage>;
+
+  constexpr unsigned int B = LineBlockSize;
+  const unsigned int     direction = this->m_Direction;
+
+  // The lines of a block are adjacent along the first dimension, so that the
+  // values of the same position along the lines are contiguous in memory, or
+  // along the second dimension when filtering along the first dimension.
+  if (TOutputImage::ImageDimension < 2 || B < 2)
+  {
+    return false;
+  }
+  const unsigned int laneDimension = (direction == 0) ? 1 : 0;
+
+  // When filtering along the first dimension, each line is contiguous and
+  // corresponds to one line of the iterators. Otherwise, each line of the
+  // iterators holds the values of the same position along the lines.
+  const bool lineAlongIterator = (direction == 0);
+
+  typename TInputImage::ConstPointer inputImage(this->GetInputImage());
+  typename TOutputImage::Pointer     outputImage(this->GetOutput());
+
+  const SizeValueType ln = outputRegionForThread.GetSize(direction);
+  const SizeValueType numberOfLanes = outputRegionForThread.GetSize(laneDimension);
+
+  const auto inps = make_unique_for_overwrite<RealType[]>(ln * B);
+  const auto outs = make_unique_for_overwrite<RealType[]>(ln * B);
+  const auto scratch = make_unique_for_overwrite<RealType[]>(ln * B);
+
+  // The first pixel of each row of lines, along the lane dimension
+  OutputImageRegionType rowStartRegion = outputRegionForThread;
+  rowStartRegion.SetSize(direction, 1);
+  rowStartRegion.SetSize(laneDimension, 1);
+
+  ImageRegionConstIteratorWithIndex<TOutputImage> rowStartIterator(outputImage, rowStartRegion);
+  for (rowStartIterator.GoToBegin(); !rowStartIterator.IsAtEnd(); ++rowStartIterator)
+  {
+    for (SizeValueType firstLane = 0; firstLane < numberOfLanes; firstLane += B)
+    {
+      const SizeValueType lanes = std::min(static_cast<SizeValueType>(B), numberOfLanes - firstLane);
+
+      typename OutputImageRegionType::SizeType blockSize;
+      blockSize.Fill(1);
+      OutputImageRegionType blockRegion(rowStartIterator.GetIndex(), blockSize);
+      blockRegion.SetIndex(direction, outputRegionForThread.GetIndex(direction));
+      blockRegion.SetSize(direction, ln);
+      blockRegion.SetIndex(laneDimension, outputRegionForThread.GetIndex(laneDimension) + firstLane);
+      blockRegion.SetSize(laneDimension, lanes);
+
+      if (lanes < B)
+      {
+        std::fill_n(inps.get(), ln * B, RealType{});
+      }
+
+      InputConstIteratorType inputIterator(inputImage, blockRegion);
+      inputIterator.SetDirection(0);
+      SizeValueType line = 0;
+      for (inputIterator.GoToBegin(); !inputIterator.IsAtEnd(); inputIterator.NextLine(), ++line)
+      {
+        for (SizeValueType position = 0; !inputIterator.IsAtEndOfLine(); ++inputIterator, ++position)
+        {
+          const SizeValueType i = lineAlongIterator ? position : line;
+          const SizeValueType k = lineAlongIterator ? line : position;
+          inps[i * B + k] = inputIterator.Get();
+        }
+      }
+
+      this->FilterDataBlock(outs.get(), inps.get(), scratch.get(), ln);
+
+      OutputIteratorType outputIterator(outputImage, blockRegion);
+      outputIterator.SetDirection(0);
+      line = 0;
+      for (outputIterator.GoToBegin(); !outputIterator.IsAtEnd(); outputIterator.NextLine(), ++line)
+      {
+        for (SizeValueType position = 0; !outputIterator.IsAtEndOfLine(); ++outputIterator, ++position)
+        {
+          const SizeValueType i = lineAlongIterator ? position : line;
+          const SizeValueType k = lineAlongIterator ? line : position;
+          outputIterator.Set(static_cast<OutputPixelType>(outs[i * B + k]));
+        }
+      }
+    }
+  }
+  return true;
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 RecursiveSeparableImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
@@ -74,6 +74,13 @@ namespace itk
  * \warning For multithreading, the TransformPoint method of the
  * user-designated coordinate transform must be threadsafe.
  *
+ * For linear transforms, the input position of each output pixel is
+ * interpolated along the output scanlines. For displacement field and
+ * B-spline transforms, each output scanline is transformed at once with
+ * Transform::TransformPointsAlongLine(), which lets a displacement field
+ * sharing the output grid be read directly by index. The other transforms
+ * are called for every output pixel.
+ *
  * \ingroup GeometricTransform
  * \ingroup ITKImageGrid
  *
@@ -344,6 +351,13 @@ protected:
   virtual void
   LinearThreadedGenerateData(const OutputImageRegionType & outputRegionForThread);
 
+  /** Implementation for resampling with the transformation types defined on
+   *  a grid (displacement field and B-spline transforms). The points of each
+   *  output scanline are transformed at once, through
+   *  Transform::TransformPointsAlongLine(). */
+  virtual void
+  NonlinearScanlineThreadedGenerateData(const OutputImageRegionType & outputRegionForThread);
+
   /** Cast pixel from interpolator output to PixelType. */
   itkLegacyMacro(virtual PixelType CastPixelWithBoundsChecking(const InterpolatorOutputType value,
                                                                const ComponentType          minComponent,
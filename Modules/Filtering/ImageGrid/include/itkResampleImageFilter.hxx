@@ -236,6 +236,15 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
     return;
   }
 
+  // Transforms defined on a grid transform a whole scanline at once.
+  const auto transformCategory = this->GetTransform()->GetTransformCategory();
+  if (!isSpecialCoordinatesImage && (transformCategory == TransformType::TransformCategoryEnum::DisplacementField ||
+                                     transformCategory == TransformType::TransformCategoryEnum::BSpline))
+  {
+    this->NonlinearScanlineThreadedGenerateData(outputRegionForThread);
+    return;
+  }
+
   // Otherwise, we use the normal method where the transform is called
   // for computing the transformation of every point.
   this->NonlinearThreadedGenerateData(outputRegionForThread);
@@ -527,6 +536,74 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   }
 }
 
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  NonlinearScanlineThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  OutputImageType *      outputPtr = this->GetOutput();
+  const InputImageType * inputPtr = this->GetInput();
+  const TransformType *  transformPtr = this->GetTransform();
+
+  // Create an iterator that will walk the output region for this thread.
+  using OutputIterator = ImageScanlineIterator<TOutputImage>;
+  OutputIterator outIt(outputPtr, outputRegionForThread);
+
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  // Cache information from the superclass
+  PixelType defaultValue = this->GetDefaultPixelValue();
+
+  // Physical vector between consecutive pixels of an output scanline
+  typename TransformType::InputVectorType step;
+  for (unsigned int i = 0; i < OutputImageDimension; ++i)
+  {
+    step[i] = outputPtr->GetDirection()[i][0] * outputPtr->GetSpacing()[0];
+  }
+
+  const SizeValueType                                  lineLength = outputRegionForThread.GetSize(0);
+  std::vector<typename TransformType::OutputPointType> inputPoints(lineLength);
+  ContinuousInputIndexType                             inputIndex;
+
+  while (!outIt.IsAtEnd())
+  {
+    // Compute the input positions of the whole scan line
+    transformPtr->TransformPointsAlongLine(
+      outputPtr->template TransformIndexToPhysicalPoint<TTransformPrecisionType>(outIt.GetIndex()),
+      step,
+      lineLength,
+      inputPoints.data());
+
+    for (const auto & inputPoint : inputPoints)
+    {
+      inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+
+      // Evaluate input at right position and copy to the output
+      if (m_Interpolator->IsInsideBuffer(inputIndex))
+      {
+        outIt.Set(Self::CastPixelWithBoundsChecking(m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+      }
+      else
+      {
+        if (m_Extrapolator.IsNull())
+        {
+          outIt.Set(defaultValue); // default background value
+        }
+        else
+        {
+          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex)));
+        }
+      }
+      ++outIt;
+    }
+    outIt.NextLine();
+    progress.Completed(lineLength);
+  }
+}
+
 template <typename TInputImage,
           typename TOutputImage,
           typename TInterpolatorPrecisionType,
@@ -20,6 +20,8 @@
 #include "itkResampleImageFilter.h"
 
 #include "itkImage.h"
+#include "itkBSplineTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
 
 // Google Test header file:
 #include <gtest/gtest.h>
@@ -172,3 +174,52 @@ TEST(ResampleImageFilter, Expect_ResampleImageFilter_thows_on_incomplete_configu
 {
   Expect_ResampleImageFilter_thows_on_incomplete_configuration(128.0);
 }
+
+
+// Tests that resampling through a B-spline transform, which transforms each
+// output scanline at once, gives the same output as transforming each pixel.
+TEST(ResampleImageFilter, BSplineTransformScanlinesMatchTransformPoint)
+{
+  using ImageType = itk::Image<double>;
+  using FilterType = itk::ResampleImageFilter<ImageType, ImageType>;
+  using BSplineType = itk::BSplineTransform<double, 2, 3>;
+
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 32, 24 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(std::sin(0.3 * index[0]) + std::cos(0.2 * index[1]));
+  }
+
+  const auto bspline = BSplineType::New();
+  bspline->SetTransformDomainOrigin(itk::MakePoint(2.0, 3.0));
+  bspline->SetTransformDomainPhysicalDimensions(itk::MakeVector(24.0, 16.0));
+  bspline->SetTransformDomainMeshSize(itk::MakeSize(4, 3));
+  BSplineType::ParametersType parameters(bspline->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.Size(); ++i)
+  {
+    parameters[i] = 1.5 * std::sin(1.3 * i);
+  }
+  bspline->SetParameters(parameters);
+
+  const auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetTransform(bspline);
+  filter->SetSize(ImageType::SizeType{ { 40, 30 } });
+  filter->SetOutputSpacing(itk::MakeVector(0.8, 0.8));
+  filter->SetDefaultPixelValue(-5.0);
+  filter->Update();
+  const ImageType * output = filter->GetOutput();
+
+  const auto interpolator = FilterType::LinearInterpolatorType::New();
+  interpolator->SetInputImage(image);
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto point = bspline->TransformPoint(output->TransformIndexToPhysicalPoint<double>(it.GetIndex()));
+    const auto index = image->TransformPhysicalPointToContinuousIndex<double>(point);
+    const double expected = interpolator->IsInsideBuffer(index) ? interpolator->EvaluateAtContinuousIndex(index) : -5.0;
+    EXPECT_NEAR(it.Get(), expected, 1e-10) << "Output index " << it.GetIndex();
+  }
+}
@@ -0,0 +1,85 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBinaryDilateLabelMapFilter_h
+#define itkBinaryDilateLabelMapFilter_h
+
+#include "itkBinaryMorphologyLabelMapFilter.h"
+
+namespace itk
+{
+/**
+ * \class BinaryDilateLabelMapFilter
+ * \brief Dilate each object of a LabelMap, directly on its lines
+ *
+ * Each object is dilated with the structuring element given with SetKernel(),
+ * with the same convention as BinaryDilateImageFilter: the output is the
+ * Minkowski addition of the object and the structuring element. The pixels
+ * outside of the image are considered as background.
+ *
+ * \sa BinaryMorphologyLabelMapFilter, BinaryErodeLabelMapFilter, BinaryDilateImageFilter
+ * \ingroup ImageEnhancement  MathematicalMorphologyImageFilters
+ * \ingroup ITKLabelMap
+ */
+template <typename TImage, typename TKernel = FlatStructuringElement<TImage::ImageDimension>>
+class ITK_TEMPLATE_EXPORT BinaryDilateLabelMapFilter : public BinaryMorphologyLabelMapFilter<TImage, TKernel>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BinaryDilateLabelMapFilter);
+
+  /** Standard class type aliases. */
+  using Self = BinaryDilateLabelMapFilter;
+  using Superclass = BinaryMorphologyLabelMapFilter<TImage, TKernel>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Some convenient type alias. */
+  using typename Superclass::ImageType;
+  using typename Superclass::IndexType;
+  using typename Superclass::RegionType;
+  using typename Superclass::LabelObjectType;
+  using typename Superclass::KernelType;
+
+  /** ImageDimension constants */
+  static constexpr unsigned int ImageDimension = TImage::ImageDimension;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(BinaryDilateLabelMapFilter, BinaryMorphologyLabelMapFilter);
+
+protected:
+  BinaryDilateLabelMapFilter() = default;
+  ~BinaryDilateLabelMapFilter() override = default;
+
+  using typename Superclass::RunType;
+  using typename Superclass::RunsType;
+  using typename Superclass::LineMapType;
+  using typename Superclass::KernelLineType;
+
+  void
+  ThreadedProcessLabelObject(LabelObjectType * labelObject) override;
+}; // end of class
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBinaryDilateLabelMapFilter.hxx"
+#endif
+
+#endif
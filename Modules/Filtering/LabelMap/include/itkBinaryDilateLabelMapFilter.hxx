@@ -0,0 +1,73 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBinaryDilateLabelMapFilter_hxx
+#define itkBinaryDilateLabelMapFilter_hxx
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TImage, typename TKernel>
+void
+BinaryDilateLabelMapFilter<TImage, TKernel>::ThreadedProcessLabelObject(LabelObjectType * labelObject)
+{
+  const RegionType &   region = this->GetOutput()->GetLargestPossibleRegion();
+  const IndexValueType firstX = region.GetIndex(0);
+  const IndexValueType lastX = firstX + static_cast<IndexValueType>(region.GetSize(0)) - 1;
+
+  const LineMapType lines = Superclass::MakeLineMap(labelObject);
+
+  // Each line of the kernel moves the runs of each line of the object to
+  // another line, and stretches them by its own runs
+  LineMapType dilatedLines;
+  for (const auto & line : lines)
+  {
+    for (const KernelLineType & kernelLine : this->GetKernelLines())
+    {
+      IndexType dilatedIndex = line.first + kernelLine.offset;
+      dilatedIndex[0] = firstX;
+      if (!region.IsInside(dilatedIndex))
+      {
+        continue;
+      }
+      RunsType & dilatedRuns = dilatedLines[dilatedIndex];
+      for (const RunType & run : line.second)
+      {
+        for (const RunType & kernelRun : kernelLine.runs)
+        {
+          const IndexValueType first = std::max(run.first + kernelRun.first, firstX);
+          const IndexValueType last = std::min(run.second + kernelRun.second, lastX);
+          if (first <= last)
+          {
+            dilatedRuns.emplace_back(first, last);
+          }
+        }
+      }
+    }
+  }
+
+  for (auto & dilatedLine : dilatedLines)
+  {
+    Superclass::MergeRuns(dilatedLine.second);
+  }
+  this->SetLabelObjectLines(labelObject, dilatedLines);
+}
+
+} // end namespace itk
+#endif
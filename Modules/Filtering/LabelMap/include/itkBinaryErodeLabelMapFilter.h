@@ -0,0 +1,115 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBinaryErodeLabelMapFilter_h
+#define itkBinaryErodeLabelMapFilter_h
+
+#include "itkBinaryMorphologyLabelMapFilter.h"
+
+namespace itk
+{
+/**
+ * \class BinaryErodeLabelMapFilter
+ * \brief Erode each object of a LabelMap, directly on its lines
+ *
+ * Each object is eroded with the structuring element given with SetKernel(),
+ * with the same convention as BinaryErodeImageFilter: a pixel is kept when
+ * all the pixels covered by the symmetric of the structuring element centered
+ * on it are in the object. The objects which are completely eroded are
+ * removed from the LabelMap.
+ *
+ * BoundaryToForeground controls whether the pixels outside of the image are
+ * considered as in the object. It is true by default, as in
+ * BinaryErodeImageFilter.
+ *
+ * \sa BinaryMorphologyLabelMapFilter, BinaryDilateLabelMapFilter, BinaryErodeImageFilter
+ * \ingroup ImageEnhancement  MathematicalMorphologyImageFilters
+ * \ingroup ITKLabelMap
+ */
+template <typename TImage, typename TKernel = FlatStructuringElement<TImage::ImageDimension>>
+class ITK_TEMPLATE_EXPORT BinaryErodeLabelMapFilter : public BinaryMorphologyLabelMapFilter<TImage, TKernel>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BinaryErodeLabelMapFilter);
+
+  /** Standard class type aliases. */
+  using Self = BinaryErodeLabelMapFilter;
+  using Superclass = BinaryMorphologyLabelMapFilter<TImage, TKernel>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Some convenient type alias. */
+  using typename Superclass::ImageType;
+  using typename Superclass::IndexType;
+  using typename Superclass::OffsetType;
+  using typename Superclass::RegionType;
+  using typename Superclass::LabelObjectType;
+  using typename Superclass::KernelType;
+
+  /** ImageDimension constants */
+  static constexpr unsigned int ImageDimension = TImage::ImageDimension;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(BinaryErodeLabelMapFilter, BinaryMorphologyLabelMapFilter);
+
+  /** Set/Get whether the pixels outside of the image are considered as in
+   * the objects. Defaults to true. */
+  itkSetMacro(BoundaryToForeground, bool);
+  itkGetConstReferenceMacro(BoundaryToForeground, bool);
+  itkBooleanMacro(BoundaryToForeground);
+
+protected:
+  BinaryErodeLabelMapFilter() = default;
+  ~BinaryErodeLabelMapFilter() override = default;
+
+  using typename Superclass::RunType;
+  using typename Superclass::RunsType;
+  using typename Superclass::LineMapType;
+  using typename Superclass::KernelLineType;
+
+  void
+  BeforeThreadedGenerateData() override;
+
+  void
+  ThreadedProcessLabelObject(LabelObjectType * labelObject) override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Intersect two lists of sorted and disjoint runs. */
+  static RunsType
+  IntersectRuns(const RunsType & runs1, const RunsType & runs2);
+
+  bool m_BoundaryToForeground{ true };
+
+  /** The lines of the image for which all the lines of the kernel are outside
+   * of the image. They are in all the eroded objects when the boundary is in
+   * the objects. */
+  std::vector<IndexType> m_BoundaryLines;
+}; // end of class
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBinaryErodeLabelMapFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,226 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBinaryErodeLabelMapFilter_hxx
+#define itkBinaryErodeLabelMapFilter_hxx
+
+#include "itkIndexRange.h"
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+namespace itk
+{
+
+template <typename TImage, typename TKernel>
+void
+BinaryErodeLabelMapFilter<TImage, TKernel>::BeforeThreadedGenerateData()
+{
+  Superclass::BeforeThreadedGenerateData();
+
+  // Only a kernel without a center line can have all its lines outside of
+  // the image while it is centered on a line of the image
+  m_BoundaryLines.clear();
+  const auto & kernelLines = this->GetKernelLines();
+  const bool   hasCenterLine =
+    std::any_of(kernelLines.begin(), kernelLines.end(), [](const KernelLineType & kernelLine) {
+      return kernelLine.offset == OffsetType{};
+    });
+  if (!m_BoundaryToForeground || kernelLines.empty() || hasCenterLine)
+  {
+    return;
+  }
+
+  const RegionType & region = this->GetOutput()->GetLargestPossibleRegion();
+  RegionType         lineRegion = region;
+  lineRegion.SetSize(0, 1);
+  for (const IndexType & lineIndex : ImageRegionIndexRange<ImageDimension>(lineRegion))
+  {
+    if (std::none_of(kernelLines.begin(), kernelLines.end(), [&](const KernelLineType & kernelLine) {
+          return region.IsInside(lineIndex - kernelLine.offset);
+        }))
+    {
+      m_BoundaryLines.push_back(lineIndex);
+    }
+  }
+}
+
+template <typename TImage, typename TKernel>
+void
+BinaryErodeLabelMapFilter<TImage, TKernel>::ThreadedProcessLabelObject(LabelObjectType * labelObject)
+{
+  const auto & kernelLines = this->GetKernelLines();
+  if (kernelLines.empty())
+  {
+    return;
+  }
+
+  const RegionType &   region = this->GetOutput()->GetLargestPossibleRegion();
+  const IndexValueType firstX = region.GetIndex(0);
+  const IndexValueType lastX = firstX + static_cast<IndexValueType>(region.GetSize(0)) - 1;
+
+  LineMapType lines = Superclass::MakeLineMap(labelObject);
+
+  // The runs which touch the sides of the image are extended beyond them by
+  // the width of the kernel, which is enough to make them behave as if they
+  // were infinite
+  if (m_BoundaryToForeground)
+  {
+    const auto margin = static_cast<IndexValueType>(this->GetKernel().GetSize(0));
+    for (auto & line : lines)
+    {
+      if (line.second.front().first == firstX)
+      {
+        line.second.front().first -= margin;
+      }
+      if (line.second.back().second == lastX)
+      {
+        line.second.back().second += margin;
+      }
+    }
+  }
+
+  // An output line needs a line of the object under each line of the kernel,
+  // unless that line is outside of the image and the boundary is in the
+  // objects. The candidate output lines are the lines of the object moved by
+  // the center line of the kernel, when it has one. Otherwise, they are moved
+  // by the first line of the kernel, or by all of them when that line may be
+  // outside of the image.
+  auto firstCandidateLine = kernelLines.begin();
+  auto endCandidateLine = kernelLines.end();
+  const auto centerLine = std::find_if(kernelLines.begin(), kernelLines.end(), [](const KernelLineType & kernelLine) {
+    return kernelLine.offset == OffsetType{};
+  });
+  if (centerLine != kernelLines.end())
+  {
+    firstCandidateLine = centerLine;
+    endCandidateLine = std::next(centerLine);
+  }
+  else if (!m_BoundaryToForeground)
+  {
+    endCandidateLine = std::next(firstCandidateLine);
+  }
+
+  std::set<IndexType, typename Superclass::LineIndexCompare> candidateIndices;
+  for (const auto & line : lines)
+  {
+    for (auto kernelLine = firstCandidateLine; kernelLine != endCandidateLine; ++kernelLine)
+    {
+      IndexType candidateIndex = line.first + kernelLine->offset;
+      candidateIndex[0] = firstX;
+      if (region.IsInside(candidateIndex))
+      {
+        candidateIndices.insert(candidateIndex);
+      }
+    }
+  }
+
+  LineMapType erodedLines;
+  for (const IndexType & boundaryIndex : m_BoundaryLines)
+  {
+    erodedLines[boundaryIndex].emplace_back(firstX, lastX);
+  }
+  for (const IndexType & candidateIndex : candidateIndices)
+  {
+    RunsType eroded{ RunType(firstX, lastX) };
+    for (const KernelLineType & kernelLine : kernelLines)
+    {
+      const IndexType lineIndex = candidateIndex - kernelLine.offset;
+      if (!region.IsInside(lineIndex))
+      {
+        if (m_BoundaryToForeground)
+        {
+          continue;
+        }
+        eroded.clear();
+        break;
+      }
+      const auto line = lines.find(lineIndex);
+      if (line == lines.end())
+      {
+        eroded.clear();
+        break;
+      }
+      // the positions where a run of the kernel fits in a run of the line
+      for (const RunType & kernelRun : kernelLine.runs)
+      {
+        RunsType allowed;
+        for (const RunType & run : line->second)
+        {
+          if (run.second - run.first >= kernelRun.second - kernelRun.first)
+          {
+            allowed.emplace_back(run.first + kernelRun.second, run.second + kernelRun.first);
+          }
+        }
+        eroded = IntersectRuns(eroded, allowed);
+        if (eroded.empty())
+        {
+          break;
+        }
+      }
+      if (eroded.empty())
+      {
+        break;
+      }
+    }
+    if (!eroded.empty())
+    {
+      erodedLines.emplace(candidateIndex, std::move(eroded));
+    }
+  }
+
+  this->SetLabelObjectLines(labelObject, erodedLines);
+}
+
+template <typename TImage, typename TKernel>
+auto
+BinaryErodeLabelMapFilter<TImage, TKernel>::IntersectRuns(const RunsType & runs1, const RunsType & runs2) -> RunsType
+{
+  RunsType intersection;
+  auto     it1 = runs1.begin();
+  auto     it2 = runs2.begin();
+  while (it1 != runs1.end() && it2 != runs2.end())
+  {
+    const IndexValueType first = std::max(it1->first, it2->first);
+    const IndexValueType last = std::min(it1->second, it2->second);
+    if (first <= last)
+    {
+      intersection.emplace_back(first, last);
+    }
+    // move forward the run which ends first
+    if (it1->second < it2->second)
+    {
+      ++it1;
+    }
+    else
+    {
+      ++it2;
+    }
+  }
+  return intersection;
+}
+
+template <typename TImage, typename TKernel>
+void
+BinaryErodeLabelMapFilter<TImage, TKernel>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "BoundaryToForeground: " << m_BoundaryToForeground << std::endl;
+}
+
+} // end namespace itk
+#endif
@@ -0,0 +1,171 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBinaryMorphologyLabelMapFilter_h
+#define itkBinaryMorphologyLabelMapFilter_h
+
+#include "itkInPlaceLabelMapFilter.h"
+#include "itkFlatStructuringElement.h"
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class BinaryMorphologyLabelMapFilter
+ * \brief Base class for the binary morphology of the objects of a LabelMap, computed on their lines
+ *
+ * A LabelMap stores each of its objects as a run-length encoded binary image:
+ * the LabelObjectLine of an object are the runs of its pixels along the
+ * first axis. The subclasses of this filter dilate or erode each object
+ * directly on these runs, without converting the object to an image, so that
+ * the cost of the operation depends on the number of runs of the objects and
+ * of the structuring element rather than on the number of pixels of the image.
+ * A binary mask is processed as a LabelMap with a single object, as produced
+ * by LabelImageToLabelMapFilter, and converted back to an image with
+ * LabelMapToBinaryImageFilter.
+ *
+ * The objects are processed independently from each other, and may overlap
+ * after a dilation. The objects which become empty are removed from the
+ * LabelMap. The results are clipped to the largest possible region of the
+ * LabelMap.
+ *
+ * The structuring element is given with SetKernel(). Only its elements with
+ * a value greater than zero are used, as in BinaryMorphologyImageFilter. The
+ * default kernel is a box of radius 1.
+ *
+ * \sa BinaryDilateLabelMapFilter, BinaryErodeLabelMapFilter, BinaryMorphologyImageFilter, ObjectByObjectLabelMapFilter
+ * \ingroup ImageEnhancement  MathematicalMorphologyImageFilters
+ * \ingroup ITKLabelMap
+ */
+template <typename TImage, typename TKernel = FlatStructuringElement<TImage::ImageDimension>>
+class ITK_TEMPLATE_EXPORT BinaryMorphologyLabelMapFilter : public InPlaceLabelMapFilter<TImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BinaryMorphologyLabelMapFilter);
+
+  /** Standard class type aliases. */
+  using Self = BinaryMorphologyLabelMapFilter;
+  using Superclass = InPlaceLabelMapFilter<TImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Some convenient type alias. */
+  using ImageType = TImage;
+  using ImagePointer = typename ImageType::Pointer;
+  using ImageConstPointer = typename ImageType::ConstPointer;
+  using PixelType = typename ImageType::PixelType;
+  using IndexType = typename ImageType::IndexType;
+  using OffsetType = typename ImageType::OffsetType;
+  using RegionType = typename ImageType::RegionType;
+  using LabelObjectType = typename ImageType::LabelObjectType;
+
+  using KernelType = TKernel;
+  using KernelPixelType = typename KernelType::PixelType;
+
+  /** ImageDimension constants */
+  static constexpr unsigned int ImageDimension = TImage::ImageDimension;
+
+  /** Runtime information support. */
+  itkTypeMacro(BinaryMorphologyLabelMapFilter, InPlaceLabelMapFilter);
+
+  /** Set/Get the structuring element. */
+  itkSetMacro(Kernel, KernelType);
+  itkGetConstReferenceMacro(Kernel, KernelType);
+
+protected:
+  BinaryMorphologyLabelMapFilter();
+  ~BinaryMorphologyLabelMapFilter() override = default;
+
+  /** A run of pixels along the first axis, given by the indices of its first
+   * and last pixels. */
+  using RunType = std::pair<IndexValueType, IndexValueType>;
+  using RunsType = std::vector<RunType>;
+
+  /** Order the line indices on all the axes but the first one, like
+   * LabelObjectLineComparator. */
+  struct LineIndexCompare
+  {
+    bool
+    operator()(const IndexType & a, const IndexType & b) const
+    {
+      for (int i = ImageDimension - 1; i > 0; --i)
+      {
+        if (a[i] != b[i])
+        {
+          return a[i] < b[i];
+        }
+      }
+      return false;
+    }
+  };
+
+  /** The sorted and disjoint runs of each line of an object. The first
+   * component of the keys is not used. */
+  using LineMapType = std::map<IndexType, RunsType, LineIndexCompare>;
+
+  /** The runs of the elements of the structuring element on a line, with the
+   * offset of that line from the center of the kernel. The first component of
+   * the offset is zero, and the runs are relative to the center. */
+  struct KernelLineType
+  {
+    OffsetType offset;
+    RunsType   runs;
+  };
+  using KernelLinesType = std::vector<KernelLineType>;
+
+  /** Decompose the kernel in lines before processing the objects. */
+  void
+  BeforeThreadedGenerateData() override;
+
+  /** Get the lines of the kernel computed in BeforeThreadedGenerateData(). */
+  const KernelLinesType &
+  GetKernelLines() const
+  {
+    return m_KernelLines;
+  }
+
+  /** Build the line map of an object. */
+  static LineMapType
+  MakeLineMap(const LabelObjectType * labelObject);
+
+  /** Sort the runs and merge the runs which overlap or touch. */
+  static void
+  MergeRuns(RunsType & runs);
+
+  /** Replace the lines of an object with the lines of a line map, and remove
+   * the object from the output if the line map is empty. This method may be
+   * called from several threads. */
+  void
+  SetLabelObjectLines(LabelObjectType * labelObject, const LineMapType & lines);
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  KernelType      m_Kernel;
+  KernelLinesType m_KernelLines;
+}; // end of class
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBinaryMorphologyLabelMapFilter.hxx"
+#endif
+
+#endif
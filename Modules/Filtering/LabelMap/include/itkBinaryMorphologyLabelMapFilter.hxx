@@ -0,0 +1,150 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBinaryMorphologyLabelMapFilter_hxx
+#define itkBinaryMorphologyLabelMapFilter_hxx
+
+#include <algorithm>
+#include <iterator>
+
+namespace itk
+{
+
+template <typename TImage, typename TKernel>
+BinaryMorphologyLabelMapFilter<TImage, TKernel>::BinaryMorphologyLabelMapFilter()
+{
+  // a box of radius 1, as in KernelImageFilter
+  m_Kernel.SetRadius(1);
+  for (auto kit = m_Kernel.Begin(); kit != m_Kernel.End(); ++kit)
+  {
+    *kit = 1;
+  }
+}
+
+template <typename TImage, typename TKernel>
+void
+BinaryMorphologyLabelMapFilter<TImage, TKernel>::BeforeThreadedGenerateData()
+{
+  Superclass::BeforeThreadedGenerateData();
+
+  // the elements of the kernel are stored with the first axis varying the
+  // fastest, so each row of the kernel is a line
+  m_KernelLines.clear();
+  const SizeValueType rowLength = m_Kernel.GetSize(0);
+  for (SizeValueType rowStart = 0; rowStart < m_Kernel.Size(); rowStart += rowLength)
+  {
+    KernelLineType kernelLine;
+    kernelLine.offset = m_Kernel.GetOffset(rowStart);
+    kernelLine.offset[0] = 0;
+    for (SizeValueType i = rowStart; i < rowStart + rowLength; ++i)
+    {
+      if (m_Kernel[i] > NumericTraits<KernelPixelType>::ZeroValue())
+      {
+        const IndexValueType x = m_Kernel.GetOffset(i)[0];
+        if (!kernelLine.runs.empty() && kernelLine.runs.back().second == x - 1)
+        {
+          kernelLine.runs.back().second = x;
+        }
+        else
+        {
+          kernelLine.runs.emplace_back(x, x);
+        }
+      }
+    }
+    if (!kernelLine.runs.empty())
+    {
+      m_KernelLines.push_back(std::move(kernelLine));
+    }
+  }
+}
+
+template <typename TImage, typename TKernel>
+auto
+BinaryMorphologyLabelMapFilter<TImage, TKernel>::MakeLineMap(const LabelObjectType * labelObject) -> LineMapType
+{
+  LineMapType lines;
+  for (typename LabelObjectType::ConstLineIterator lit(labelObject); !lit.IsAtEnd(); ++lit)
+  {
+    const IndexType & idx = lit.GetLine().GetIndex();
+    const auto        length = static_cast<IndexValueType>(lit.GetLine().GetLength());
+    lines[idx].emplace_back(idx[0], idx[0] + length - 1);
+  }
+  for (auto & line : lines)
+  {
+    MergeRuns(line.second);
+  }
+  return lines;
+}
+
+template <typename TImage, typename TKernel>
+void
+BinaryMorphologyLabelMapFilter<TImage, TKernel>::MergeRuns(RunsType & runs)
+{
+  if (runs.empty())
+  {
+    return;
+  }
+  std::sort(runs.begin(), runs.end());
+  auto last = runs.begin();
+  for (auto it = std::next(runs.begin()); it != runs.end(); ++it)
+  {
+    if (it->first <= last->second + 1)
+    {
+      last->second = std::max(last->second, it->second);
+    }
+    else
+    {
+      *++last = *it;
+    }
+  }
+  runs.erase(std::next(last), runs.end());
+}
+
+template <typename TImage, typename TKernel>
+void
+BinaryMorphologyLabelMapFilter<TImage, TKernel>::SetLabelObjectLines(LabelObjectType *   labelObject,
+                                                                     const LineMapType & lines)
+{
+  labelObject->Clear();
+  for (const auto & line : lines)
+  {
+    IndexType idx = line.first;
+    for (const RunType & run : line.second)
+    {
+      idx[0] = run.first;
+      labelObject->AddLine(idx, static_cast<SizeValueType>(run.second - run.first + 1));
+    }
+  }
+
+  // remove the object if it is empty
+  if (labelObject->Empty())
+  {
+    std::lock_guard<std::mutex> mutexHolder(this->m_LabelObjectContainerLock);
+    this->GetOutput()->RemoveLabelObject(labelObject);
+  }
+}
+
+template <typename TImage, typename TKernel>
+void
+BinaryMorphologyLabelMapFilter<TImage, TKernel>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Kernel: " << m_Kernel << std::endl;
+}
+
+} // end namespace itk
+#endif
@@ -29,7 +29,9 @@
 #define itkLabelMapFilter_h
 
 #include "itkImageToImageFilter.h"
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 namespace itk
 {
@@ -43,6 +45,12 @@ namespace itk
  * With that class, the developer doesn't need to take care of iterating over all the objects in
  * the image, or to manage by hand the threads.
  *
+ * The label objects are collected in an array before the threaded
+ * processing, and the threads claim them by chunks of consecutive objects
+ * without locking, so that many small objects are dispatched efficiently.
+ * With several work units, the objects are processed by decreasing number of
+ * lines, and the largest ones are claimed one at a time, to balance the work.
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
@@ -135,7 +143,15 @@ protected:
   std::mutex m_LabelObjectContainerLock;
 
 private:
-  typename InputImageType::Iterator m_LabelObjectIterator;
+  /** The label objects to process, collected before the threaded
+   * processing. The work units claim the m_NumberOfLargeLabelObjects first
+   * objects one at a time, and the others by chunks of
+   * m_LabelObjectChunkSize consecutive objects, by incrementing
+   * m_NextLabelObject. */
+  std::vector<LabelObjectType *> m_LabelObjects;
+  std::atomic<SizeValueType>     m_NextLabelObject{ 0 };
+  SizeValueType                  m_LabelObjectChunkSize{ 1 };
+  SizeValueType                  m_NumberOfLargeLabelObjects{ 0 };
 };
 } // end namespace itk
 
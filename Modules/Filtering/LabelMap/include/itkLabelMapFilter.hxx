@@ -28,6 +28,7 @@
 #ifndef itkLabelMapFilter_hxx
 #define itkLabelMapFilter_hxx
 #include <mutex>
+#include <algorithm>
 #include "itkTotalProgressReporter.h"
 
 namespace itk
@@ -68,13 +69,52 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelMapFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
 {
-  m_LabelObjectIterator = typename InputImageType::Iterator(this->GetLabelMap());
+  InputImageType * labelMap = this->GetLabelMap();
+
+  m_LabelObjects.clear();
+  m_LabelObjects.reserve(labelMap->GetNumberOfLabelObjects());
+  for (typename InputImageType::Iterator it(labelMap); !it.IsAtEnd(); ++it)
+  {
+    m_LabelObjects.push_back(it.GetLabelObject());
+  }
+
+  // Small chunks keep the work balanced when a few objects are much larger
+  // than the others, while avoiding contention on the shared counter
+  const SizeValueType numberOfWorkUnits = std::max(this->GetNumberOfWorkUnits(), ThreadIdType{ 1 });
+  m_LabelObjectChunkSize =
+    std::max(SizeValueType{ 1 }, std::min(SizeValueType{ 64 }, m_LabelObjects.size() / (16 * numberOfWorkUnits)));
+  m_NumberOfLargeLabelObjects = 0;
+  m_NextLabelObject = 0;
+
+  if (numberOfWorkUnits > 1 && m_LabelObjects.size() > 1)
+  {
+    // Process the largest objects first, and one at a time, so that they are
+    // spread over the work units and do not delay the end of the processing.
+    // An object is large when it has more lines than an average chunk.
+    std::stable_sort(
+      m_LabelObjects.begin(), m_LabelObjects.end(), [](const LabelObjectType * a, const LabelObjectType * b) {
+        return a->GetNumberOfLines() > b->GetNumberOfLines();
+      });
+    SizeValueType numberOfLines = 0;
+    for (const LabelObjectType * labelObject : m_LabelObjects)
+    {
+      numberOfLines += labelObject->GetNumberOfLines();
+    }
+    const SizeValueType largeNumberOfLines = m_LabelObjectChunkSize * numberOfLines / m_LabelObjects.size();
+    while (m_NumberOfLargeLabelObjects < m_LabelObjects.size() &&
+           m_LabelObjects[m_NumberOfLargeLabelObjects]->GetNumberOfLines() > largeNumberOfLines)
+    {
+      ++m_NumberOfLargeLabelObjects;
+    }
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
 LabelMapFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData()
 {
+  m_LabelObjects.clear();
+  m_LabelObjects.shrink_to_fit();
   this->UpdateProgress(1.0);
 }
 
@@ -82,37 +122,29 @@ template <typename TInputImage, typename TOutputImage>
 void
 LabelMapFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(const OutputImageRegionType &)
 {
-  const auto            numberOfLabelObjects = this->GetLabelMap()->GetNumberOfLabelObjects();
+  const auto            numberOfLabelObjects = static_cast<SizeValueType>(m_LabelObjects.size());
   TotalProgressReporter progress(this, numberOfLabelObjects, numberOfLabelObjects);
   while (true)
   {
-    LabelObjectType * labelObject;
-    // begin mutex lock
+    // claim the next large object, or the next chunk of objects
+    SizeValueType begin = m_NextLabelObject.load();
+    SizeValueType end;
+    do
     {
-      std::lock_guard<std::mutex> lock(m_LabelObjectContainerLock);
-
-      if (m_LabelObjectIterator.IsAtEnd())
+      if (begin >= numberOfLabelObjects)
       {
-        // mutex lock holder deleted
         return;
       }
+      end = std::min(begin + (begin < m_NumberOfLargeLabelObjects ? 1 : m_LabelObjectChunkSize), numberOfLabelObjects);
+    } while (!m_NextLabelObject.compare_exchange_weak(begin, end));
 
-      // get the label object
-      labelObject = m_LabelObjectIterator.GetLabelObject();
-
-      // increment the iterator now, so it will not be invalidated if the object
-      // is destroyed
-      ++m_LabelObjectIterator;
+    for (SizeValueType i = begin; i < end; ++i)
+    {
+      // and run the user defined method for that object
+      this->ThreadedProcessLabelObject(m_LabelObjects[i]);
 
-      // unlock the mutex, so the other threads can get an object
+      progress.CompletedPixel();
     }
-    // end mutex lock
-
-
-    // and run the user defined method for that object
-    this->ThreadedProcessLabelObject(labelObject);
-
-    progress.CompletedPixel();
   }
 }
 
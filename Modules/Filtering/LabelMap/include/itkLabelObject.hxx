@@ -305,9 +305,11 @@ LabelObject<TLabel, VImageDimension>::Optimize()
 {
   if (!m_LineContainer.empty())
   {
-    // first copy the lines in another container and clear the current one
-    LineContainerType lineContainer = m_LineContainer;
-    m_LineContainer.clear();
+    // first move the lines to another container, and keep the storage for
+    // the optimized lines
+    LineContainerType lineContainer;
+    lineContainer.swap(m_LineContainer);
+    m_LineContainer.reserve(lineContainer.size());
 
     // reorder the lines
     typename Functor::LabelObjectLineComparator<LineType> comparator;
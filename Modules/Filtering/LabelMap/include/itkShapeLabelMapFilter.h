@@ -30,15 +30,17 @@ namespace itk
  * ShapeLabelMapFilter can be used to set the attributes values of the
  * ShapeLabelObject in a LabelMap.
  *
- * ShapeLabelMapFilter takes an optional parameter, used only to
- * optimize the computation time and the memory usage when the
- * perimeter or the feret diameter is used: the exact copy of the
- * input LabelMap is stored in an Image.
- * It can be set with SetLabelImage(). It is cleared at the end of the
- * computation, so must be reset before running Update() again. It is
- * not part of the pipeline management design, to let the subclasses
- * of ShapeLabelMapFilter use the pipeline design to specify truly
- * required inputs.
+ * The attributes are computed from the lines of each object, and the
+ * objects are processed concurrently. The perimeter, the Feret diameter and
+ * the oriented bounding box are the most expensive attributes, and can each
+ * be disabled. The Feret diameter is computed between the pixels which may
+ * be vertices of the convex hull of the object: the first and last pixels of
+ * the rows which are vertices of the convex hulls of the planar sections of
+ * the object.
+ *
+ * SetLabelImage() is kept for backward compatibility: the label image is no
+ * longer needed to compute the Feret diameter. It is cleared at the end of the
+ * computation.
  *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
@@ -101,7 +103,7 @@ public:
 
   /**
    * Set/Get whether the maximum Feret diameter should be computed or not.
-   * Default value is false because of the high computation time required.
+   * Default value is false.
    */
   itkSetMacro(ComputeFeretDiameter, bool);
   itkGetConstReferenceMacro(ComputeFeretDiameter, bool);
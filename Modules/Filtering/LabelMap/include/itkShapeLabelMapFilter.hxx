@@ -22,6 +22,7 @@
 #include "itkConstNeighborhoodIterator.h"
 #include "itkConstShapedNeighborhoodIterator.h"
 #include "itkLabelMapToLabelImageFilter.h"
+#include "itkLabelObjectLineComparator.h"
 #include "itkConstantBoundaryCondition.h"
 #include "itkGeometryUtilities.h"
 #include "itkConnectedComponentAlgorithm.h"
@@ -29,8 +30,11 @@
 #include "vnl/algo/vnl_symmetric_eigensystem.h"
 #include "itkMath.h"
 #include "itkLexicographicCompare.h"
+#include <algorithm>
 #include <deque>
 #include <map>
+#include <numeric>
+#include <vector>
 
 namespace itk
 {
@@ -47,22 +51,6 @@ void
 ShapeLabelMapFilter<TImage, TLabelImage>::BeforeThreadedGenerateData()
 {
   Superclass::BeforeThreadedGenerateData();
-
-  // Generate the label image, if needed
-  if (m_ComputeFeretDiameter)
-  {
-    if (!m_LabelImage)
-    {
-      // generate an image of the labelized image
-      using LCI2IType = LabelMapToLabelImageFilter<TImage, LabelImageType>;
-      auto lci2i = LCI2IType::New();
-      lci2i->SetInput(this->GetOutput());
-      // Respect the number of threads of the filter
-      lci2i->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-      lci2i->Update();
-      m_LabelImage = lci2i->GetOutput();
-    }
-  }
 }
 
 template <typename TImage, typename TLabelImage>
@@ -429,40 +417,141 @@ template <typename TImage, typename TLabelImage>
 void
 ShapeLabelMapFilter<TImage, TLabelImage>::ComputeFeretDiameter(LabelObjectType * labelObject)
 {
-  const LabelPixelType & label = labelObject->GetLabel();
-
-  using IndexListType = typename std::deque<IndexType>;
-  IndexListType idxList;
-
-  using NeighborIteratorType = typename itk::ConstNeighborhoodIterator<LabelImageType>;
-  SizeType neighborHoodRadius;
-  neighborHoodRadius.Fill(1);
-  NeighborIteratorType                      it(neighborHoodRadius, m_LabelImage, m_LabelImage->GetBufferedRegion());
-  ConstantBoundaryCondition<LabelImageType> lcbc;
-  // Use label + 1 to have a label different of the current label on the border
-  lcbc.SetConstant(label + 1);
-  it.OverrideBoundaryCondition(&lcbc);
-  it.GoToBegin();
-
-  using NeighborIndexType = typename NeighborIteratorType::NeighborIndexType;
-
-  // Iterate over all the indexes
-  typename LabelObjectType::ConstIndexIterator iit(labelObject);
-  while (!iit.IsAtEnd())
+  // The largest distance between two pixels of the object is reached between
+  // two vertices of the convex hull of the object. A vertex of the convex hull
+  // is the first or the last pixel of its row along the dimension 0, and is a
+  // vertex of the convex hull of the pixels of each plane (0, d) it belongs to.
+  // The candidate pixels are selected with these two criteria, and only the
+  // candidate pairs are compared.
+  using LineType = typename LabelObjectType::LineType;
+
+  std::vector<LineType> lines;
+  lines.reserve(labelObject->GetNumberOfLines());
+  for (typename LabelObjectType::ConstLineIterator lit(labelObject); !lit.IsAtEnd(); ++lit)
   {
-    // Move the iterator to the new location
-    it += iit.GetIndex() - it.GetIndex();
+    lines.push_back(lit.GetLine());
+  }
+  std::sort(lines.begin(), lines.end(), Functor::LabelObjectLineComparator<LineType>());
 
-    // Push the pixel in the list if it is on the border of the object
-    for (NeighborIndexType i = 0; i < it.Size(); ++i)
+  // The first and the last pixels of each row
+  std::vector<IndexType> points;
+  for (auto lineIt = lines.begin(); lineIt != lines.end();)
+  {
+    IndexType      first = lineIt->GetIndex();
+    IndexValueType last = first[0] + static_cast<IndexValueType>(lineIt->GetLength()) - 1;
+    for (++lineIt; lineIt != lines.end(); ++lineIt)
     {
-      if (it.GetPixel(i) != label)
+      const IndexType & idx = lineIt->GetIndex();
+      bool              sameRow = true;
+      for (unsigned int i = 1; i < ImageDimension; ++i)
+      {
+        sameRow = sameRow && idx[i] == first[i];
+      }
+      if (!sameRow)
       {
-        idxList.push_back(iit.GetIndex());
         break;
       }
+      last = std::max(last, idx[0] + static_cast<IndexValueType>(lineIt->GetLength()) - 1);
+    }
+    points.push_back(first);
+    if (last != first[0])
+    {
+      first[0] = last;
+      points.push_back(first);
+    }
+  }
+
+  // Count, for each point, the number of planes (0, d) in which it is a vertex
+  // of the convex hull, computed with the monotone chain algorithm.
+  std::vector<unsigned int> numberOfPlanes(points.size(), 0);
+  std::vector<size_t>       order(points.size());
+  std::vector<size_t>       hull(2 * points.size());
+  for (unsigned int d = 1; d < ImageDimension; ++d)
+  {
+    std::iota(order.begin(), order.end(), size_t{ 0 });
+    const auto inSamePlane = [&points, d](size_t a, size_t b) {
+      for (unsigned int i = 1; i < ImageDimension; ++i)
+      {
+        if (i != d && points[a][i] != points[b][i])
+        {
+          return false;
+        }
+      }
+      return true;
+    };
+    std::sort(order.begin(), order.end(), [&points, d](size_t a, size_t b) {
+      for (int i = ImageDimension - 1; i >= 1; --i)
+      {
+        if (static_cast<unsigned int>(i) != d && points[a][i] != points[b][i])
+        {
+          return points[a][i] < points[b][i];
+        }
+      }
+      if (points[a][d] != points[b][d])
+      {
+        return points[a][d] < points[b][d];
+      }
+      return points[a][0] < points[b][0];
+    });
+    // Positive if o, a, b make a counter-clockwise turn in the plane (d, 0)
+    const auto cross = [&points, d](size_t o, size_t a, size_t b) {
+      return (points[a][d] - points[o][d]) * (points[b][0] - points[o][0]) -
+             (points[a][0] - points[o][0]) * (points[b][d] - points[o][d]);
+    };
+
+    for (size_t planeBegin = 0; planeBegin < order.size();)
+    {
+      size_t planeEnd = planeBegin + 1;
+      while (planeEnd < order.size() && inSamePlane(order[planeBegin], order[planeEnd]))
+      {
+        ++planeEnd;
+      }
+
+      if (planeEnd - planeBegin <= 2)
+      {
+        for (size_t p = planeBegin; p < planeEnd; ++p)
+        {
+          ++numberOfPlanes[order[p]];
+        }
+      }
+      else
+      {
+        // lower hull, then upper hull
+        size_t k = 0;
+        for (size_t p = planeBegin; p < planeEnd; ++p)
+        {
+          while (k >= 2 && cross(hull[k - 2], hull[k - 1], order[p]) <= 0)
+          {
+            --k;
+          }
+          hull[k++] = order[p];
+        }
+        const size_t lowerHullSize = k + 1;
+        for (size_t p = planeEnd - 1; p > planeBegin; --p)
+        {
+          while (k >= lowerHullSize && cross(hull[k - 2], hull[k - 1], order[p - 1]) <= 0)
+          {
+            --k;
+          }
+          hull[k++] = order[p - 1];
+        }
+        // the first point is repeated at the end of the hull
+        for (size_t h = 0; h + 1 < k; ++h)
+        {
+          ++numberOfPlanes[hull[h]];
+        }
+      }
+      planeBegin = planeEnd;
+    }
+  }
+
+  std::vector<IndexType> candidates;
+  for (size_t p = 0; p < points.size(); ++p)
+  {
+    if (numberOfPlanes[p] == ImageDimension - 1)
+    {
+      candidates.push_back(points[p]);
     }
-    ++iit;
   }
 
   ImageType * output = this->GetOutput();
@@ -471,10 +560,10 @@ ShapeLabelMapFilter<TImage, TLabelImage>::ComputeFeretDiameter(LabelObjectType *
 
   // We can now search the feret diameter
   double feretDiameter = 0;
-  for (typename IndexListType::const_iterator iIt1 = idxList.begin(); iIt1 != idxList.end(); ++iIt1)
+  for (auto iIt1 = candidates.begin(); iIt1 != candidates.end(); ++iIt1)
   {
     auto iIt2 = iIt1;
-    for (iIt2++; iIt2 != idxList.end(); ++iIt2)
+    for (iIt2++; iIt2 != candidates.end(); ++iIt2)
     {
       // Compute the length between the 2 indexes
       double length = 0;
@@ -501,7 +590,7 @@ void
 ShapeLabelMapFilter<TImage, TLabelImage>::ComputePerimeter(LabelObjectType * labelObject)
 {
   // store the lines in a N-1D image of vectors
-  using VectorLineType = std::deque<typename LabelObjectType::LineType>;
+  using VectorLineType = std::vector<typename LabelObjectType::LineType>;
   using LineImageType = itk::Image<VectorLineType, ImageDimension - 1>;
   auto                              lineImage = LineImageType::New();
   typename LineImageType::IndexType lIdx;
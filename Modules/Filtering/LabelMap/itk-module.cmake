@@ -14,6 +14,7 @@ itk_module(ITKLabelMap
     ITKStatistics
   COMPILE_DEPENDS
     ITKTransform
+    ITKMathematicalMorphology
   TEST_DEPENDS
     ITKTestKernel
     ITKBinaryMathematicalMorphology
@@ -0,0 +1,237 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBinaryDilateImageFilter.h"
+#include "itkBinaryDilateLabelMapFilter.h"
+#include "itkBinaryErodeImageFilter.h"
+#include "itkBinaryErodeLabelMapFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkLabelImageToLabelMapFilter.h"
+#include "itkTestingComparisonImageFilter.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Dilate and erode the objects of label maps directly on their lines, and
+ * check that each object is the same as the dilation or the erosion of its
+ * binary image computed with BinaryDilateImageFilter or BinaryErodeImageFilter,
+ * for several structuring elements, including asymmetric ones.
+ */
+namespace
+{
+template <unsigned int VDimension>
+using LabelImageType = itk::Image<unsigned char, VDimension>;
+
+template <unsigned int VDimension>
+using LabelMapType = itk::LabelMap<itk::LabelObject<unsigned char, VDimension>>;
+
+template <unsigned int VDimension>
+using KernelType = itk::FlatStructuringElement<VDimension>;
+
+// Overlapping balls with different labels, some of them cut by the sides of
+// the image, and a line of isolated pixels
+template <unsigned int VDimension>
+typename LabelImageType<VDimension>::Pointer
+itkBinaryMorphologyLabelMapFilterTestCreateImage(const typename LabelImageType<VDimension>::SizeType & size)
+{
+  using ImageType = LabelImageType<VDimension>;
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    double       firstBall = 0.0;
+    double       secondBall = 0.0;
+    double       hole = 0.0;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      firstBall += itk::Math::sqr(index[d] - 0.3 * size[d]);
+      secondBall += itk::Math::sqr(index[d] - 0.9 * size[d]);
+      hole += itk::Math::sqr(index[d] - 0.35 * size[d]);
+    }
+    unsigned char label = 0;
+    if (firstBall < itk::Math::sqr(0.25 * size[0]) && hole > 2.0)
+    {
+      label = 1;
+    }
+    else if (secondBall < itk::Math::sqr(0.3 * size[0]))
+    {
+      label = 2;
+    }
+    else if (index[1] == 1 && index[0] % 3 == 0)
+    {
+      label = 3;
+    }
+    it.Set(label);
+  }
+  return image;
+}
+
+template <unsigned int VDimension, typename TLabelMapFilter, typename TImageFilter>
+int
+itkBinaryMorphologyLabelMapFilterTestCompare(const LabelImageType<VDimension> * image,
+                                             TLabelMapFilter *                  labelMapFilter,
+                                             TImageFilter *                     imageFilter)
+{
+  using ImageType = LabelImageType<VDimension>;
+
+  using ToLabelMapType = itk::LabelImageToLabelMapFilter<ImageType, LabelMapType<VDimension>>;
+  auto toLabelMap = ToLabelMapType::New();
+  toLabelMap->SetInput(image);
+
+  labelMapFilter->SetInput(toLabelMap->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(labelMapFilter->Update());
+  const LabelMapType<VDimension> * labelMap = labelMapFilter->GetOutput();
+
+  for (unsigned char label = 1; label <= 3; ++label)
+  {
+    auto binaryImage = ImageType::New();
+    binaryImage->SetRegions(image->GetLargestPossibleRegion());
+    binaryImage->Allocate();
+    itk::ImageRegionConstIteratorWithIndex<ImageType> inputIt(image, image->GetLargestPossibleRegion());
+    for (inputIt.GoToBegin(); !inputIt.IsAtEnd(); ++inputIt)
+    {
+      binaryImage->SetPixel(inputIt.GetIndex(), inputIt.Get() == label ? 1 : 0);
+    }
+    imageFilter->SetInput(binaryImage);
+    imageFilter->SetForegroundValue(1);
+    imageFilter->SetBackgroundValue(0);
+    imageFilter->SetKernel(labelMapFilter->GetKernel());
+    ITK_TRY_EXPECT_NO_EXCEPTION(imageFilter->UpdateLargestPossibleRegion());
+    const ImageType * expected = imageFilter->GetOutput();
+
+    // the pixels of the object, if it was not removed
+    auto objectImage = ImageType::New();
+    objectImage->SetRegions(image->GetLargestPossibleRegion());
+    objectImage->Allocate(true);
+    if (labelMap->HasLabel(label))
+    {
+      const auto * labelObject = labelMap->GetLabelObject(label);
+      ITK_TEST_EXPECT_TRUE(!labelObject->Empty());
+      for (typename LabelMapType<VDimension>::LabelObjectType::ConstIndexIterator it(labelObject); !it.IsAtEnd(); ++it)
+      {
+        // each pixel is in the image, and in a single line
+        ITK_TEST_EXPECT_TRUE(objectImage->GetLargestPossibleRegion().IsInside(it.GetIndex()));
+        ITK_TEST_EXPECT_EQUAL(static_cast<int>(objectImage->GetPixel(it.GetIndex())), 0);
+        objectImage->SetPixel(it.GetIndex(), 1);
+      }
+    }
+
+    std::cout << "Object " << static_cast<int>(label) << std::endl;
+    using ComparisonFilterType = itk::Testing::ComparisonImageFilter<ImageType, ImageType>;
+    auto comparison = ComparisonFilterType::New();
+    comparison->SetValidInput(expected);
+    comparison->SetTestInput(objectImage);
+    comparison->SetDifferenceThreshold(0);
+    comparison->SetToleranceRadius(0);
+    ITK_TRY_EXPECT_NO_EXCEPTION(comparison->Update());
+    ITK_TEST_EXPECT_EQUAL(comparison->GetNumberOfPixelsWithDifferences(), 0);
+  }
+  return EXIT_SUCCESS;
+}
+
+template <unsigned int VDimension>
+int
+itkBinaryMorphologyLabelMapFilterTestRun(const typename LabelImageType<VDimension>::SizeType & size,
+                                         const std::vector<KernelType<VDimension>> &           kernels)
+{
+  using ImageType = LabelImageType<VDimension>;
+  const typename ImageType::Pointer image = itkBinaryMorphologyLabelMapFilterTestCreateImage<VDimension>(size);
+
+  for (const auto & kernel : kernels)
+  {
+    std::cout << "Dimension: " << VDimension << ", kernel radius: " << kernel.GetRadius() << std::endl;
+
+    using DilateLabelMapFilterType = itk::BinaryDilateLabelMapFilter<LabelMapType<VDimension>>;
+    auto dilateLabelMapFilter = DilateLabelMapFilterType::New();
+    dilateLabelMapFilter->SetKernel(kernel);
+    using DilateImageFilterType = itk::BinaryDilateImageFilter<ImageType, ImageType, KernelType<VDimension>>;
+    auto dilateImageFilter = DilateImageFilterType::New();
+    if (itkBinaryMorphologyLabelMapFilterTestCompare<VDimension>(
+          image.GetPointer(), dilateLabelMapFilter.GetPointer(), dilateImageFilter.GetPointer()) != EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+
+    for (const bool boundaryToForeground : { true, false })
+    {
+      using ErodeLabelMapFilterType = itk::BinaryErodeLabelMapFilter<LabelMapType<VDimension>>;
+      auto erodeLabelMapFilter = ErodeLabelMapFilterType::New();
+      erodeLabelMapFilter->SetKernel(kernel);
+      erodeLabelMapFilter->SetBoundaryToForeground(boundaryToForeground);
+      using ErodeImageFilterType = itk::BinaryErodeImageFilter<ImageType, ImageType, KernelType<VDimension>>;
+      auto erodeImageFilter = ErodeImageFilterType::New();
+      erodeImageFilter->SetBoundaryToForeground(boundaryToForeground);
+      if (itkBinaryMorphologyLabelMapFilterTestCompare<VDimension>(
+            image.GetPointer(), erodeLabelMapFilter.GetPointer(), erodeImageFilter.GetPointer()) != EXIT_SUCCESS)
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkBinaryMorphologyLabelMapFilterTest(int, char *[])
+{
+  using DilateFilterType = itk::BinaryDilateLabelMapFilter<LabelMapType<2>>;
+  using ErodeFilterType = itk::BinaryErodeLabelMapFilter<LabelMapType<2>>;
+  auto dilateFilter = DilateFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(dilateFilter, BinaryDilateLabelMapFilter, BinaryMorphologyLabelMapFilter);
+  auto erodeFilter = ErodeFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(erodeFilter, BinaryErodeLabelMapFilter, BinaryMorphologyLabelMapFilter);
+  ITK_TEST_SET_GET_BOOLEAN(erodeFilter, BoundaryToForeground, true);
+
+  // Symmetric and asymmetric kernels, and a kernel without its center line
+  KernelType<2>::RadiusType radius2D;
+  radius2D[0] = 3;
+  radius2D[1] = 2;
+  KernelType<2> asymmetricKernel2D;
+  asymmetricKernel2D.SetRadius(radius2D);
+  KernelType<2> offCenterKernel2D;
+  offCenterKernel2D.SetRadius(radius2D);
+  const KernelType<2>::RadiusType smallRadius2D{ { 1, 1 } };
+  std::vector<KernelType<2>>      kernels2D{ KernelType<2>::Ball(radius2D), KernelType<2>::Box(smallRadius2D) };
+  for (unsigned int i = 0; i < asymmetricKernel2D.Size(); ++i)
+  {
+    const auto offset = asymmetricKernel2D.GetOffset(i);
+    asymmetricKernel2D[i] = (offset[0] >= -1 && offset[1] >= 0 && offset[0] + offset[1] <= 2) || offset[0] == -3;
+    offCenterKernel2D[i] = offset[1] == 2 && offset[0] != 0;
+  }
+  kernels2D.push_back(asymmetricKernel2D);
+  kernels2D.push_back(offCenterKernel2D);
+
+  const KernelType<3>::RadiusType radius3D{ { 2, 2, 1 } };
+  std::vector<KernelType<3>>      kernels3D{ KernelType<3>::Ball(radius3D), KernelType<3>::Cross(radius3D) };
+
+  if (itkBinaryMorphologyLabelMapFilterTestRun<2>(LabelImageType<2>::SizeType{ { 47, 35 } }, kernels2D) !=
+        EXIT_SUCCESS ||
+      itkBinaryMorphologyLabelMapFilterTestRun<3>(LabelImageType<3>::SizeType{ { 19, 16, 13 } }, kernels3D) !=
+        EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -19,6 +19,7 @@
 #include "itkGTest.h"
 
 #include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkLabelImageToShapeLabelMapFilter.h"
 #include "itkTestingMacros.h"
 
@@ -542,3 +543,118 @@ TEST_F(ShapeLabelMapFixture, 2D_T2x4)
     labelObject->Print(std::cout);
   }
 }
+
+
+TEST_F(ShapeLabelMapFixture, 2D_ManySmallObjects)
+{
+  using Utils = FixtureUtilities<2>;
+  using L2SType = itk::LabelImageToShapeLabelMapFilter<Utils::ImageType>;
+
+  // One object per pair of pixels, so that the label objects are dispatched
+  // to the work units by chunks of many objects
+  auto                       image = Utils::ImageType::New();
+  Utils::ImageType::SizeType imageSize = { { 128, 64 } };
+  image->SetRegions(Utils::ImageType::RegionType(imageSize));
+  image->Allocate();
+  for (unsigned int j = 0; j < imageSize[1]; ++j)
+  {
+    for (unsigned int i = 0; i < imageSize[0]; ++i)
+    {
+      image->SetPixel(itk::MakeIndex(i, j), static_cast<Utils::PixelType>(1 + j * imageSize[0] / 2 + i / 2));
+    }
+  }
+
+  auto sequential = L2SType::New();
+  sequential->SetInput(image);
+  sequential->SetBackgroundValue(0);
+  sequential->SetNumberOfWorkUnits(1);
+  sequential->Update();
+
+  auto concurrent = L2SType::New();
+  concurrent->SetInput(image);
+  concurrent->SetBackgroundValue(0);
+  concurrent->SetNumberOfWorkUnits(7);
+  concurrent->Update();
+
+  const auto numberOfLabelObjects = imageSize[0] * imageSize[1] / 2;
+  ASSERT_EQ(sequential->GetOutput()->GetNumberOfLabelObjects(), numberOfLabelObjects);
+  ASSERT_EQ(concurrent->GetOutput()->GetNumberOfLabelObjects(), numberOfLabelObjects);
+
+  for (Utils::PixelType label = 1; label <= numberOfLabelObjects; ++label)
+  {
+    const auto * sequentialObject = sequential->GetOutput()->GetLabelObject(label);
+    const auto * concurrentObject = concurrent->GetOutput()->GetLabelObject(label);
+    EXPECT_EQ(sequentialObject->GetNumberOfPixels(), 2u);
+    EXPECT_EQ(concurrentObject->GetNumberOfPixels(), 2u);
+    EXPECT_EQ(sequentialObject->GetCentroid(), concurrentObject->GetCentroid());
+    EXPECT_EQ(sequentialObject->GetPerimeter(), concurrentObject->GetPerimeter());
+  }
+}
+
+
+TEST_F(ShapeLabelMapFixture, 3D_FeretDiameterMatchesAllPixelPairs)
+{
+  using Utils = FixtureUtilities<3>;
+  using L2SType = itk::LabelImageToShapeLabelMapFilter<Utils::ImageType>;
+
+  // Objects of various shapes, some touching the border of the image
+  auto image = Utils::CreateImage();
+  image->SetSpacing(itk::MakeVector(1.0, 0.7, 1.6));
+  itk::ImageRegionIteratorWithIndex<Utils::ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const auto & idx = it.GetIndex();
+    const auto   r2 = (idx[0] - 8) * (idx[0] - 8) + (idx[1] - 9) * (idx[1] - 9) + (idx[2] - 7) * (idx[2] - 7);
+    if (r2 <= 30)
+    {
+      it.Set(1);
+    }
+    else if (idx[0] == idx[1] && idx[1] + 2 == idx[2])
+    {
+      it.Set(2);
+    }
+    else if (idx[0] > 14 && idx[1] > 14 && (idx[0] * 7 + idx[1] * 3 + idx[2] * 5) % 11 < 6)
+    {
+      it.Set(3);
+    }
+    else if (idx[0] < 5 && idx[1] > 20 && idx[2] > 20 && (idx[0] + idx[1] + idx[2]) % 2 == 0)
+    {
+      it.Set(4);
+    }
+  }
+  image->SetPixel(itk::MakeIndex(0, 24, 0), 5);
+
+  auto l2s = L2SType::New();
+  l2s->SetInput(image);
+  l2s->ComputeFeretDiameterOn();
+  l2s->ComputePerimeterOff();
+  l2s->Update();
+
+  const auto & spacing = image->GetSpacing();
+  for (Utils::PixelType label = 1; label <= 5; ++label)
+  {
+    std::vector<itk::Index<3>> indices;
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      if (it.Get() == label)
+      {
+        indices.push_back(it.GetIndex());
+      }
+    }
+    double expected = 0.0;
+    for (const auto & a : indices)
+    {
+      for (const auto & b : indices)
+      {
+        double length = 0.0;
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+          length += std::pow((a[i] - b[i]) * spacing[i], 2);
+        }
+        expected = std::max(expected, length);
+      }
+    }
+    EXPECT_NEAR(l2s->GetOutput()->GetLabelObject(label)->GetFeretDiameter(), std::sqrt(expected), 1e-12)
+      << "label " << label;
+  }
+}
@@ -22,7 +22,9 @@
 #include "itkShapedNeighborhoodIterator.h"
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
+#include "itkTotalProgressReporter.h"
 #include <queue>
+#include <vector>
 
 //#define BASIC
 #define COPY
@@ -43,6 +45,16 @@ namespace itk
  * applications and efficient algorithms" -- IEEE Transactions on
  * Image processing, Vol 2, No 2, pp 176-201, April 1993
  *
+ * With several work units, the image is split in slabs along the last
+ * dimension, which are reconstructed concurrently, every other slab at a
+ * time, with the pixels of the neighbor slabs left unchanged. A slab is
+ * reconstructed again when the layer of a neighbor slab next to it has
+ * changed, until no layer changes. The result is the same as with a single
+ * work unit, as the reconstruction is unique. A value propagating along the
+ * last dimension through all the slabs costs up to one reconstruction of a
+ * slab per slab it crosses, so images that are too thin to hold two slabs of
+ * at least 8 layers, and single work unit runs, use the sequential algorithm.
+ *
  * \author Richard Beare. Department of Medicine, Monash University,
  * Melbourne, Australia.
  *
@@ -150,6 +162,15 @@ protected:
   void
   GenerateData() override;
 
+  /** Reconstruct the pixels of the region of the marker image, the pixels
+   * outside of the region along the last dimension being left unchanged.
+   * Returns false if a marker pixel is on the wrong side of its mask pixel. */
+  bool
+  ReconstructRegion(const MarkerImageType *       markerImage,
+                    const MaskImageType *         maskImage,
+                    const OutputImageRegionType & region,
+                    TotalProgressReporter *       progress) const;
+
   /**
    * the value of the border - used in boundary condition.
    */
@@ -171,6 +192,12 @@ private:
   using InIndexType = typename InputImageType::IndexType;
   using CNInputIterator = ConstShapedNeighborhoodIterator<InputImageType>;
   using NOutputIterator = ShapedNeighborhoodIterator<OutputImageType>;
+
+  static std::vector<OutputImagePixelType>
+  CopyLayer(const MarkerImageType * markerImage, const OutputImageRegionType & layer);
+
+  void
+  ThrowMarkerMaskException() const;
 }; // end of class
 } // end namespace itk
 
@@ -24,6 +24,7 @@
 
 #include "itkConstantPadImageFilter.h"
 #include "itkCropImageFilter.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -75,9 +76,7 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
   // subset of the pixels. We'll just pretend that the third pass
   // takes the same as each of the others. Is it OK to update more
   // often than pixels?
-  ProgressReporter progress(this, 0, this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() * 3);
-
-  TCompare compare;
+  const SizeValueType numberOfProgressPixels = this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() * 3;
 
   MarkerImageConstPointer markerImage = this->GetMarkerImage();
   MaskImageConstPointer   maskImage = this->GetMaskImage();
@@ -134,43 +133,162 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
     markerImageP = output;
   }
 
-  // declare our queue type
-  using FifoType = typename std::queue<OutputImageIndexType>;
-  FifoType IndexFifo;
-
-  NOutputIterator   outNIt;
-  InputIteratorType mskIt;
-  CNInputIterator   mskNIt;
-  ISizeType         kernelRadius;
-  kernelRadius.Fill(1);
+  // the region to reconstruct
+  OutputImageRegionType region = output->GetRequestedRegion();
   if (m_UseInternalCopy)
   {
+    ISizeType kernelRadius;
+    kernelRadius.Fill(1);
     FaceCalculatorType faceCalculator;
+    // we will only be processing the body region
+    region = faceCalculator(maskImageP, maskImageP->GetLargestPossibleRegion(), kernelRadius).front();
+  }
 
-    FaceListTypeIt fit;
+  // Split the region in slabs along the last dimension, with twice as many
+  // slabs as work units since only every other slab is processed at a time
+  constexpr unsigned int  lastDimension = OutputImageDimension - 1;
+  constexpr SizeValueType minimumSlabThickness = 8;
+  SizeValueType           numberOfSlabs = 1;
+  if (this->GetNumberOfWorkUnits() > 1)
+  {
+    numberOfSlabs = std::min(SizeValueType{ 2 } * this->GetNumberOfWorkUnits(),
+                             region.GetSize(lastDimension) / minimumSlabThickness);
+  }
 
-    FaceListType faceList = faceCalculator(maskImageP, maskImageP->GetLargestPossibleRegion(), kernelRadius);
-    // we will only be processing the body region
-    fit = faceList.begin();
-    // must be a better way of doing this
-    NOutputIterator tt(kernelRadius, markerImageP, *fit);
-    outNIt = tt;
-
-    InputIteratorType ttt(maskImageP, *fit);
-    mskIt = ttt;
-    CNInputIterator tttt(kernelRadius, maskImageP, *fit);
-    mskNIt = tttt;
+  if (numberOfSlabs < 2)
+  {
+    // a single work unit reconstructs the whole region sequentially
+    TotalProgressReporter progress(this, numberOfProgressPixels);
+    if (!this->ReconstructRegion(markerImageP, maskImageP, region, &progress))
+    {
+      this->ThrowMarkerMaskException();
+    }
   }
   else
   {
-    NOutputIterator tt(kernelRadius, markerImageP, output->GetRequestedRegion());
-    outNIt = tt;
+    std::vector<OutputImageRegionType> slabs(numberOfSlabs, region);
+    for (SizeValueType s = 0; s < numberOfSlabs; ++s)
+    {
+      const SizeValueType begin = s * region.GetSize(lastDimension) / numberOfSlabs;
+      const SizeValueType end = (s + 1) * region.GetSize(lastDimension) / numberOfSlabs;
+      slabs[s].SetIndex(lastDimension, region.GetIndex(lastDimension) + static_cast<IndexValueType>(begin));
+      slabs[s].SetSize(lastDimension, end - begin);
+    }
+
+    // The slabs are reconstructed independently, the pixels of the
+    // neighbor slabs being left unchanged, and a slab is reconstructed again
+    // when a layer of a neighbor slab next to it has changed. Neighbor slabs
+    // are never processed at the same time.
+    std::vector<unsigned char> dirty(numberOfSlabs, 1);
+    std::vector<unsigned char> firstLayerChanged(numberOfSlabs, 0);
+    std::vector<unsigned char> lastLayerChanged(numberOfSlabs, 0);
+    std::vector<unsigned char> valid(numberOfSlabs, 1);
+    std::vector<unsigned char> reconstructed(numberOfSlabs, 0);
+    std::vector<SizeValueType> slabsToProcess;
+    bool                       anyDirty = true;
+    while (anyDirty)
+    {
+      for (SizeValueType parity = 0; parity < 2; ++parity)
+      {
+        slabsToProcess.clear();
+        for (SizeValueType s = parity; s < numberOfSlabs; s += 2)
+        {
+          if (dirty[s])
+          {
+            slabsToProcess.push_back(s);
+          }
+        }
+
+        this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+        this->GetMultiThreader()->ParallelizeArray(
+          0,
+          slabsToProcess.size(),
+          [&](SizeValueType k) {
+            const SizeValueType           s = slabsToProcess[k];
+            const OutputImageRegionType & slab = slabs[s];
+
+            OutputImageRegionType firstLayer = slab;
+            firstLayer.SetSize(lastDimension, 1);
+            OutputImageRegionType lastLayer = firstLayer;
+            lastLayer.SetIndex(lastDimension, slab.GetIndex(lastDimension) + slab.GetSize(lastDimension) - 1);
+
+            const std::vector<OutputImagePixelType> firstLayerValues = CopyLayer(markerImageP, firstLayer);
+            const std::vector<OutputImagePixelType> lastLayerValues = CopyLayer(markerImageP, lastLayer);
+
+            // the progress is reported for the first reconstruction of each
+            // slab only, as the number of reconstructions is not known
+            TotalProgressReporter progress(reconstructed[s] ? nullptr : this, numberOfProgressPixels);
+            valid[s] = this->ReconstructRegion(markerImageP, maskImageP, slab, &progress);
+
+            firstLayerChanged[s] = (CopyLayer(markerImageP, firstLayer) != firstLayerValues);
+            lastLayerChanged[s] = (CopyLayer(markerImageP, lastLayer) != lastLayerValues);
+          },
+          nullptr);
+
+        for (const SizeValueType s : slabsToProcess)
+        {
+          if (!valid[s])
+          {
+            this->ThrowMarkerMaskException();
+          }
+          dirty[s] = 0;
+          reconstructed[s] = 1;
+          if (firstLayerChanged[s] && s > 0)
+          {
+            dirty[s - 1] = 1;
+          }
+          if (lastLayerChanged[s] && s + 1 < numberOfSlabs)
+          {
+            dirty[s + 1] = 1;
+          }
+        }
+      }
+      anyDirty = std::find(dirty.begin(), dirty.end(), 1) != dirty.end();
+    }
+  }
+
+  if (m_UseInternalCopy)
+  {
+    using CropType = typename itk::CropImageFilter<InputImageType, OutputImageType>;
+    auto crop = CropType::New();
 
-    InputIteratorType ttt(maskImageP, output->GetRequestedRegion());
-    mskIt = ttt;
-    CNInputIterator tttt(kernelRadius, maskImageP, output->GetRequestedRegion());
-    mskNIt = tttt;
+    crop->SetInput(markerImageP);
+    crop->SetUpperBoundaryCropSize(padSize);
+    crop->SetLowerBoundaryCropSize(padSize);
+    crop->GraftOutput(this->GetOutput());
+    /** execute the minipipeline */
+    crop->Update();
+
+    /** graft the minipipeline output back into this filter's output */
+    this->GraftOutput(crop->GetOutput());
   }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TCompare>
+bool
+ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::ReconstructRegion(
+  const MarkerImageType *       markerImageP,
+  const MaskImageType *         maskImageP,
+  const OutputImageRegionType & region,
+  TotalProgressReporter *       progress) const
+{
+  TCompare compare;
+
+  // declare our queue type
+  using FifoType = typename std::queue<OutputImageIndexType>;
+  FifoType IndexFifo;
+
+  ISizeType kernelRadius;
+  kernelRadius.Fill(1);
+
+  NOutputIterator   outNIt(kernelRadius, markerImageP, region);
+  InputIteratorType mskIt(maskImageP, region);
+  CNInputIterator   mskNIt(kernelRadius, maskImageP, region);
+
+  // the pixels out of the region along the last dimension are left unchanged
+  constexpr unsigned int lastDimension = OutputImageDimension - 1;
+  const IndexValueType   regionBegin = region.GetIndex(lastDimension);
+  const IndexValueType   regionEnd = regionBegin + static_cast<IndexValueType>(region.GetSize(lastDimension));
 
   setConnectivityPrevious(&outNIt, m_FullyConnected);
 
@@ -188,14 +306,7 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
     // be sure that the pixels in the images follow the preconditions
     if (compare(V, iV))
     {
-      if (compare(0, 1))
-      {
-        itkExceptionMacro(<< "Marker pixels must be <= mask pixels.");
-      }
-      else
-      {
-        itkExceptionMacro(<< "Marker pixels must be >= mask pixels.");
-      }
+      return false;
     }
 
     // visit the previous neighbours
@@ -216,7 +327,10 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
       outNIt.SetCenterPixel(iV);
     }
 
-    progress.CompletedPixel();
+    if (progress)
+    {
+      progress->CompletedPixel();
+    }
   }
 
   // now for the reverse raster order pass
@@ -273,7 +387,10 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
         break;
       }
     }
-    progress.CompletedPixel();
+    if (progress)
+    {
+      progress->CompletedPixel();
+    }
   }
 
   // Now we want to check the full neighborhood
@@ -303,6 +420,11 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
       // candidate for dilation via flooding
       if (compare(V, VN) && Math::NotAlmostEquals(iN, VN))
       {
+        const OutputImageIndexType neighborIndex = outNIt.GetIndex(*oLIt);
+        if (neighborIndex[lastDimension] < regionBegin || neighborIndex[lastDimension] >= regionEnd)
+        {
+          continue;
+        }
         if (compare(iN, V))
         {
           // not clamped by the mask, propagate the center value
@@ -313,26 +435,44 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
           // apply the clamping
           outNIt.SetPixel(*oLIt, iN);
         }
-        IndexFifo.push(outNIt.GetIndex(*oLIt));
+        IndexFifo.push(neighborIndex);
       }
     }
-    progress.CompletedPixel();
+    if (progress)
+    {
+      progress->CompletedPixel();
+    }
   }
+  return true;
+}
 
-  if (m_UseInternalCopy)
+template <typename TInputImage, typename TOutputImage, typename TCompare>
+auto
+ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::CopyLayer(const MarkerImageType *       markerImage,
+                                                                          const OutputImageRegionType & layer)
+  -> std::vector<OutputImagePixelType>
+{
+  std::vector<OutputImagePixelType> values;
+  values.reserve(layer.GetNumberOfPixels());
+  for (ImageRegionConstIterator<MarkerImageType> it(markerImage, layer); !it.IsAtEnd(); ++it)
   {
-    using CropType = typename itk::CropImageFilter<InputImageType, OutputImageType>;
-    auto crop = CropType::New();
-
-    crop->SetInput(markerImageP);
-    crop->SetUpperBoundaryCropSize(padSize);
-    crop->SetLowerBoundaryCropSize(padSize);
-    crop->GraftOutput(this->GetOutput());
-    /** execute the minipipeline */
-    crop->Update();
+    values.push_back(static_cast<OutputImagePixelType>(it.Get()));
+  }
+  return values;
+}
 
-    /** graft the minipipeline output back into this filter's output */
-    this->GraftOutput(crop->GetOutput());
+template <typename TInputImage, typename TOutputImage, typename TCompare>
+void
+ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::ThrowMarkerMaskException() const
+{
+  TCompare compare;
+  if (compare(0, 1))
+  {
+    itkExceptionMacro(<< "Marker pixels must be <= mask pixels.");
+  }
+  else
+  {
+    itkExceptionMacro(<< "Marker pixels must be >= mask pixels.");
   }
 }
 
@@ -0,0 +1,159 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkReconstructionByDilationImageFilter.h"
+#include "itkReconstructionByErosionImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingComparisonImageFilter.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Check that the reconstruction by slabs, with several work units, gives
+ * exactly the same result as the reconstruction with a single work unit.
+ */
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image<unsigned char, Dimension>;
+
+template <typename TFilter>
+typename TFilter::Pointer
+itkReconstructionImageFilterMultiThreadingTestCreateFilter(const ImageType * marker,
+                                                           const ImageType * mask,
+                                                           bool              fullyConnected,
+                                                           bool              useInternalCopy,
+                                                           unsigned int      numberOfWorkUnits)
+{
+  auto filter = TFilter::New();
+  filter->SetMarkerImage(marker);
+  filter->SetMaskImage(mask);
+  filter->SetFullyConnected(fullyConnected);
+  filter->SetUseInternalCopy(useInternalCopy);
+  filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+  return filter;
+}
+
+template <typename TFilter>
+int
+itkReconstructionImageFilterMultiThreadingTestCompare(const ImageType * marker, const ImageType * mask)
+{
+  using ComparisonFilterType = itk::Testing::ComparisonImageFilter<ImageType, ImageType>;
+
+  for (bool fullyConnected : { false, true })
+  {
+    for (bool useInternalCopy : { false, true })
+    {
+      const auto referenceFilter = itkReconstructionImageFilterMultiThreadingTestCreateFilter<TFilter>(
+        marker, mask, fullyConnected, useInternalCopy, 1);
+      ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+
+      for (unsigned int numberOfWorkUnits : { 2, 3, 8 })
+      {
+        std::cout << "FullyConnected: " << fullyConnected << ", UseInternalCopy: " << useInternalCopy
+                  << ", NumberOfWorkUnits: " << numberOfWorkUnits << std::endl;
+        const auto filter = itkReconstructionImageFilterMultiThreadingTestCreateFilter<TFilter>(
+          marker, mask, fullyConnected, useInternalCopy, numberOfWorkUnits);
+        ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+        auto comparison = ComparisonFilterType::New();
+        comparison->SetValidInput(referenceFilter->GetOutput());
+        comparison->SetTestInput(filter->GetOutput());
+        ITK_TRY_EXPECT_NO_EXCEPTION(comparison->Update());
+        ITK_TEST_EXPECT_EQUAL(comparison->GetNumberOfPixelsWithDifferences(), 0);
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkReconstructionImageFilterMultiThreadingTest(int, char *[])
+{
+  using DilationFilterType = itk::ReconstructionByDilationImageFilter<ImageType, ImageType>;
+  using ErosionFilterType = itk::ReconstructionByErosionImageFilter<ImageType, ImageType>;
+
+  const ImageType::SizeType size = { { 23, 17, 70 } };
+  auto                      mask = ImageType::New();
+  mask->SetRegions(size);
+  mask->Allocate();
+  auto marker = ImageType::New();
+  marker->SetRegions(size);
+  marker->Allocate();
+  auto erosionMarker = ImageType::New();
+  erosionMarker->SetRegions(size);
+  erosionMarker->Allocate();
+
+  // A textured mask, with the marker lowered by a constant height: the
+  // reconstruction removes the maxima lower than the height.
+  itk::ImageRegionIteratorWithIndex<ImageType> it(mask, mask->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const auto &        idx = it.GetIndex();
+    const unsigned char value =
+      static_cast<unsigned char>(100 + 60 * std::sin(0.5 * idx[0]) * std::cos(0.4 * idx[1] + 0.3 * idx[2]) +
+                                 ((idx[0] * 13 + idx[1] * 7 + idx[2] * 3) % 17));
+    it.Set(value);
+    marker->SetPixel(idx, value > 30 ? value - 30 : 0);
+    erosionMarker->SetPixel(idx, value < 225 ? value + 30 : 255);
+  }
+  std::cout << "Dilation" << std::endl;
+  if (itkReconstructionImageFilterMultiThreadingTestCompare<DilationFilterType>(marker, mask) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  std::cout << "Erosion" << std::endl;
+  if (itkReconstructionImageFilterMultiThreadingTestCompare<ErosionFilterType>(erosionMarker, mask) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A corridor going back and forth along the last dimension, with a single
+  // seed at one end: the propagation crosses the slabs many times.
+  auto corridor = ImageType::New();
+  corridor->SetRegions(size);
+  corridor->Allocate(true);
+  auto seed = ImageType::New();
+  seed->SetRegions(size);
+  seed->Allocate(true);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    // lanes at x = 1, 5, ..., 21, joined alternately at z = 68 and z = 1
+    const auto & idx = it.GetIndex();
+    const bool   inLane = idx[0] % 4 == 1 && idx[2] >= 1 && idx[2] <= 68;
+    const bool   atTurn = idx[0] % 4 != 1 && idx[2] == (((idx[0] - 1) / 4) % 2 == 0 ? 68 : 1);
+    if (idx[1] == 8 && idx[0] >= 1 && idx[0] <= 21 && (inLane || atTurn))
+    {
+      corridor->SetPixel(idx, 200);
+    }
+  }
+  seed->SetPixel(itk::MakeIndex(1, 8, 1), 200);
+  std::cout << "Corridor" << std::endl;
+  if (itkReconstructionImageFilterMultiThreadingTestCompare<DilationFilterType>(seed, corridor) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  const auto filter =
+    itkReconstructionImageFilterMultiThreadingTestCreateFilter<DilationFilterType>(seed, corridor, false, true, 8);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(static_cast<int>(filter->GetOutput()->GetPixel(itk::MakeIndex(21, 8, 1))), 200);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -20,6 +20,8 @@
 
 #include "itkBoxImageFilter.h"
 #include "itkImage.h"
+#include <type_traits>
+#include <vector>
 
 namespace itk
 {
@@ -36,6 +38,17 @@ namespace itk
  * This filter requires that the input pixel type provides an operator<()
  * (LessThan Comparable).
  *
+ * For 8-bit and 16-bit integer pixel types and neighborhoods of at least
+ * MinimumNeighborhoodSizeForHistogram pixels, the median is tracked in a
+ * histogram of the neighborhood, which is updated as the neighborhood slides
+ * along the first dimension (T. Huang, G. Yang and G. Tang, "A fast
+ * two-dimensional median filtering algorithm", IEEE Transactions on
+ * Acoustics, Speech, and Signal Processing, 27(1), 1979). The histogram has a
+ * second level of coarse bins, so that the median moves across empty bins in
+ * large steps. Only the pixels entering and leaving the neighborhood are
+ * visited, instead of sorting the whole neighborhood at every pixel. Other
+ * pixel types and smaller neighborhoods are sorted, with the same result.
+ *
  * \sa Image
  * \sa Neighborhood
  * \sa NeighborhoodOperator
@@ -84,6 +97,10 @@ public:
 
   using InputSizeType = typename InputImageType::SizeType;
 
+  /** Minimum number of pixels of the neighborhood (7x7 in 2D) for which the
+   * median of 8-bit and 16-bit integer pixels is tracked in a histogram. */
+  static constexpr SizeValueType MinimumNeighborhoodSizeForHistogram = 49;
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(SameDimensionCheck, (Concept::SameDimension<InputImageDimension, OutputImageDimension>));
@@ -108,6 +125,113 @@ protected:
    *     ImageToImageFilter::GenerateData() */
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  /** Compute the median of each pixel by partially sorting its neighborhood. */
+  void
+  DynamicThreadedGenerateDataWithSelection(const OutputImageRegionType & outputRegionForThread);
+
+  /** Compute the median of each pixel from a histogram of the neighborhood,
+   * updated as the neighborhood slides along the first dimension. The
+   * std::false_type overload, for pixel types that are not 8-bit or 16-bit
+   * integers, falls back to the selection. */
+  void
+  DynamicThreadedGenerateDataWithHistogram(const OutputImageRegionType & outputRegionForThread, std::true_type);
+  void
+  DynamicThreadedGenerateDataWithHistogram(const OutputImageRegionType & outputRegionForThread, std::false_type);
+
+private:
+  /** Whether the pixels can be counted in a histogram with a bin per value. */
+  using HistogramSupportedType = std::integral_constant<bool,
+                                                        std::is_integral<InputPixelType>::value &&
+                                                          !std::is_same<InputPixelType, bool>::value &&
+                                                          sizeof(InputPixelType) <= 2>;
+
+  /** \class Histogram
+   * Histogram of the pixel values of a neighborhood, with a bin per value and
+   * coarse bins of 2^(Bits/2) values, which tracks the bin of a given rank. */
+  class Histogram
+  {
+  public:
+    static constexpr unsigned int  Bits = 8 * sizeof(InputPixelType);
+    static constexpr unsigned int  CoarseShift = Bits / 2;
+    static constexpr SizeValueType NumberOfBins = SizeValueType{ 1 } << Bits;
+    static constexpr SizeValueType CoarseBinSize = SizeValueType{ 1 } << CoarseShift;
+
+    Histogram()
+      : m_Bins(NumberOfBins, 0)
+      , m_CoarseBins(NumberOfBins >> CoarseShift, 0)
+    {}
+
+    static SizeValueType
+    GetBin(const InputPixelType & value)
+    {
+      return static_cast<SizeValueType>(static_cast<OffsetValueType>(value) -
+                                        static_cast<OffsetValueType>(NumericTraits<InputPixelType>::NonpositiveMin()));
+    }
+
+    void
+    AddBin(const SizeValueType bin)
+    {
+      ++m_Bins[bin];
+      ++m_CoarseBins[bin >> CoarseShift];
+      m_Below += (bin < m_RankBin);
+    }
+
+    void
+    RemoveBin(const SizeValueType bin)
+    {
+      --m_Bins[bin];
+      --m_CoarseBins[bin >> CoarseShift];
+      m_Below -= (bin < m_RankBin);
+    }
+
+    /** Get the value of the pixel of the given rank (starting at zero), which
+     * must be smaller than the number of pixels in the histogram. */
+    InputPixelType
+    GetValue(const SizeValueType rank)
+    {
+      // Move down while the pixel of the rank is below the current bin,
+      // skipping a whole coarse bin when it only holds smaller pixels
+      while (m_Below > rank)
+      {
+        const SizeValueType previousCoarseBin = (m_RankBin >> CoarseShift) - 1;
+        if ((m_RankBin & (CoarseBinSize - 1)) == 0 && m_Below - m_CoarseBins[previousCoarseBin] > rank)
+        {
+          m_Below -= m_CoarseBins[previousCoarseBin];
+          m_RankBin -= CoarseBinSize;
+        }
+        else
+        {
+          --m_RankBin;
+          m_Below -= m_Bins[m_RankBin];
+        }
+      }
+      // Move up while the pixel of the rank is above the current bin
+      while (m_Below + m_Bins[m_RankBin] <= rank)
+      {
+        const SizeValueType coarseBin = m_RankBin >> CoarseShift;
+        if ((m_RankBin & (CoarseBinSize - 1)) == 0 && m_Below + m_CoarseBins[coarseBin] <= rank)
+        {
+          m_Below += m_CoarseBins[coarseBin];
+          m_RankBin += CoarseBinSize;
+        }
+        else
+        {
+          m_Below += m_Bins[m_RankBin];
+          ++m_RankBin;
+        }
+      }
+      return static_cast<InputPixelType>(static_cast<OffsetValueType>(m_RankBin) +
+                                         static_cast<OffsetValueType>(NumericTraits<InputPixelType>::NonpositiveMin()));
+    }
+
+  private:
+    std::vector<SizeValueType> m_Bins;
+    std::vector<SizeValueType> m_CoarseBins;
+    // bin of the pixel of the last requested rank, and number of pixels in the bins below it
+    SizeValueType m_RankBin{ 0 };
+    SizeValueType m_Below{ 0 };
+  };
 };
 } // end namespace itk
 
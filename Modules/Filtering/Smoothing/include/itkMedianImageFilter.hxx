@@ -21,6 +21,7 @@
 #include "itkBufferedImageNeighborhoodPixelAccessPolicy.h"
 #include "itkImageNeighborhoodOffsets.h"
 #include "itkImageRegionRange.h"
+#include "itkImageScanlineIterator.h"
 #include "itkIndexRange.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
@@ -43,6 +44,29 @@ template <typename TInputImage, typename TOutputImage>
 void
 MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
+{
+  const auto radius = this->GetRadius();
+
+  SizeValueType neighborhoodSize = 1;
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  {
+    neighborhoodSize *= 2 * radius[i] + 1;
+  }
+
+  if (radius[0] > 0 && neighborhoodSize >= MinimumNeighborhoodSizeForHistogram)
+  {
+    this->DynamicThreadedGenerateDataWithHistogram(outputRegionForThread, HistogramSupportedType{});
+  }
+  else
+  {
+    this->DynamicThreadedGenerateDataWithSelection(outputRegionForThread);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDataWithSelection(
+  const OutputImageRegionType & outputRegionForThread)
 {
   // Allocate output
   OutputImageType *      output = this->GetOutput();
@@ -104,6 +128,106 @@ MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
     }
   }
 }
+
+template <typename TInputImage, typename TOutputImage>
+void
+MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDataWithHistogram(
+  const OutputImageRegionType & outputRegionForThread,
+  std::false_type)
+{
+  this->DynamicThreadedGenerateDataWithSelection(outputRegionForThread);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDataWithHistogram(
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  OutputImageType *      output = this->GetOutput();
+  const InputImageType * input = this->GetInput();
+
+  const auto radius = this->GetRadius();
+
+  // The neighborhood, and the sections of the neighborhood entering and
+  // leaving it when it moves by one pixel along the first dimension.
+  const auto neighborhoodOffsets = GenerateRectangularImageNeighborhoodOffsets<InputImageDimension>(radius);
+  const auto neighborhoodSize = neighborhoodOffsets.size();
+  const auto firstRadius = static_cast<OffsetValueType>(radius[0]);
+
+  std::vector<Offset<InputImageDimension>> enteringOffsets;
+  std::vector<Offset<InputImageDimension>> leavingOffsets;
+  for (const auto & offset : neighborhoodOffsets)
+  {
+    if (offset[0] == firstRadius)
+    {
+      enteringOffsets.push_back(offset);
+      auto leavingOffset = offset;
+      leavingOffset[0] = -firstRadius - 1;
+      leavingOffsets.push_back(leavingOffset);
+    }
+  }
+  const auto sectionSize = enteringOffsets.size();
+
+  // All of our neighborhoods have an odd number of pixels, so there is
+  // always a median.
+  const SizeValueType medianRank = neighborhoodSize / 2;
+
+  // The pixels out of the image are those of the nearest boundary, as in
+  // the selection.
+  auto neighborhoodRange =
+    ShapedImageNeighborhoodRange<const InputImageType>(*input, Index<InputImageDimension>(), neighborhoodOffsets);
+  auto enteringRange =
+    ShapedImageNeighborhoodRange<const InputImageType>(*input, Index<InputImageDimension>(), enteringOffsets);
+  auto leavingRange =
+    ShapedImageNeighborhoodRange<const InputImageType>(*input, Index<InputImageDimension>(), leavingOffsets);
+
+  Histogram histogram;
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+
+  ImageScanlineIterator<OutputImageType> outputIt(output, outputRegionForThread);
+  while (!outputIt.IsAtEnd())
+  {
+    auto index = outputIt.GetIndex();
+
+    neighborhoodRange.SetLocation(index);
+    for (const InputPixelType value : neighborhoodRange)
+    {
+      histogram.AddBin(Histogram::GetBin(value));
+    }
+    outputIt.Set(static_cast<OutputPixelType>(histogram.GetValue(medianRank)));
+    ++outputIt;
+
+    while (!outputIt.IsAtEndOfLine())
+    {
+      ++index[0];
+      enteringRange.SetLocation(index);
+      leavingRange.SetLocation(index);
+      auto enteringIt = enteringRange.cbegin();
+      auto leavingIt = leavingRange.cbegin();
+      for (SizeValueType i = 0; i < sectionSize; ++i, ++enteringIt, ++leavingIt)
+      {
+        histogram.AddBin(Histogram::GetBin(*enteringIt));
+        histogram.RemoveBin(Histogram::GetBin(*leavingIt));
+      }
+      outputIt.Set(static_cast<OutputPixelType>(histogram.GetValue(medianRank)));
+      ++outputIt;
+    }
+
+    // Empty the histogram for the next line
+    neighborhoodRange.SetLocation(index);
+    for (const InputPixelType value : neighborhoodRange)
+    {
+      histogram.RemoveBin(Histogram::GetBin(value));
+    }
+
+    outputIt.NextLine();
+    progress.Completed(lineLength);
+  }
+}
 } // end namespace itk
 
 #endif
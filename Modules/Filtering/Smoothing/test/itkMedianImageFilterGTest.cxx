@@ -21,6 +21,7 @@
 
 #include "itkImage.h"
 #include "itkImageBufferRange.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
 
 #include <numeric> // For iota.
 #include <vector>
@@ -92,6 +93,57 @@ Expect_output_has_specified_pixel_values_when_input_has_sequence_of_natural_numb
   EXPECT_EQ(outputPixelValues, expectedPixelValues);
 }
 
+
+// Expects that the median of an integer image, computed with a histogram when the neighborhood is large enough, is
+// the same as the median of the image converted to float, computed by sorting the neighborhoods.
+template <typename TPixel, unsigned int VDimension>
+void
+Expect_same_output_as_float_image(const itk::Size<VDimension> & imageSize,
+                                  const itk::Size<VDimension> & radius,
+                                  const TPixel                  minimumValue,
+                                  const TPixel                  maximumValue)
+{
+  using ImageType = itk::Image<TPixel, VDimension>;
+  using FloatImageType = itk::Image<float, VDimension>;
+
+  const auto image = ImageType::New();
+  image->SetRegions(imageSize);
+  image->Allocate();
+  const auto floatImage = FloatImageType::New();
+  floatImage->SetRegions(imageSize);
+  floatImage->Allocate();
+
+  const auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->SetSeed(42);
+  const auto imageBufferRange = itk::ImageBufferRange<ImageType>{ *image };
+  const auto floatImageBufferRange = itk::ImageBufferRange<FloatImageType>{ *floatImage };
+  auto       floatIt = floatImageBufferRange.begin();
+  for (auto && pixel : imageBufferRange)
+  {
+    pixel = static_cast<TPixel>(minimumValue + static_cast<int>(generator->GetIntegerVariate(
+                                                 static_cast<uint32_t>(maximumValue - minimumValue))));
+    *floatIt = static_cast<float>(pixel);
+    ++floatIt;
+  }
+
+  const auto filter = itk::MedianImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(image);
+  filter->SetRadius(radius);
+  filter->Update();
+
+  const auto floatFilter = itk::MedianImageFilter<FloatImageType, FloatImageType>::New();
+  floatFilter->SetInput(floatImage);
+  floatFilter->SetRadius(radius);
+  floatFilter->Update();
+
+  const auto outputBufferRange = itk::MakeImageBufferRange(filter->GetOutput());
+  const auto floatOutputBufferRange = itk::MakeImageBufferRange(floatFilter->GetOutput());
+  const std::vector<float> outputPixelValues(outputBufferRange.cbegin(), outputBufferRange.cend());
+  const std::vector<float> floatOutputPixelValues(floatOutputBufferRange.cbegin(), floatOutputBufferRange.cend());
+
+  EXPECT_EQ(outputPixelValues, floatOutputPixelValues);
+}
+
 } // namespace
 
 
@@ -122,3 +174,17 @@ TEST(MedianImageFilter, ExpectedOutputPixelValuesForSequenceOfNaturalNumbers)
   Expect_output_has_specified_pixel_values_when_input_has_sequence_of_natural_numbers<itk::Image<int, 3>>(
     itk::Size<3>{ { 2, 2, 2 } }, { 3, 3, 3, 4, 5, 6, 6, 6 });
 }
+
+
+// Tests that the median of 8-bit and 16-bit integer images, computed with a histogram for large neighborhoods, is the
+// same as the median computed by sorting the neighborhoods, including at the image boundaries.
+TEST(MedianImageFilter, SameOutputForIntegerAndFloatPixels)
+{
+  Expect_same_output_as_float_image<unsigned char, 2>(itk::Size<2>{ { 37, 29 } }, itk::Size<2>{ { 3, 3 } }, 0, 255);
+  Expect_same_output_as_float_image<unsigned char, 2>(itk::Size<2>{ { 37, 29 } }, itk::Size<2>{ { 5, 2 } }, 100, 110);
+  Expect_same_output_as_float_image<unsigned char, 2>(itk::Size<2>{ { 4, 5 } }, itk::Size<2>{ { 3, 4 } }, 0, 255);
+  Expect_same_output_as_float_image<short, 2>(itk::Size<2>{ { 41, 23 } }, itk::Size<2>{ { 4, 3 } }, -30000, 30000);
+  Expect_same_output_as_float_image<unsigned short, 3>(
+    itk::Size<3>{ { 19, 13, 11 } }, itk::Size<3>{ { 2, 1, 3 } }, 0, 65535);
+  Expect_same_output_as_float_image<char, 3>(itk::Size<3>{ { 17, 12, 9 } }, itk::Size<3>{ { 1, 2, 2 } }, -128, 127);
+}
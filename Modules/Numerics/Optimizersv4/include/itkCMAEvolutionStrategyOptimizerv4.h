@@ -0,0 +1,199 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCMAEvolutionStrategyOptimizerv4_h
+#define itkCMAEvolutionStrategyOptimizerv4_h
+
+#include "itkObjectToObjectOptimizerBase.h"
+#include "vnl/vnl_matrix.h"
+#include "vnl/vnl_vector.h"
+#include <functional>
+
+namespace itk
+{
+/**
+ * \class CMAEvolutionStrategyOptimizerv4Template
+ * \brief Covariance matrix adaptation evolution strategy (CMA-ES) optimizer.
+ *
+ * At each generation, a population of candidate parameters is sampled from a
+ * multivariate normal distribution, the candidates are ranked by their metric
+ * value, and the mean, the covariance matrix and the step size of the
+ * distribution are adapted from the best half of the population.  The metric
+ * is minimized and its derivative is not used.
+ *
+ * The search is performed in the space of the parameters multiplied by the
+ * scales, so that the initial step size (SetInitialSigma) applies equally to
+ * all the parameters.
+ *
+ * The candidates of a generation are independent, so they can be evaluated
+ * concurrently.  This requires a function that creates a copy of the metric,
+ * with its own transform, for each work unit (SetMetricCloneFunction).  The
+ * metric copies are evaluated from within the work units of this optimizer, so
+ * they should be restricted to a single work unit.  The candidates are drawn
+ * from a single random number generator and ranked by value and then by
+ * index, so the result only depends on the random seed, not on the number of
+ * work units.  When no clone function is set, the candidates are evaluated
+ * sequentially with the metric of the optimizer.
+ *
+ * The optimization stops after the maximum number of generations
+ * (SetNumberOfIterations), or when the step size along the largest axis of
+ * the distribution becomes smaller than Epsilon.  At the end, the metric is set
+ * to the best visited parameters.
+ *
+ * For more details, refer to
+ * "The CMA Evolution Strategy: A Tutorial"
+ * Nikolaus Hansen, arXiv:1604.00772, 2016.
+ *
+ * \sa OnePlusOneEvolutionaryOptimizerv4
+ * \ingroup ITKOptimizersv4
+ */
+template <typename TInternalComputationValueType>
+class ITK_TEMPLATE_EXPORT CMAEvolutionStrategyOptimizerv4Template
+  : public ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CMAEvolutionStrategyOptimizerv4Template);
+
+  /** Standard class type aliases. */
+  using Self = CMAEvolutionStrategyOptimizerv4Template;
+  using Superclass = ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(CMAEvolutionStrategyOptimizerv4Template, Superclass);
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** It should be possible to derive the internal computation type from the class object. */
+  using InternalComputationValueType = TInternalComputationValueType;
+
+  using typename Superclass::MetricType;
+  using MetricTypePointer = typename MetricType::Pointer;
+  using typename Superclass::MeasureType;
+  using typename Superclass::ParametersType;
+  using typename Superclass::ScalesType;
+  using typename Superclass::StopConditionReturnStringType;
+  using typename Superclass::StopConditionDescriptionType;
+
+  /** Function creating an independent copy of the metric, used to evaluate
+   * the candidates concurrently. */
+  using MetricCloneFunctionType = std::function<MetricTypePointer()>;
+
+  /** Type of the seed of the random number generator. */
+  using SeedType = uint32_t;
+
+  /** Set/Get the number of candidates per generation. When zero, the
+   * default population size 4 + floor(3 ln(n)) is used, with n the number of
+   * parameters. Otherwise it must be at least 2, so that the best half of a
+   * generation is not empty. */
+  itkSetMacro(PopulationSize, SizeValueType);
+  itkGetConstMacro(PopulationSize, SizeValueType);
+
+  /** Set/Get the initial step size, in scaled parameter units. */
+  itkSetMacro(InitialSigma, double);
+  itkGetConstMacro(InitialSigma, double);
+
+  /** Set/Get the minimal step size along the largest axis of the search
+   * distribution, in scaled parameter units. */
+  itkSetMacro(Epsilon, double);
+  itkGetConstMacro(Epsilon, double);
+
+  /** Set/Get the seed of the random number generator. */
+  itkSetMacro(RandomSeed, SeedType);
+  itkGetConstMacro(RandomSeed, SeedType);
+
+  /** Set/Get whether exceptions thrown by the metric are caught, in which case
+   * the candidate is given the value MetricWorstPossibleValue. */
+  itkSetMacro(CatchGetValueException, bool);
+  itkGetConstReferenceMacro(CatchGetValueException, bool);
+  itkBooleanMacro(CatchGetValueException);
+
+  itkSetMacro(MetricWorstPossibleValue, MeasureType);
+  itkGetConstReferenceMacro(MetricWorstPossibleValue, MeasureType);
+
+  /** Get the current step size. */
+  itkGetConstMacro(CurrentSigma, double);
+
+  /** Get the best visited parameters. */
+  itkGetConstReferenceMacro(BestParameters, ParametersType);
+
+  /** Get the stop condition. */
+  itkGetConstReferenceMacro(StopCondition, StopConditionObjectToObjectOptimizerEnum);
+
+  /** Set the function that creates a copy of the metric, with its own
+   * transform, for each work unit evaluating the candidates concurrently. */
+  void
+  SetMetricCloneFunction(const MetricCloneFunctionType & cloneFunction);
+
+  /** Start the optimization. */
+  void
+  StartOptimization(bool doOnlyInitialization = false) override;
+
+  /** Stop the optimization at the end of the current generation. */
+  virtual void
+  StopOptimization();
+
+  /** Get the reason for termination. */
+  const StopConditionReturnStringType
+  GetStopConditionDescription() const override;
+
+protected:
+  CMAEvolutionStrategyOptimizerv4Template();
+  ~CMAEvolutionStrategyOptimizerv4Template() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Evaluate the metric at the given candidates (in scaled parameter space). */
+  void
+  EvaluateCandidates(const std::vector<vnl_vector<double>> & candidates, std::vector<MeasureType> & values);
+
+  /** Evaluate the metric at the given candidate with the given metric. */
+  MeasureType
+  EvaluateCandidate(MetricType * metric, const vnl_vector<double> & candidate) const;
+
+private:
+  SizeValueType m_PopulationSize{ 0 };
+  double        m_InitialSigma{ 1.0 };
+  double        m_Epsilon{ 1e-6 };
+  SeedType      m_RandomSeed{ 121212 };
+  bool          m_CatchGetValueException{ false };
+  MeasureType   m_MetricWorstPossibleValue{ NumericTraits<MeasureType>::max() };
+  double        m_CurrentSigma{ 0.0 };
+  bool          m_Stop{ false };
+
+  ParametersType                           m_BestParameters;
+  StopConditionObjectToObjectOptimizerEnum m_StopCondition{
+    StopConditionObjectToObjectOptimizerEnum::MAXIMUM_NUMBER_OF_ITERATIONS
+  };
+  StopConditionDescriptionType   m_StopConditionDescription;
+  MetricCloneFunctionType        m_MetricCloneFunction;
+  std::vector<MetricTypePointer> m_MetricClones;
+};
+
+/** This helps to meet backward compatibility */
+using CMAEvolutionStrategyOptimizerv4 = CMAEvolutionStrategyOptimizerv4Template<double>;
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCMAEvolutionStrategyOptimizerv4.hxx"
+#endif
+
+#endif
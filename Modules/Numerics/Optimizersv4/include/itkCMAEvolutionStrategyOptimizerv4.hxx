@@ -0,0 +1,373 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCMAEvolutionStrategyOptimizerv4_hxx
+#define itkCMAEvolutionStrategyOptimizerv4_hxx
+
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkMultiThreaderBase.h"
+#include "vnl/algo/vnl_symmetric_eigensystem.h"
+#include <algorithm>
+#include <numeric>
+
+namespace itk
+{
+
+template <typename TInternalComputationValueType>
+CMAEvolutionStrategyOptimizerv4Template<TInternalComputationValueType>::CMAEvolutionStrategyOptimizerv4Template()
+{
+  this->m_NumberOfIterations = 100;
+}
+
+template <typename TInternalComputationValueType>
+void
+CMAEvolutionStrategyOptimizerv4Template<TInternalComputationValueType>::SetMetricCloneFunction(
+  const MetricCloneFunctionType & cloneFunction)
+{
+  this->m_MetricCloneFunction = cloneFunction;
+  this->Modified();
+}
+
+template <typename TInternalComputationValueType>
+void
+CMAEvolutionStrategyOptimizerv4Template<TInternalComputationValueType>::StopOptimization()
+{
+  itkDebugMacro("StopOptimization called with a description - " << this->GetStopConditionDescription());
+  this->m_Stop = true;
+}
+
+template <typename TInternalComputationValueType>
+auto
+CMAEvolutionStrategyOptimizerv4Template<TInternalComputationValueType>::GetStopConditionDescription() const
+  -> const StopConditionReturnStringType
+{
+  return this->m_StopConditionDescription.str();
+}
+
+template <typename TInternalComputationValueType>
+auto
+CMAEvolutionStrategyOptimizerv4Template<TInternalComputationValueType>::EvaluateCandidate(
+  MetricType *               metric,
+  const vnl_vector<double> & candidate) const -> MeasureType
+{
+  const ScalesType & scales = this->GetScales();
+
+  ParametersType parameters(static_cast<SizeValueType>(candidate.size()));
+  for (unsigned int i = 0; i < candidate.size(); ++i)
+  {
+    parameters[i] = candidate[i] / scales[i];
+  }
+
+  try
+  {
+    metric->SetParameters(parameters);
+    return metric->GetValue();
+  }
+  catch (...)
+  {
+    if (this->m_CatchGetValueException)
+    {
+      return this->m_MetricWorstPossibleValue;
+    }
+    throw;
+  }
+}
+
+template <typename TInternalComputationValueType>
+void
+CMAEvolutionStrategyOptimizerv4Template<TInternalComputationValueType>::EvaluateCandidates(
+  const std::vector<vnl_vector<double>> & candidates,
+  std::vector<MeasureType> &              values)
+{
+  const SizeValueType numberOfCandidates = candidates.size();
+  values.resize(numberOfCandidates);
+
+  if (this->m_MetricClones.empty())
+  {
+    for (SizeValueType k = 0; k < numberOfCandidates; ++k)
+    {
+      values[k] = this->EvaluateCandidate(this->m_Metric, candidates[k]);
+    }
+    return;
+  }
+
+  // Each work unit evaluates its candidates with its own copy of the metric
+  const auto numberOfClones = static_cast<SizeValueType>(this->m_MetricClones.size());
+
+  auto multiThreader = MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(static_cast<ThreadIdType>(numberOfClones));
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfClones,
+    [&](SizeValueType clone) {
+      for (SizeValueType k = clone; k < numberOfCandidates; k += numberOfClones)
+      {
+        values[k] = this->EvaluateCandidate(this->m_MetricClones[clone], candidates[k]);
+      }
+    },
+    nullptr);
+}
+
+template <typename TInternalComputationValueType>
+void
+CMAEvolutionStrategyOptimizerv4Template<TInternalComputationValueType>::StartOptimization(bool doOnlyInitialization)
+{
+  itkDebugMacro("StartOptimization");
+
+  // Validates the metric and sets the default scales
+  Superclass::StartOptimization(doOnlyInitialization);
+
+  const unsigned int n = this->m_Metric->GetNumberOfParameters();
+  const ScalesType & scales = this->GetScales();
+  if (scales.size() != n)
+  {
+    itkExceptionMacro(<< "The size of Scales is " << scales.size()
+                      << ", but the NumberOfParameters for the CostFunction is " << n << '.');
+  }
+
+  if (this->m_PopulationSize == 1)
+  {
+    itkExceptionMacro(<< "The PopulationSize must be 0, to use the default population size, or at least 2.");
+  }
+
+  // Strategy parameters, following Hansen's tutorial
+  const SizeValueType lambda =
+    this->m_PopulationSize > 0 ? this->m_PopulationSize
+                               : static_cast<SizeValueType>(4 + std::floor(3.0 * std::log(static_cast<double>(n))));
+  const SizeValueType mu = lambda / 2;
+
+  std::vector<double> weights(mu);
+  for (SizeValueType i = 0; i < mu; ++i)
+  {
+    weights[i] = std::log(static_cast<double>(mu) + 0.5) - std::log(static_cast<double>(i + 1));
+  }
+  const double weightsSum = std::accumulate(weights.begin(), weights.end(), 0.0);
+  double       weightsSquaredSum = 0.0;
+  for (double & weight : weights)
+  {
+    weight /= weightsSum;
+    weightsSquaredSum += weight * weight;
+  }
+  const double muEff = 1.0 / weightsSquaredSum;
+
+  const auto   dimension = static_cast<double>(n);
+  const double cSigma = (muEff + 2.0) / (dimension + muEff + 5.0);
+  const double dSigma = 1.0 + 2.0 * std::max(0.0, std::sqrt((muEff - 1.0) / (dimension + 1.0)) - 1.0) + cSigma;
+  const double cC = (4.0 + muEff / dimension) / (dimension + 4.0 + 2.0 * muEff / dimension);
+  const double c1 = 2.0 / ((dimension + 1.3) * (dimension + 1.3) + muEff);
+  const double cMu =
+    std::min(1.0 - c1, 2.0 * (muEff - 2.0 + 1.0 / muEff) / ((dimension + 2.0) * (dimension + 2.0) + muEff));
+  const double chiN = std::sqrt(dimension) * (1.0 - 1.0 / (4.0 * dimension) + 1.0 / (21.0 * dimension * dimension));
+
+  // Dynamic state of the search distribution, in scaled parameter space
+  const ParametersType initialParameters = this->m_Metric->GetParameters();
+  vnl_vector<double>   mean(n);
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    mean[i] = initialParameters[i] * scales[i];
+  }
+  vnl_vector<double> pathSigma(n, 0.0);
+  vnl_vector<double> pathC(n, 0.0);
+  vnl_matrix<double> covariance(n, n);
+  covariance.set_identity();
+  vnl_matrix<double> axes(n, n);
+  axes.set_identity();
+  vnl_vector<double> axesLengths(n, 1.0);
+  this->m_CurrentSigma = this->m_InitialSigma;
+
+  this->m_BestParameters = initialParameters;
+  this->m_CurrentMetricValue = this->EvaluateCandidate(this->m_Metric, mean);
+  this->m_CurrentIteration = 0;
+  this->m_StopCondition = StopConditionObjectToObjectOptimizerEnum::MAXIMUM_NUMBER_OF_ITERATIONS;
+  this->m_StopConditionDescription.str("");
+  this->m_StopConditionDescription << this->GetNameOfClass() << ": ";
+
+  this->m_MetricClones.clear();
+  if (this->m_MetricCloneFunction && this->m_NumberOfWorkUnits > 1)
+  {
+    const SizeValueType numberOfClones = std::min<SizeValueType>(this->m_NumberOfWorkUnits, lambda);
+    for (SizeValueType clone = 0; clone < numberOfClones; ++clone)
+    {
+      MetricTypePointer metric = this->m_MetricCloneFunction();
+      if (metric.IsNull())
+      {
+        itkExceptionMacro("The metric clone function returned a null metric.");
+      }
+      this->m_MetricClones.push_back(metric);
+    }
+  }
+
+  if (doOnlyInitialization)
+  {
+    return;
+  }
+
+  using RandomizerType = Statistics::MersenneTwisterRandomVariateGenerator;
+  auto randomizer = RandomizerType::New();
+  randomizer->SetSeed(this->m_RandomSeed);
+
+  std::vector<vnl_vector<double>> steps(lambda, vnl_vector<double>(n));
+  std::vector<vnl_vector<double>> candidates(lambda, vnl_vector<double>(n));
+  std::vector<MeasureType>        values(lambda);
+  std::vector<SizeValueType>      ranking(lambda);
+
+  this->InvokeEvent(StartEvent());
+
+  this->m_Stop = false;
+  while (!this->m_Stop)
+  {
+    if (this->m_CurrentIteration >= this->m_NumberOfIterations)
+    {
+      this->m_StopConditionDescription << "Maximum number of iterations (" << this->m_NumberOfIterations
+                                       << ") exceeded.";
+      this->m_StopCondition = StopConditionObjectToObjectOptimizerEnum::MAXIMUM_NUMBER_OF_ITERATIONS;
+      break;
+    }
+
+    // Sample the generation sequentially, so it does not depend on the number of work units
+    vnl_vector<double> z(n);
+    for (SizeValueType k = 0; k < lambda; ++k)
+    {
+      for (unsigned int i = 0; i < n; ++i)
+      {
+        z[i] = axesLengths[i] * randomizer->GetNormalVariate();
+      }
+      steps[k] = axes * z;
+      candidates[k] = mean + this->m_CurrentSigma * steps[k];
+    }
+
+    this->EvaluateCandidates(candidates, values);
+
+    // Rank by value, ties broken by candidate index
+    std::iota(ranking.begin(), ranking.end(), SizeValueType{ 0 });
+    std::stable_sort(ranking.begin(), ranking.end(), [&values](SizeValueType a, SizeValueType b) {
+      return values[a] < values[b];
+    });
+
+    if (values[ranking[0]] < this->m_CurrentMetricValue)
+    {
+      this->m_CurrentMetricValue = values[ranking[0]];
+      for (unsigned int i = 0; i < n; ++i)
+      {
+        this->m_BestParameters[i] = candidates[ranking[0]][i] / scales[i];
+      }
+    }
+
+    // Recombination of the best half of the population
+    vnl_vector<double> meanStep(n, 0.0);
+    for (SizeValueType i = 0; i < mu; ++i)
+    {
+      meanStep += weights[i] * steps[ranking[i]];
+    }
+    mean += this->m_CurrentSigma * meanStep;
+
+    // Step size control: C^{-1/2} * meanStep
+    vnl_vector<double> whitenedStep = axes.transpose() * meanStep;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+      whitenedStep[i] /= axesLengths[i];
+    }
+    pathSigma = (1.0 - cSigma) * pathSigma + std::sqrt(cSigma * (2.0 - cSigma) * muEff) * (axes * whitenedStep);
+
+    const double pathSigmaNorm = pathSigma.two_norm();
+    const double hSigmaThreshold =
+      (1.4 + 2.0 / (dimension + 1.0)) * chiN *
+      std::sqrt(1.0 - std::pow(1.0 - cSigma, 2.0 * static_cast<double>(this->m_CurrentIteration + 1)));
+    const double hSigma = pathSigmaNorm < hSigmaThreshold ? 1.0 : 0.0;
+
+    // Covariance matrix adaptation
+    pathC = (1.0 - cC) * pathC + hSigma * std::sqrt(cC * (2.0 - cC) * muEff) * meanStep;
+
+    vnl_matrix<double> rankMuUpdate(n, n, 0.0);
+    for (SizeValueType i = 0; i < mu; ++i)
+    {
+      const vnl_vector<double> & step = steps[ranking[i]];
+      for (unsigned int r = 0; r < n; ++r)
+      {
+        for (unsigned int c = 0; c < n; ++c)
+        {
+          rankMuUpdate(r, c) += weights[i] * step[r] * step[c];
+        }
+      }
+    }
+    const double oldCovarianceWeight = 1.0 - c1 - cMu + c1 * (1.0 - hSigma) * cC * (2.0 - cC);
+    for (unsigned int r = 0; r < n; ++r)
+    {
+      for (unsigned int c = 0; c < n; ++c)
+      {
+        covariance(r, c) =
+          oldCovarianceWeight * covariance(r, c) + c1 * pathC[r] * pathC[c] + cMu * rankMuUpdate(r, c);
+      }
+    }
+
+    this->m_CurrentSigma *= std::exp((cSigma / dSigma) * (pathSigmaNorm / chiN - 1.0));
+
+    // Decompose C = B D^2 B^T
+    const vnl_symmetric_eigensystem<double> eigenSystem(covariance);
+    axes = eigenSystem.V;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+      axesLengths[i] = std::sqrt(std::max(eigenSystem.D(i, i), 0.0));
+    }
+
+    this->InvokeEvent(IterationEvent());
+    ++this->m_CurrentIteration;
+
+    if (this->m_Stop)
+    {
+      this->m_StopConditionDescription << "StopOptimization() called";
+      break;
+    }
+
+    if (this->m_CurrentSigma * axesLengths.max_value() < this->m_Epsilon)
+    {
+      this->m_StopConditionDescription << "Step size (" << this->m_CurrentSigma * axesLengths.max_value()
+                                       << ") smaller than epsilon (" << this->m_Epsilon << ").";
+      this->m_StopCondition = StopConditionObjectToObjectOptimizerEnum::STEP_TOO_SMALL;
+      break;
+    }
+  }
+
+  this->m_Stop = true;
+  this->m_MetricClones.clear();
+  this->m_Metric->SetParameters(this->m_BestParameters);
+  this->InvokeEvent(EndEvent());
+}
+
+template <typename TInternalComputationValueType>
+void
+CMAEvolutionStrategyOptimizerv4Template<TInternalComputationValueType>::PrintSelf(std::ostream & os,
+                                                                                  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "PopulationSize: " << this->m_PopulationSize << std::endl;
+  os << indent << "InitialSigma: " << this->m_InitialSigma << std::endl;
+  os << indent << "Epsilon: " << this->m_Epsilon << std::endl;
+  os << indent << "RandomSeed: " << this->m_RandomSeed << std::endl;
+  os << indent << "CatchGetValueException: " << (this->m_CatchGetValueException ? "On" : "Off") << std::endl;
+  os << indent << "MetricWorstPossibleValue: " << this->m_MetricWorstPossibleValue << std::endl;
+  os << indent << "CurrentSigma: " << this->m_CurrentSigma << std::endl;
+  os << indent << "BestParameters: " << this->m_BestParameters << std::endl;
+  os << indent << "StopCondition: " << this->m_StopCondition << std::endl;
+  os << indent << "StopConditionDescription: " << this->m_StopConditionDescription.str() << std::endl;
+  os << indent << "MetricCloneFunction: " << (this->m_MetricCloneFunction ? "set" : "(null)") << std::endl;
+}
+
+} // end namespace itk
+
+#endif
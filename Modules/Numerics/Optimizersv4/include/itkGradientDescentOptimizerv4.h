@@ -154,6 +154,7 @@ public:
    *  checking.
    */
   itkSetMacro(MinimumConvergenceValue, TInternalComputationValueType);
+  itkGetConstReferenceMacro(MinimumConvergenceValue, TInternalComputationValueType);
 
   /** Window size for the convergence checker.
    *  The convergence checker calculates convergence value by fitting to
@@ -164,6 +165,7 @@ public:
    *  checking.
    */
   itkSetMacro(ConvergenceWindowSize, SizeValueType);
+  itkGetConstReferenceMacro(ConvergenceWindowSize, SizeValueType);
 
   /** Get current convergence value.
    *  WindowConvergenceMonitoringFunction always returns output convergence
@@ -20,6 +20,7 @@
 
 #include "itkObjectToObjectOptimizerBase.h"
 #include "itkGradientDescentOptimizerv4.h"
+#include <functional>
 
 namespace itk
 {
@@ -36,6 +37,24 @@ namespace itk
  *   focus modifying the parameter sample space.  This is why we place the burden on the user to provide
  *   the parameter samples over which to optimize.
  *
+ *   The start points are independent, so they can be searched concurrently.  This requires a
+ *   function that creates a copy of the metric, with its own transform, for each work unit
+ *   (SetMetricCloneFunction), and, when a local optimizer is used, a copy of the local optimizer.
+ *   A GradientDescentOptimizerv4Template without scales estimator is copied with its settings, such
+ *   as the one of InstantiateLocalOptimizer; other local optimizers are copied by the function set
+ *   with SetLocalOptimizerCloneFunction.
+ *   The metric copies are evaluated from within the work units of this optimizer, so they should
+ *   be restricted to a single work unit (e.g. ImageToImageMetricv4::SetMaximumNumberOfWorkUnits(1)).
+ *   Each start point is always optimized on its own from the same state, and the best start is
+ *   selected in list order, so the result does not depend on the number of work units.
+ *   When the metric or the local optimizer cannot be copied, the start points are searched
+ *   sequentially.
+ *   When they are searched concurrently, IterationEvent is invoked for each start point, in list
+ *   order, as soon as the start point and the ones before it are finished. The observers are called
+ *   one at a time, from the work unit that finished the start point, while the other work units keep
+ *   searching; the current iteration, metric value and position describe that start point. An
+ *   observer calling StopOptimization() keeps the work units from searching the remaining start points.
+ *
  * \ingroup ITKOptimizersv4
  */
 template <typename TInternalComputationValueType>
@@ -105,6 +124,11 @@ public:
   using typename Superclass::MeasureType;
   using MetricValuesListType = std::vector<MeasureType>;
 
+  /** Functions creating independent copies of the metric and of the local
+   * optimizer, used to search the start points concurrently. */
+  using MetricCloneFunctionType = std::function<MetricTypePointer()>;
+  using LocalOptimizerCloneFunctionType = std::function<OptimizerPointer()>;
+
   /** Get stop condition enum */
   itkGetConstReferenceMacro(StopCondition, StopConditionObjectToObjectOptimizerEnum);
 
@@ -146,10 +170,23 @@ public:
   ParametersType
   GetBestParameters();
 
-  /** Set/Get the optimizer. */
-  itkSetObjectMacro(LocalOptimizer, OptimizerType);
+  /** Set/Get the optimizer. Setting a different local optimizer clears the
+   * local optimizer clone function. */
+  virtual void
+  SetLocalOptimizer(OptimizerType * optimizer);
   itkGetModifiableObjectMacro(LocalOptimizer, OptimizerType);
 
+  /** Set the function that creates a copy of the metric, with its own
+   * transform, for each work unit searching start points concurrently. */
+  void
+  SetMetricCloneFunction(const MetricCloneFunctionType & cloneFunction);
+
+  /** Set the function that creates a copy of the local optimizer for each
+   * work unit searching start points concurrently. It must be set after the
+   * local optimizer. */
+  void
+  SetLocalOptimizerCloneFunction(const LocalOptimizerCloneFunctionType & cloneFunction);
+
   inline ParameterListSizeType
   GetBestParametersIndex()
   {
@@ -164,6 +201,27 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Returns whether the start points can be searched concurrently. */
+  bool
+  CanSearchConcurrently() const;
+
+  /** Returns the local optimizer when it is a gradient descent optimizer
+   * whose settings can be copied, or null. */
+  const LocalOptimizerType *
+  GetCopyableLocalOptimizer() const;
+
+  /** Create a copy of the local optimizer for a work unit, with the clone
+   * function when it is set, and otherwise with the settings of a copyable
+   * local optimizer. Returns null when the local optimizer cannot be copied. */
+  OptimizerPointer
+  CloneLocalOptimizer() const;
+
+  /** Search all the remaining start points concurrently, each work unit
+   * using its own copy of the metric and of the local optimizer, and report
+   * them in order while the search goes on. */
+  void
+  ResumeOptimizationConcurrently();
+
   /* Common variables for optimization control and reporting */
   bool                                     m_Stop{ false };
   StopConditionObjectToObjectOptimizerEnum m_StopCondition;
@@ -174,6 +232,8 @@ protected:
   MeasureType                              m_MaximumMetricValue;
   ParameterListSizeType                    m_BestParametersIndex;
   OptimizerPointer                         m_LocalOptimizer;
+  MetricCloneFunctionType                  m_MetricCloneFunction;
+  LocalOptimizerCloneFunctionType          m_LocalOptimizerCloneFunction;
 };
 
 /** This helps to meet backward compatibility */
@@ -18,6 +18,10 @@
 #ifndef itkMultiStartOptimizerv4_hxx
 #define itkMultiStartOptimizerv4_hxx
 
+#include "itkMultiThreaderBase.h"
+#include <atomic>
+#include <mutex>
+#include <typeinfo>
 
 namespace itk
 {
@@ -45,6 +49,9 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::PrintSelf(std::ost
   Superclass::PrintSelf(os, indent);
   os << indent << "Stop condition:" << this->m_StopCondition << std::endl;
   os << indent << "Stop condition description: " << this->m_StopConditionDescription.str() << std::endl;
+  os << indent << "MetricCloneFunction: " << (this->m_MetricCloneFunction ? "set" : "(null)") << std::endl;
+  os << indent << "LocalOptimizerCloneFunction: " << (this->m_LocalOptimizerCloneFunction ? "set" : "(null)")
+     << std::endl;
 }
 
 //-------------------------------------------------------------------
@@ -94,7 +101,101 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::InstantiateLocalOp
   LocalOptimizerPointer optimizer = LocalOptimizerType::New();
   optimizer->SetLearningRate(static_cast<TInternalComputationValueType>(1.e-1));
   optimizer->SetNumberOfIterations(25);
-  this->m_LocalOptimizer = optimizer;
+  this->SetLocalOptimizer(optimizer);
+}
+
+//-------------------------------------------------------------------
+template <typename TInternalComputationValueType>
+void
+MultiStartOptimizerv4Template<TInternalComputationValueType>::SetLocalOptimizer(OptimizerType * optimizer)
+{
+  if (this->m_LocalOptimizer != optimizer)
+  {
+    this->m_LocalOptimizer = optimizer;
+    this->m_LocalOptimizerCloneFunction = nullptr;
+    this->Modified();
+  }
+}
+
+//-------------------------------------------------------------------
+template <typename TInternalComputationValueType>
+void
+MultiStartOptimizerv4Template<TInternalComputationValueType>::SetMetricCloneFunction(
+  const MetricCloneFunctionType & cloneFunction)
+{
+  this->m_MetricCloneFunction = cloneFunction;
+  this->Modified();
+}
+
+//-------------------------------------------------------------------
+template <typename TInternalComputationValueType>
+void
+MultiStartOptimizerv4Template<TInternalComputationValueType>::SetLocalOptimizerCloneFunction(
+  const LocalOptimizerCloneFunctionType & cloneFunction)
+{
+  this->m_LocalOptimizerCloneFunction = cloneFunction;
+  this->Modified();
+}
+
+//-------------------------------------------------------------------
+template <typename TInternalComputationValueType>
+bool
+MultiStartOptimizerv4Template<TInternalComputationValueType>::CanSearchConcurrently() const
+{
+  return this->m_MetricCloneFunction &&
+         (this->m_LocalOptimizer.IsNull() || this->m_LocalOptimizerCloneFunction ||
+          this->GetCopyableLocalOptimizer() != nullptr) &&
+         this->m_NumberOfWorkUnits > 1 && this->m_CurrentIteration + 1 < this->m_NumberOfIterations;
+}
+
+//-------------------------------------------------------------------
+template <typename TInternalComputationValueType>
+auto
+MultiStartOptimizerv4Template<TInternalComputationValueType>::GetCopyableLocalOptimizer() const
+  -> const LocalOptimizerType *
+{
+  // A derived optimizer has settings that are not copied, and a scales
+  // estimator evaluates the metric it was given, which the copies would share
+  if (this->m_LocalOptimizer.IsNull() || typeid(*this->m_LocalOptimizer) != typeid(LocalOptimizerType))
+  {
+    return nullptr;
+  }
+  const auto * localOptimizer = static_cast<const LocalOptimizerType *>(this->m_LocalOptimizer.GetPointer());
+  if (localOptimizer->GetScalesEstimator() != nullptr)
+  {
+    return nullptr;
+  }
+  return localOptimizer;
+}
+
+//-------------------------------------------------------------------
+template <typename TInternalComputationValueType>
+auto
+MultiStartOptimizerv4Template<TInternalComputationValueType>::CloneLocalOptimizer() const -> OptimizerPointer
+{
+  if (this->m_LocalOptimizerCloneFunction)
+  {
+    return this->m_LocalOptimizerCloneFunction();
+  }
+
+  const LocalOptimizerType * localOptimizer = this->GetCopyableLocalOptimizer();
+  if (localOptimizer == nullptr)
+  {
+    return nullptr;
+  }
+  LocalOptimizerPointer optimizer = LocalOptimizerType::New();
+  optimizer->SetLearningRate(localOptimizer->GetLearningRate());
+  optimizer->SetMaximumStepSizeInPhysicalUnits(localOptimizer->GetMaximumStepSizeInPhysicalUnits());
+  optimizer->SetDoEstimateLearningRateAtEachIteration(localOptimizer->GetDoEstimateLearningRateAtEachIteration());
+  optimizer->SetDoEstimateLearningRateOnce(localOptimizer->GetDoEstimateLearningRateOnce());
+  optimizer->SetMinimumConvergenceValue(localOptimizer->GetMinimumConvergenceValue());
+  optimizer->SetConvergenceWindowSize(localOptimizer->GetConvergenceWindowSize());
+  optimizer->SetReturnBestParametersAndValue(localOptimizer->GetReturnBestParametersAndValue());
+  optimizer->SetNumberOfIterations(localOptimizer->GetNumberOfIterations());
+  optimizer->SetScales(localOptimizer->GetScales());
+  optimizer->SetWeights(localOptimizer->GetWeights());
+  optimizer->SetDoEstimateScales(localOptimizer->GetDoEstimateScales());
+  return optimizer.GetPointer();
 }
 
 //-------------------------------------------------------------------
@@ -162,6 +263,12 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimization
   this->InvokeEvent(StartEvent());
 
   this->m_Stop = false;
+  if (this->CanSearchConcurrently())
+  {
+    this->ResumeOptimizationConcurrently();
+    return;
+  }
+
   while (!this->m_Stop)
   {
     /* Compute metric value */
@@ -215,6 +322,142 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimization
   } // while (!m_Stop)
 }
 
+/**
+ * Resume optimization, searching the start points concurrently.
+ */
+template <typename TInternalComputationValueType>
+void
+MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimizationConcurrently()
+{
+  const SizeValueType firstStart = this->m_CurrentIteration;
+  const SizeValueType numberOfStarts = this->m_NumberOfIterations - firstStart;
+  const auto          numberOfWorkUnits =
+    static_cast<ThreadIdType>(std::min<SizeValueType>(this->m_NumberOfWorkUnits, numberOfStarts));
+
+  // Each work unit searches its start points with its own metric and local optimizer
+  std::vector<MetricTypePointer> metrics(numberOfWorkUnits);
+  std::vector<OptimizerPointer>  localOptimizers(numberOfWorkUnits);
+  for (ThreadIdType workUnit = 0; workUnit < numberOfWorkUnits; ++workUnit)
+  {
+    metrics[workUnit] = this->m_MetricCloneFunction();
+    if (metrics[workUnit].IsNull())
+    {
+      itkExceptionMacro("The metric clone function returned a null metric.");
+    }
+    if (this->m_LocalOptimizer)
+    {
+      localOptimizers[workUnit] = this->CloneLocalOptimizer();
+      if (localOptimizers[workUnit].IsNull())
+      {
+        itkExceptionMacro("The local optimizer could not be copied.");
+      }
+      localOptimizers[workUnit]->SetNumberOfWorkUnits(1);
+    }
+  }
+
+  std::vector<MeasureType>   metricValues(numberOfStarts, this->m_MaximumMetricValue);
+  std::vector<unsigned char> succeeded(numberOfStarts, 0);
+  std::vector<unsigned char> finished(numberOfStarts, 0);
+  SizeValueType              numberOfReportedStarts = 0;
+  std::atomic<bool>          stopped(false);
+  std::mutex                 mutex;
+
+  // Report the finished starts in order, as the sequential search does, as
+  // soon as all the starts before them are finished
+  const auto reportFinishedStarts = [&]() {
+    while (!this->m_Stop && numberOfReportedStarts < numberOfStarts && finished[numberOfReportedStarts])
+    {
+      const SizeValueType i = numberOfReportedStarts;
+      this->m_Metric->SetParameters(this->m_ParametersList[firstStart + i]);
+      if (succeeded[i])
+      {
+        this->m_CurrentMetricValue = metricValues[i];
+        this->m_MetricValuesList.push_back(this->m_CurrentMetricValue);
+        if (this->m_CurrentMetricValue < this->m_MinimumMetricValue)
+        {
+          this->m_MinimumMetricValue = this->m_CurrentMetricValue;
+          this->m_BestParametersIndex = this->m_CurrentIteration;
+        }
+      }
+      else
+      {
+        itkWarningMacro("An exception occurred in sub-optimization number "
+                        << this->m_CurrentIteration
+                        << ".  If too many of these occur, you may need to set a different set of initial parameters.");
+      }
+
+      if (this->m_Stop)
+      {
+        this->m_StopConditionDescription << "StopOptimization() called";
+        break;
+      }
+
+      this->InvokeEvent(IterationEvent());
+
+      this->m_CurrentIteration++;
+      ++numberOfReportedStarts;
+    }
+    if (this->m_Stop)
+    {
+      stopped = true;
+    }
+  };
+
+  auto multiThreader = MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfWorkUnits,
+    [&](SizeValueType workUnit) {
+      MetricType *    metric = metrics[workUnit];
+      OptimizerType * localOptimizer = localOptimizers[workUnit];
+      for (SizeValueType i = workUnit; i < numberOfStarts && !stopped; i += numberOfWorkUnits)
+      {
+        ParametersType parameters(this->m_ParametersList[firstStart + i]);
+        MeasureType    metricValue = this->m_MaximumMetricValue;
+        bool           optimized = false;
+        bool           startSucceeded = false;
+        try
+        {
+          metric->SetParameters(parameters);
+          if (localOptimizer)
+          {
+            localOptimizer->SetMetric(metric);
+            localOptimizer->StartOptimization();
+            parameters = metric->GetParameters();
+            optimized = true;
+          }
+          metricValue = metric->GetValue();
+          startSucceeded = true;
+        }
+        catch (const ExceptionObject &)
+        {
+          // A bad starting point, reported with the others
+        }
+
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (optimized)
+        {
+          this->m_ParametersList[firstStart + i] = parameters;
+        }
+        metricValues[i] = metricValue;
+        succeeded[i] = startSucceeded;
+        finished[i] = 1;
+        reportFinishedStarts();
+      }
+    },
+    nullptr);
+
+  if (this->m_Stop)
+  {
+    return;
+  }
+
+  this->m_StopConditionDescription << "Maximum number of iterations (" << this->m_NumberOfIterations << ") exceeded.";
+  this->m_StopCondition = StopConditionObjectToObjectOptimizerEnum::MAXIMUM_NUMBER_OF_ITERATIONS;
+  this->StopOptimization();
+}
+
 } // namespace itk
 
 #endif
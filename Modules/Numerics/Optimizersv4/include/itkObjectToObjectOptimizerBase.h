@@ -206,6 +206,7 @@ public:
    * \sa SetDoEstimateScales()
    */
   itkSetObjectMacro(ScalesEstimator, ScalesEstimatorType);
+  itkGetConstObjectMacro(ScalesEstimator, ScalesEstimatorType);
 
   /** Option to use ScalesEstimator for scales estimation.
    * The estimation is performed once at begin of
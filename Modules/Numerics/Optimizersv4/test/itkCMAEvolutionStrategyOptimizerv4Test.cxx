@@ -0,0 +1,235 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkCMAEvolutionStrategyOptimizerv4.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+/**
+ * \class CMAEvolutionStrategyOptimizerv4TestMetric
+ *
+ *  The objective function is the Rosenbrock function
+ *
+ *  (1 - x)^2 + 100 (y - x^2)^2
+ *
+ *  whose minimum is at | 1 1 |, at the end of a curved valley.
+ */
+class CMAEvolutionStrategyOptimizerv4TestMetric : public itk::ObjectToObjectMetricBase
+{
+public:
+  using Self = CMAEvolutionStrategyOptimizerv4TestMetric;
+  using Superclass = itk::ObjectToObjectMetricBase;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+  itkNewMacro(Self);
+  itkTypeMacro(CMAEvolutionStrategyOptimizerv4TestMetric, ObjectToObjectMetricBase);
+
+  enum
+  {
+    SpaceDimension = 2
+  };
+
+  using ParametersType = Superclass::ParametersType;
+  using DerivativeType = Superclass::DerivativeType;
+  using MeasureType = Superclass::MeasureType;
+
+  CMAEvolutionStrategyOptimizerv4TestMetric()
+  {
+    m_Parameters.SetSize(SpaceDimension);
+    m_Parameters.Fill(0);
+  }
+
+  void
+  Initialize() override
+  {}
+
+  MeasureType
+  GetValue() const override
+  {
+    const double x = m_Parameters[0];
+    const double y = m_Parameters[1];
+    return (1.0 - x) * (1.0 - x) + 100.0 * (y - x * x) * (y - x * x);
+  }
+
+  void
+  GetDerivative(DerivativeType &) const override
+  {
+    itkGenericExceptionMacro("CMAEvolutionStrategyOptimizerv4 is not supposed to call GetDerivative()");
+  }
+
+  void
+  GetValueAndDerivative(MeasureType & value, DerivativeType & derivative) const override
+  {
+    value = GetValue();
+    GetDerivative(derivative);
+  }
+
+  unsigned int
+  GetNumberOfLocalParameters() const override
+  {
+    return SpaceDimension;
+  }
+
+  unsigned int
+  GetNumberOfParameters() const override
+  {
+    return SpaceDimension;
+  }
+
+  void
+  SetParameters(ParametersType & parameters) override
+  {
+    m_Parameters = parameters;
+  }
+
+  const ParametersType &
+  GetParameters() const override
+  {
+    return m_Parameters;
+  }
+
+  bool
+  HasLocalSupport() const override
+  {
+    return false;
+  }
+
+  void
+  UpdateTransformParameters(const DerivativeType &, ParametersValueType) override
+  {}
+
+private:
+  ParametersType m_Parameters;
+};
+
+int
+CMAEvolutionStrategyOptimizerv4RunTest(itk::CMAEvolutionStrategyOptimizerv4 *                 optimizer,
+                                       itk::CMAEvolutionStrategyOptimizerv4::ParametersType & finalPosition)
+{
+  using ParametersType = itk::CMAEvolutionStrategyOptimizerv4::ParametersType;
+
+  auto           metric = CMAEvolutionStrategyOptimizerv4TestMetric::New();
+  ParametersType initialPosition(2);
+  initialPosition[0] = -1.2;
+  initialPosition[1] = 1.0;
+  metric->SetParameters(initialPosition);
+  optimizer->SetMetric(metric);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(optimizer->StartOptimization());
+
+  finalPosition = metric->GetParameters();
+  std::cout << "Stop condition: " << optimizer->GetStopConditionDescription() << std::endl;
+  std::cout << "Number of generations: " << optimizer->GetCurrentIteration() << std::endl;
+  std::cout << "Solution: " << finalPosition << " value: " << optimizer->GetValue() << std::endl;
+
+  for (unsigned int j = 0; j < 2; ++j)
+  {
+    if (itk::Math::abs(finalPosition[j] - 1.0) > 0.01)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Solution is not within tolerance of | 1 1 |: " << finalPosition << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkCMAEvolutionStrategyOptimizerv4Test(int, char *[])
+{
+  using OptimizerType = itk::CMAEvolutionStrategyOptimizerv4;
+  auto optimizer = OptimizerType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    optimizer, CMAEvolutionStrategyOptimizerv4Template, ObjectToObjectOptimizerBaseTemplate);
+
+  itk::SizeValueType populationSize = 12;
+  optimizer->SetPopulationSize(populationSize);
+  ITK_TEST_SET_GET_VALUE(populationSize, optimizer->GetPopulationSize());
+
+  double initialSigma = 0.5;
+  optimizer->SetInitialSigma(initialSigma);
+  ITK_TEST_SET_GET_VALUE(initialSigma, optimizer->GetInitialSigma());
+
+  double epsilon = 1e-8;
+  optimizer->SetEpsilon(epsilon);
+  ITK_TEST_SET_GET_VALUE(epsilon, optimizer->GetEpsilon());
+
+  OptimizerType::SeedType randomSeed = 2023;
+  optimizer->SetRandomSeed(randomSeed);
+  ITK_TEST_SET_GET_VALUE(randomSeed, optimizer->GetRandomSeed());
+
+  bool catchGetValueException = false;
+  ITK_TEST_SET_GET_BOOLEAN(optimizer, CatchGetValueException, catchGetValueException);
+
+  optimizer->SetNumberOfIterations(1000);
+
+  // Sequential evaluation of the candidates
+  optimizer->SetNumberOfWorkUnits(1);
+  OptimizerType::ParametersType sequentialPosition;
+  if (CMAEvolutionStrategyOptimizerv4RunTest(optimizer, sequentialPosition) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_EQUAL(optimizer->GetStopCondition(), itk::StopConditionObjectToObjectOptimizerEnum::STEP_TOO_SMALL);
+
+  // Concurrent evaluation of the candidates, on copies of the metric, must give the same result
+  optimizer->SetMetricCloneFunction([]() -> OptimizerType::MetricTypePointer {
+    auto metric = CMAEvolutionStrategyOptimizerv4TestMetric::New();
+    return metric.GetPointer();
+  });
+  for (itk::ThreadIdType numberOfWorkUnits : { 3, 8 })
+  {
+    optimizer->SetNumberOfWorkUnits(numberOfWorkUnits);
+    OptimizerType::ParametersType concurrentPosition;
+    if (CMAEvolutionStrategyOptimizerv4RunTest(optimizer, concurrentPosition) != EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+    if (concurrentPosition != sequentialPosition)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The solution with " << numberOfWorkUnits << " work units (" << concurrentPosition
+                << ") differs from the sequential solution (" << sequentialPosition << ")." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The optimization stops after the maximum number of generations
+  optimizer->SetNumberOfIterations(2);
+  auto                          metric = CMAEvolutionStrategyOptimizerv4TestMetric::New();
+  OptimizerType::ParametersType initialPosition(2);
+  initialPosition.Fill(0.0);
+  metric->SetParameters(initialPosition);
+  optimizer->SetMetric(metric);
+  ITK_TRY_EXPECT_NO_EXCEPTION(optimizer->StartOptimization());
+  ITK_TEST_EXPECT_EQUAL(optimizer->GetCurrentIteration(), 2);
+  ITK_TEST_EXPECT_EQUAL(optimizer->GetStopCondition(),
+                        itk::StopConditionObjectToObjectOptimizerEnum::MAXIMUM_NUMBER_OF_ITERATIONS);
+
+  // A generation of a single candidate has no best half to recombine
+  optimizer->SetPopulationSize(1);
+  ITK_TRY_EXPECT_EXCEPTION(optimizer->StartOptimization());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
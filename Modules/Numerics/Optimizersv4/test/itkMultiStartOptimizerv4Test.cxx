@@ -303,5 +303,129 @@ itkMultiStartOptimizerv4Test(int, char *[])
     return EXIT_FAILURE;
   }
   std::cout << "Test 3 passed." << std::endl;
+
+  /*
+   * Test 4
+   */
+  std::cout << "Test optimization 4: concurrent starts with the default local optimizer" << std::endl;
+  itkOptimizer->InstantiateLocalOptimizer();
+  unsigned int numberOfMetricClones = 0;
+  itkOptimizer->SetMetricCloneFunction([&numberOfMetricClones]() -> OptimizerType::MetricTypePointer {
+    ++numberOfMetricClones;
+    auto metricClone = MultiStartOptimizerv4TestMetric::New();
+    return metricClone.GetPointer();
+  });
+  parametersList.clear();
+  for (int i = -9; i < 12; i += 3)
+  {
+    for (int j = -9; j < 12; j += 3)
+    {
+      ParametersType testPosition(spaceDimension);
+      testPosition[0] = static_cast<double>(i);
+      testPosition[1] = static_cast<double>(j);
+      parametersList.push_back(testPosition);
+    }
+  }
+  const OptimizerType::ParametersListType startParametersList = parametersList;
+
+  itkOptimizer->SetNumberOfWorkUnits(1);
+  metric->SetParameters(parametersList[0]);
+  itkOptimizer->SetParametersList(parametersList);
+  if (MultiStartOptimizerv4RunTest(itkOptimizer) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  const OptimizerType::ParametersListType    sequentialParametersList = itkOptimizer->GetParametersList();
+  const OptimizerType::MetricValuesListType  sequentialMetricValuesList = itkOptimizer->GetMetricValuesList();
+  const OptimizerType::ParameterListSizeType sequentialBestParametersIndex = itkOptimizer->GetBestParametersIndex();
+
+  parametersList = startParametersList;
+  itkOptimizer->SetNumberOfWorkUnits(4);
+  metric->SetParameters(parametersList[0]);
+  itkOptimizer->SetParametersList(parametersList);
+  if (MultiStartOptimizerv4RunTest(itkOptimizer) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_EQUAL(itkOptimizer->GetBestParametersIndex(), sequentialBestParametersIndex);
+  ITK_TEST_EXPECT_TRUE(itkOptimizer->GetParametersList() == sequentialParametersList);
+  ITK_TEST_EXPECT_TRUE(itkOptimizer->GetMetricValuesList() == sequentialMetricValuesList);
+  ITK_TEST_EXPECT_TRUE(numberOfMetricClones > 0);
+  std::cout << "Test 4 passed." << std::endl;
+
+  /*
+   * Test 5
+   */
+  std::cout << "Test optimization 5: concurrent starts with the settings of the local optimizer passed by user"
+            << std::endl;
+  optimizer = OptimizerType::LocalOptimizerType::New();
+  optimizer->SetLearningRate(2.e-1);
+  optimizer->SetNumberOfIterations(40);
+  itkOptimizer->SetLocalOptimizer(optimizer);
+
+  itkOptimizer->SetNumberOfWorkUnits(1);
+  parametersList = startParametersList;
+  metric->SetParameters(parametersList[0]);
+  itkOptimizer->SetParametersList(parametersList);
+  if (MultiStartOptimizerv4RunTest(itkOptimizer) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  const OptimizerType::ParametersListType userSequentialParametersList = itkOptimizer->GetParametersList();
+  ITK_TEST_EXPECT_TRUE(userSequentialParametersList != sequentialParametersList);
+
+  numberOfMetricClones = 0;
+  itkOptimizer->SetNumberOfWorkUnits(4);
+  parametersList = startParametersList;
+  metric->SetParameters(parametersList[0]);
+  itkOptimizer->SetParametersList(parametersList);
+  if (MultiStartOptimizerv4RunTest(itkOptimizer) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_TRUE(numberOfMetricClones > 0);
+  ITK_TEST_EXPECT_TRUE(itkOptimizer->GetParametersList() == userSequentialParametersList);
+  std::cout << "Test 5 passed." << std::endl;
+
+  /*
+   * Test 6
+   */
+  std::cout << "Test optimization 6: iteration events and stop of the concurrent starts" << std::endl;
+  std::vector<itk::SizeValueType>   eventIterations;
+  OptimizerType::ParametersListType eventPositions;
+  itk::SizeValueType                stopIteration = parametersList.size();
+
+  const unsigned long observerTag = itkOptimizer->AddObserver(itk::IterationEvent(), [&](const itk::EventObject &) {
+    eventIterations.push_back(itkOptimizer->GetCurrentIteration());
+    eventPositions.push_back(itkOptimizer->GetCurrentPosition());
+    if (itkOptimizer->GetCurrentIteration() == stopIteration)
+    {
+      itkOptimizer->StopOptimization();
+    }
+  });
+
+  parametersList = startParametersList;
+  metric->SetParameters(parametersList[0]);
+  itkOptimizer->SetParametersList(parametersList);
+  itkOptimizer->StartOptimization();
+  ITK_TEST_EXPECT_EQUAL(eventIterations.size(), startParametersList.size());
+  for (itk::SizeValueType i = 0; i < eventIterations.size(); ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL(eventIterations[i], i);
+  }
+  ITK_TEST_EXPECT_TRUE(eventPositions == userSequentialParametersList);
+
+  eventIterations.clear();
+  eventPositions.clear();
+  stopIteration = 5;
+  parametersList = startParametersList;
+  metric->SetParameters(parametersList[0]);
+  itkOptimizer->SetParametersList(parametersList);
+  itkOptimizer->StartOptimization();
+  ITK_TEST_EXPECT_EQUAL(eventIterations.size(), stopIteration + 1);
+  ITK_TEST_EXPECT_EQUAL(itkOptimizer->GetMetricValuesList().size(), stopIteration + 1);
+  ITK_TEST_EXPECT_EQUAL(itkOptimizer->GetCurrentIteration(), stopIteration + 1);
+  itkOptimizer->RemoveObserver(observerTag);
+  std::cout << "Test 6 passed." << std::endl;
   return EXIT_SUCCESS;
 }
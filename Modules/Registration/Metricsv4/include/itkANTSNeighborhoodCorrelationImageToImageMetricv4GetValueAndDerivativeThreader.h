@@ -85,6 +85,7 @@ public:
   using typename Superclass::MovingImagePixelType;
   using typename Superclass::MovingImageGradientType;
   using typename Superclass::MeasureType;
+  using typename Superclass::MeasureSumType;
   using typename Superclass::DerivativeType;
   using typename Superclass::DerivativeValueType;
 
@@ -43,7 +43,7 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDo
 
   VirtualPointType   virtualPoint;
   MeasureType        metricValueResult = NumericTraits<MeasureType>::ZeroValue();
-  MeasureType        metricValueSum = NumericTraits<MeasureType>::ZeroValue();
+  MeasureSumType     metricValueSum;
   bool               pointIsValid;
   ScanIteratorType   scanIt;
   ScanParametersType scanParameters;
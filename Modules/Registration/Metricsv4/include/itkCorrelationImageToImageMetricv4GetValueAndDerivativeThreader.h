@@ -71,6 +71,7 @@ public:
   using MovingOutputPointType = typename MovingTransformType::OutputPointType;
 
   using typename Superclass::InternalComputationValueType;
+  using typename Superclass::MeasureSumType;
   using typename Superclass::NumberOfParametersType;
 
 protected:
@@ -132,14 +133,14 @@ private:
    * image: see the comments below
    */
   struct CorrelationMetricValueDerivativePerThreadStruct
-  {                                   // keep cumulative summation over points for:
-    InternalComputationValueType fm;  // (f_i - \bar f) * (m_i - \bar m)
-    InternalComputationValueType m2;  // (m_i - \bar m)^2
-    InternalComputationValueType f2;  // (f_i - \bar m)^2
-    InternalComputationValueType m;   // m_i
-    InternalComputationValueType f;   // f_i
-    DerivativeType               fdm; // (f_i - \bar f) * dm_i/dp
-    DerivativeType               mdm; // (m_i - \bar m) * dm_i/dp
+  {                     // keep cumulative summation over points for:
+    MeasureSumType fm;  // (f_i - \bar f) * (m_i - \bar m)
+    MeasureSumType m2;  // (m_i - \bar m)^2
+    MeasureSumType f2;  // (f_i - \bar m)^2
+    MeasureSumType m;   // m_i
+    MeasureSumType f;   // f_i
+    DerivativeType fdm; // (f_i - \bar f) * dm_i/dp
+    DerivativeType mdm; // (m_i - \bar m) * dm_i/dp
   };
 
   itkPadStruct(ITK_CACHE_LINE_ALIGNMENT,
@@ -66,16 +66,11 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner,
   // Set initial values.
   for (ThreadIdType i = 0; i < numWorkUnitsUsed; ++i)
   {
-    m_CorrelationMetricValueDerivativePerThreadVariables[i].fm =
-      NumericTraits<InternalComputationValueType>::ZeroValue();
-    m_CorrelationMetricValueDerivativePerThreadVariables[i].f2 =
-      NumericTraits<InternalComputationValueType>::ZeroValue();
-    m_CorrelationMetricValueDerivativePerThreadVariables[i].m2 =
-      NumericTraits<InternalComputationValueType>::ZeroValue();
-    m_CorrelationMetricValueDerivativePerThreadVariables[i].f =
-      NumericTraits<InternalComputationValueType>::ZeroValue();
-    m_CorrelationMetricValueDerivativePerThreadVariables[i].m =
-      NumericTraits<InternalComputationValueType>::ZeroValue();
+    m_CorrelationMetricValueDerivativePerThreadVariables[i].fm.ResetToZero();
+    m_CorrelationMetricValueDerivativePerThreadVariables[i].f2.ResetToZero();
+    m_CorrelationMetricValueDerivativePerThreadVariables[i].m2.ResetToZero();
+    m_CorrelationMetricValueDerivativePerThreadVariables[i].f.ResetToZero();
+    m_CorrelationMetricValueDerivativePerThreadVariables[i].m.ResetToZero();
 
     this->m_CorrelationMetricValueDerivativePerThreadVariables[i].mdm.Fill(
       NumericTraits<DerivativeValueType>::ZeroValue());
@@ -117,15 +112,18 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner,
 
   /* Accumulate the metric value from threads and store */
   this->m_CorrelationAssociate->m_Value = NumericTraits<InternalComputationValueType>::ZeroValue();
-  InternalComputationValueType fm = NumericTraits<InternalComputationValueType>::ZeroValue();
-  InternalComputationValueType f2 = NumericTraits<InternalComputationValueType>::ZeroValue();
-  InternalComputationValueType m2 = NumericTraits<InternalComputationValueType>::ZeroValue();
+  typename MeasureSumType::AccumulateType fmSum{};
+  typename MeasureSumType::AccumulateType f2Sum{};
+  typename MeasureSumType::AccumulateType m2Sum{};
   for (ThreadIdType threadId = 0; threadId < numWorkUnitsUsed; ++threadId)
   {
-    fm += this->m_CorrelationMetricValueDerivativePerThreadVariables[threadId].fm;
-    m2 += this->m_CorrelationMetricValueDerivativePerThreadVariables[threadId].m2;
-    f2 += this->m_CorrelationMetricValueDerivativePerThreadVariables[threadId].f2;
+    fmSum += this->m_CorrelationMetricValueDerivativePerThreadVariables[threadId].fm.GetSum();
+    m2Sum += this->m_CorrelationMetricValueDerivativePerThreadVariables[threadId].m2.GetSum();
+    f2Sum += this->m_CorrelationMetricValueDerivativePerThreadVariables[threadId].f2.GetSum();
   }
+  const auto fm = static_cast<InternalComputationValueType>(fmSum);
+  const auto f2 = static_cast<InternalComputationValueType>(f2Sum);
+  const auto m2 = static_cast<InternalComputationValueType>(m2Sum);
 
   InternalComputationValueType m2f2 = m2 * f2;
   if (m2f2 <= NumericTraits<InternalComputationValueType>::epsilon())
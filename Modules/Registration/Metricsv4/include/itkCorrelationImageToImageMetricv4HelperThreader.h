@@ -68,6 +68,7 @@ public:
   using typename Superclass::DerivativeValueType;
 
   using typename Superclass::InternalComputationValueType;
+  using typename Superclass::MeasureSumType;
   using typename Superclass::NumberOfParametersType;
 
   using typename Superclass::FixedOutputPointType;
@@ -126,8 +127,8 @@ protected:
 private:
   struct CorrelationMetricPerThreadStruct
   {
-    InternalComputationValueType FixSum;
-    InternalComputationValueType MovSum;
+    MeasureSumType FixSum;
+    MeasureSumType MovSum;
   };
   itkPadStruct(ITK_CACHE_LINE_ALIGNMENT, CorrelationMetricPerThreadStruct, PaddedCorrelationMetricPerThreadStruct);
   itkAlignedTypedef(ITK_CACHE_LINE_ALIGNMENT,
@@ -49,8 +49,8 @@ CorrelationImageToImageMetricv4HelperThreader<TDomainPartitioner, TImageToImageM
   // Set initial values.
   for (ThreadIdType i = 0; i < numWorkUnitsUsed; ++i)
   {
-    this->m_CorrelationMetricPerThreadVariables[i].FixSum = NumericTraits<InternalComputationValueType>::ZeroValue();
-    this->m_CorrelationMetricPerThreadVariables[i].MovSum = NumericTraits<InternalComputationValueType>::ZeroValue();
+    this->m_CorrelationMetricPerThreadVariables[i].FixSum.ResetToZero();
+    this->m_CorrelationMetricPerThreadVariables[i].MovSum.ResetToZero();
   }
 }
 
@@ -78,17 +78,19 @@ CorrelationImageToImageMetricv4HelperThreader<TDomainPartitioner, TImageToImageM
     return;
   }
 
-  InternalComputationValueType sumF = NumericTraits<InternalComputationValueType>::ZeroValue();
-  InternalComputationValueType sumM = NumericTraits<InternalComputationValueType>::ZeroValue();
+  typename MeasureSumType::AccumulateType sumF{};
+  typename MeasureSumType::AccumulateType sumM{};
 
   for (ThreadIdType threadId = 0; threadId < numWorkUnitsUsed; ++threadId)
   {
-    sumF += this->m_CorrelationMetricPerThreadVariables[threadId].FixSum;
-    sumM += this->m_CorrelationMetricPerThreadVariables[threadId].MovSum;
+    sumF += this->m_CorrelationMetricPerThreadVariables[threadId].FixSum.GetSum();
+    sumM += this->m_CorrelationMetricPerThreadVariables[threadId].MovSum.GetSum();
   }
 
-  this->m_CorrelationAssociate->m_AverageFix = sumF / this->m_CorrelationAssociate->m_NumberOfValidPoints;
-  this->m_CorrelationAssociate->m_AverageMov = sumM / this->m_CorrelationAssociate->m_NumberOfValidPoints;
+  this->m_CorrelationAssociate->m_AverageFix =
+    static_cast<InternalComputationValueType>(sumF / this->m_CorrelationAssociate->m_NumberOfValidPoints);
+  this->m_CorrelationAssociate->m_AverageMov =
+    static_cast<InternalComputationValueType>(sumM / this->m_CorrelationAssociate->m_NumberOfValidPoints);
 }
 
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TCorrelationMetric>
@@ -22,6 +22,7 @@
 #include "itkCompensatedSummation.h"
 
 #include <memory> // For unique_ptr.
+#include <type_traits>
 
 namespace itk
 {
@@ -88,6 +89,42 @@ public:
   using InternalComputationValueType = typename ImageToImageMetricv4Type::InternalComputationValueType;
   using NumberOfParametersType = typename ImageToImageMetricv4Type::NumberOfParametersType;
 
+  /** Plain sum of the metric value, with the interface of CompensatedSummation. */
+  struct PlainMeasureSumType
+  {
+    using AccumulateType = InternalComputationValueType;
+
+    void
+    ResetToZero()
+    {
+      m_Sum = AccumulateType{};
+    }
+    PlainMeasureSumType &
+    operator+=(const InternalComputationValueType & rhs)
+    {
+      m_Sum += rhs;
+      return *this;
+    }
+    PlainMeasureSumType &
+    operator-=(const InternalComputationValueType & rhs)
+    {
+      m_Sum -= rhs;
+      return *this;
+    }
+    const AccumulateType &
+    GetSum() const
+    {
+      return m_Sum;
+    }
+
+    AccumulateType m_Sum{};
+  };
+
+  /** Type of the per-thread sums of the metric value. The sums are compensated
+   * with a float computation type only, a double sum being accurate enough. */
+  using MeasureSumType = std::conditional_t<std::is_same<InternalComputationValueType, float>::value,
+                                            CompensatedSummation<InternalComputationValueType>,
+                                            PlainMeasureSumType>;
   using CompensatedDerivativeValueType = CompensatedSummation<DerivativeValueType>;
   using CompensatedDerivativeType = std::vector<CompensatedDerivativeValueType>;
 
@@ -172,8 +209,9 @@ protected:
 
   struct GetValueAndDerivativePerThreadStruct
   {
-    /** Intermediary threaded metric value storage. */
-    InternalComputationValueType Measure;
+    /** Intermediary threaded metric value storage. The sum is compensated, so that
+     * a large number of points can be accumulated with a float computation type. */
+    MeasureSumType Measure;
     /** Intermediary threaded metric value storage. */
     DerivativeType Derivatives;
     /** Intermediary threaded metric value storage. This is used only with global transforms. */
@@ -93,8 +93,7 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
   {
     this->m_GetValueAndDerivativePerThreadVariables[workUnit].NumberOfValidPoints =
       NumericTraits<SizeValueType>::ZeroValue();
-    this->m_GetValueAndDerivativePerThreadVariables[workUnit].Measure =
-      NumericTraits<InternalComputationValueType>::ZeroValue();
+    this->m_GetValueAndDerivativePerThreadVariables[workUnit].Measure.ResetToZero();
     if (this->m_Associate->GetComputeDerivative())
     {
       if (this->m_Associate->m_MovingTransform->GetTransformCategory() !=
@@ -153,13 +152,14 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
   if (this->m_Associate->VerifyNumberOfValidPoints(this->m_Associate->m_Value,
                                                    *(this->m_Associate->m_DerivativeResult)))
   {
-    this->m_Associate->m_Value = NumericTraits<MeasureType>::ZeroValue();
-    /* Accumulate the metric value from threads and store the average. */
+    /* Accumulate the metric value from threads, in the accumulation precision
+     * of the per-thread sums, and store the average. */
+    typename MeasureSumType::AccumulateType value{};
     for (ThreadIdType threadId = 0; threadId < numWorkUnitsUsed; ++threadId)
     {
-      this->m_Associate->m_Value += this->m_GetValueAndDerivativePerThreadVariables[threadId].Measure;
+      value += this->m_GetValueAndDerivativePerThreadVariables[threadId].Measure.GetSum();
     }
-    this->m_Associate->m_Value /= this->m_Associate->m_NumberOfValidPoints;
+    this->m_Associate->m_Value = static_cast<MeasureType>(value / this->m_Associate->m_NumberOfValidPoints);
 
     /* For global transforms, calculate the average values */
     if (this->m_Associate->GetComputeDerivative())
@@ -52,7 +52,8 @@ public:
   {
     NONE,
     REGULAR,
-    RANDOM
+    RANDOM,
+    STOCHASTIC
   };
 };
 // Define how to print enumeration
@@ -218,6 +219,7 @@ public:
   static constexpr MetricSamplingStrategyEnum NONE = MetricSamplingStrategyEnum::NONE;
   static constexpr MetricSamplingStrategyEnum REGULAR = MetricSamplingStrategyEnum::REGULAR;
   static constexpr MetricSamplingStrategyEnum RANDOM = MetricSamplingStrategyEnum::RANDOM;
+  static constexpr MetricSamplingStrategyEnum STOCHASTIC = MetricSamplingStrategyEnum::STOCHASTIC;
 #endif
 
 
@@ -303,10 +305,26 @@ public:
   itkSetObjectMacro(Metric, MetricType);
   itkGetModifiableObjectMacro(Metric, MetricType);
 
-  /** Set/Get the metric sampling strategy. */
+  /** Set/Get the metric sampling strategy.
+   *
+   * The REGULAR and RANDOM strategies select the metric samples once per
+   * level.  The STOCHASTIC strategy draws a fresh random subset of the
+   * virtual domain after every optimizer iteration (mini-batch stochastic
+   * gradient descent), so that few samples per iteration suffice without
+   * biasing the optimization towards a fixed set of points. */
   itkSetEnumMacro(MetricSamplingStrategy, MetricSamplingStrategyEnum);
   itkGetEnumMacro(MetricSamplingStrategy, MetricSamplingStrategyEnum);
 
+  /** Set/Get the factor by which the sampling percentage grows after each
+   * optimizer iteration when the STOCHASTIC sampling strategy is used.  The
+   * percentage of the current level is used for the first iteration and is
+   * then multiplied by this factor, up to a maximum of 1.0, so that the
+   * sample size increases as the optimizer approaches the solution and the
+   * gradient noise would otherwise dominate.  Defaults to 1.0 (fixed sample
+   * size). */
+  itkSetClampMacro(MetricSamplingPercentageGrowthFactor, RealType, 1.0, NumericTraits<RealType>::max());
+  itkGetConstMacro(MetricSamplingPercentageGrowthFactor, RealType);
+
   /** Reinitialize the seed for the random number generators that
    * select the samples for some metric sampling strategies.
    *
@@ -531,6 +549,11 @@ protected:
   virtual void
   SetMetricSamplePoints();
 
+  /** Draw a new set of metric samples for the next optimizer iteration.
+   * Used as the optimizer iteration observer of the STOCHASTIC sampling strategy. */
+  virtual void
+  UpdateStochasticMetricSamplePoints();
+
   SizeValueType m_CurrentLevel;
   SizeValueType m_NumberOfLevels;
   SizeValueType m_CurrentIteration;
@@ -555,6 +578,8 @@ protected:
   MetricPointer                                       m_Metric;
   MetricSamplingStrategyEnum                          m_MetricSamplingStrategy;
   MetricSamplingPercentageArrayType                   m_MetricSamplingPercentagePerLevel;
+  RealType                                            m_MetricSamplingPercentageGrowthFactor;
+  RealType                                            m_CurrentMetricSamplingPercentage;
   SizeValueType                                       m_NumberOfMetrics;
   int                                                 m_FirstImageMetricIndex;
   std::vector<ShrinkFactorsPerDimensionContainerType> m_ShrinkFactorsPerLevel;
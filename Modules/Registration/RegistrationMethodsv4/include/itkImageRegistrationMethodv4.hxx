@@ -20,6 +20,7 @@
 
 
 #include "itkSmoothingRecursiveGaussianImageFilter.h"
+#include "itkCommand.h"
 #include "itkGradientDescentOptimizerv4.h"
 #include "itkImageRandomConstIteratorWithIndex.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
@@ -125,6 +126,8 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   this->m_MetricSamplingStrategy = MetricSamplingStrategyEnum::NONE;
   this->m_MetricSamplingPercentagePerLevel.SetSize(this->m_NumberOfLevels);
   this->m_MetricSamplingPercentagePerLevel.Fill(1.0);
+  this->m_MetricSamplingPercentageGrowthFactor = 1.0;
+  this->m_CurrentMetricSamplingPercentage = 1.0;
 }
 
 template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
@@ -728,6 +731,7 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
 
   if (this->m_MetricSamplingStrategy != MetricSamplingStrategyEnum::NONE)
   {
+    this->m_CurrentMetricSamplingPercentage = this->m_MetricSamplingPercentagePerLevel[level];
     this->SetMetricSamplePoints();
   }
 
@@ -828,13 +832,39 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   // Ensure the same seed is used for each update
   this->m_CurrentRandomSeed = this->m_RandomSeed;
 
-  for (this->m_CurrentLevel = 0; this->m_CurrentLevel < this->m_NumberOfLevels; this->m_CurrentLevel++)
+  // With stochastic sampling, a new set of samples is drawn after each optimizer iteration
+  unsigned long samplingObserverTag = 0;
+  if (this->m_MetricSamplingStrategy == MetricSamplingStrategyEnum::STOCHASTIC)
   {
-    this->InitializeRegistrationAtEachLevel(this->m_CurrentLevel);
+    using SamplingCommandType = SimpleMemberCommand<Self>;
+    auto samplingCommand = SamplingCommandType::New();
+    samplingCommand->SetCallbackFunction(this, &Self::UpdateStochasticMetricSamplePoints);
+    samplingObserverTag = this->m_Optimizer->AddObserver(IterationEvent(), samplingCommand);
+  }
 
-    this->m_Metric->Initialize();
+  try
+  {
+    for (this->m_CurrentLevel = 0; this->m_CurrentLevel < this->m_NumberOfLevels; this->m_CurrentLevel++)
+    {
+      this->InitializeRegistrationAtEachLevel(this->m_CurrentLevel);
 
-    this->m_Optimizer->StartOptimization();
+      this->m_Metric->Initialize();
+
+      this->m_Optimizer->StartOptimization();
+    }
+  }
+  catch (...)
+  {
+    if (this->m_MetricSamplingStrategy == MetricSamplingStrategyEnum::STOCHASTIC)
+    {
+      this->m_Optimizer->RemoveObserver(samplingObserverTag);
+    }
+    throw;
+  }
+
+  if (this->m_MetricSamplingStrategy == MetricSamplingStrategyEnum::STOCHASTIC)
+  {
+    this->m_Optimizer->RemoveObserver(samplingObserverTag);
   }
 }
 
@@ -1051,6 +1081,76 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
         }
         break;
       }
+      case MetricSamplingStrategyEnum::STOCHASTIC:
+      {
+        // The samples are drawn in fixed-size chunks, each with its own random
+        // stream seeded from the current seed, so that the sample set does not
+        // depend on the number of threads used to generate it.
+        constexpr SizeValueType samplesPerChunk = 4096;
+
+        const SizeValueType sampleCount = std::max(
+          static_cast<SizeValueType>(static_cast<RealType>(virtualDomainRegion.GetNumberOfPixels()) *
+                                     this->m_CurrentMetricSamplingPercentage),
+          SizeValueType{ 1 });
+        const SizeValueType numberOfChunks = (sampleCount + samplesPerChunk - 1) / samplesPerChunk;
+
+        int baseSeed = 0;
+        if (m_ReseedIterator)
+        {
+          baseSeed = static_cast<int>(RandomizerType::GetNextSeed());
+        }
+        else
+        {
+          baseSeed = m_CurrentRandomSeed;
+          m_CurrentRandomSeed += static_cast<int>(numberOfChunks);
+        }
+
+        using ContinuousIndexType = ContinuousIndex<typename SamplePointType::ValueType, ImageDimension>;
+        const typename VirtualDomainRegionType::IndexType regionIndex = virtualDomainRegion.GetIndex();
+        const typename VirtualDomainRegionType::SizeType  regionSize = virtualDomainRegion.GetSize();
+
+        std::vector<std::vector<SamplePointType>> chunkPoints(numberOfChunks);
+        this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+        this->GetMultiThreader()->ParallelizeArray(
+          0,
+          numberOfChunks,
+          [&](SizeValueType chunk) {
+            auto chunkRandomizer = RandomizerType::New();
+            chunkRandomizer->SetSeed(static_cast<RandomizerType::IntegerType>(baseSeed + static_cast<int>(chunk)));
+
+            const SizeValueType chunkSampleCount =
+              std::min(samplesPerChunk, sampleCount - chunk * samplesPerChunk);
+            std::vector<SamplePointType> & points = chunkPoints[chunk];
+            points.reserve(chunkSampleCount);
+            for (SizeValueType i = 0; i < chunkSampleCount; ++i)
+            {
+              // Uniformly distributed over the continuous extent of the region
+              ContinuousIndexType cindex;
+              for (unsigned int d = 0; d < ImageDimension; ++d)
+              {
+                cindex[d] = static_cast<double>(regionIndex[d]) - 0.5 +
+                            chunkRandomizer->GetUniformVariate(0.0, static_cast<double>(regionSize[d]));
+              }
+              SamplePointType point;
+              virtualImage->TransformContinuousIndexToPhysicalPoint(cindex, point);
+              if (!fixedMaskImage || fixedMaskImage->IsInsideInWorldSpace(point))
+              {
+                points.push_back(point);
+              }
+            }
+          },
+          nullptr);
+
+        for (const auto & points : chunkPoints)
+        {
+          for (const auto & point : points)
+          {
+            samplePointSet->SetPoint(index, point);
+            ++index;
+          }
+        }
+        break;
+      }
       default:
       {
         itkExceptionMacro("Invalid sampling strategy requested.");
@@ -1073,6 +1173,16 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   }
 }
 
+template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
+void
+ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage, TPointSet>::
+  UpdateStochasticMetricSamplePoints()
+{
+  this->m_CurrentMetricSamplingPercentage =
+    std::min(this->m_CurrentMetricSamplingPercentage * this->m_MetricSamplingPercentageGrowthFactor, RealType{ 1.0 });
+  this->SetMetricSamplePoints();
+}
+
 template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
 void
 ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage, TPointSet>::
@@ -1199,6 +1309,8 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
     os << this->m_MetricSamplingPercentagePerLevel[i] << " ";
   }
   os << std::endl;
+  os << indent << "MetricSamplingPercentageGrowthFactor: " << this->m_MetricSamplingPercentageGrowthFactor << std::endl;
+  os << indent << "CurrentMetricSamplingPercentage: " << this->m_CurrentMetricSamplingPercentage << std::endl;
 
   os << indent << "ReseedIterator: " << m_ReseedIterator << std::endl;
   os << indent << "RandomSeed: " << m_RandomSeed << std::endl;
@@ -0,0 +1,244 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGaussianSmoothingOnUpdateDisplacementFieldTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageRegistrationMethodv4.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkCorrelationImageToImageMetricv4.h"
+#include "itkRegistrationParameterScalesFromPhysicalShift.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Check that a float mean squares metric summed over a million points has the
+ * value of the double metric. Then register two Gaussian blobs with a
+ * displacement field transform, once with float and once with double as the
+ * computation type of the metric, the transform and the optimizer, and check
+ * that the float registration recovers the same displacement field as the
+ * double registration.
+ */
+namespace
+{
+constexpr unsigned int ImageDimension = 2;
+using ImageType = itk::Image<float, ImageDimension>;
+
+ImageType::Pointer
+itkImageRegistrationFloatPrecisionTestCreateBlob(double centerX, double centerY)
+{
+  auto                image = ImageType::New();
+  ImageType::SizeType size;
+  size.Fill(48);
+  image->SetRegions(size);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const double dx = it.GetIndex()[0] - centerX;
+    const double dy = it.GetIndex()[1] - centerY;
+    it.Set(100.0 * std::exp(-(dx * dx + dy * dy) / (2.0 * 6.0 * 6.0)));
+  }
+  return image;
+}
+
+ImageType::Pointer
+itkImageRegistrationFloatPrecisionTestCreateConstant(float value)
+{
+  auto                image = ImageType::New();
+  ImageType::SizeType size;
+  size.Fill(1024);
+  image->SetRegions(size);
+  image->Allocate();
+  image->FillBuffer(value);
+  return image;
+}
+
+template <typename TRealType>
+double
+itkImageRegistrationFloatPrecisionTestMeanSquaresValue(const ImageType * fixedImage, const ImageType * movingImage)
+{
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<
+    ImageType,
+    ImageType,
+    ImageType,
+    TRealType,
+    itk::DefaultImageToImageMetricTraitsv4<ImageType, ImageType, ImageType, TRealType>>;
+
+  auto metric = MetricType::New();
+  metric->SetFixedImage(fixedImage);
+  metric->SetMovingImage(movingImage);
+  metric->Initialize();
+  return metric->GetValue();
+}
+
+template <typename TRealType, typename TMetric>
+int
+itkImageRegistrationFloatPrecisionTestRun(const ImageType *    fixedImage,
+                                          const ImageType *    movingImage,
+                                          itk::Array<double> & displacements,
+                                          double &             metricValue)
+{
+  using TransformType = itk::GaussianSmoothingOnUpdateDisplacementFieldTransform<TRealType, ImageDimension>;
+  using DisplacementFieldType = typename TransformType::DisplacementFieldType;
+  using RegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, TransformType>;
+  using OptimizerType = itk::GradientDescentOptimizerv4Template<TRealType>;
+  using ScalesEstimatorType = itk::RegistrationParameterScalesFromPhysicalShift<TMetric>;
+
+  std::cout << "Computation type: " << (sizeof(TRealType) == sizeof(float) ? "float" : "double")
+            << ", displacement field pixel size: " << sizeof(typename DisplacementFieldType::PixelType) << " bytes"
+            << std::endl;
+
+  auto displacementField = DisplacementFieldType::New();
+  displacementField->CopyInformation(fixedImage);
+  displacementField->SetRegions(fixedImage->GetBufferedRegion());
+  displacementField->Allocate();
+  displacementField->FillBuffer(typename DisplacementFieldType::PixelType{});
+
+  auto transform = TransformType::New();
+  transform->SetGaussianSmoothingVarianceForTheUpdateField(3.0);
+  transform->SetGaussianSmoothingVarianceForTheTotalField(0.5);
+  transform->SetDisplacementField(displacementField);
+
+  auto metric = TMetric::New();
+
+  auto scalesEstimator = ScalesEstimatorType::New();
+  scalesEstimator->SetMetric(metric);
+  scalesEstimator->SetTransformForward(true);
+
+  auto optimizer = OptimizerType::New();
+  optimizer->SetLearningRate(1.0);
+  optimizer->SetNumberOfIterations(30);
+  optimizer->SetScalesEstimator(scalesEstimator);
+  optimizer->SetDoEstimateLearningRateOnce(false);
+  optimizer->SetDoEstimateLearningRateAtEachIteration(true);
+  optimizer->SetMinimumConvergenceValue(0.0);
+
+  auto registration = RegistrationType::New();
+  registration->SetFixedImage(fixedImage);
+  registration->SetMovingImage(movingImage);
+  registration->SetMetric(metric);
+  registration->SetOptimizer(optimizer);
+  registration->SetInitialTransform(transform);
+  registration->InPlaceOn();
+  registration->SetNumberOfLevels(1);
+  typename RegistrationType::ShrinkFactorsArrayType shrinkFactorsPerLevel(1);
+  shrinkFactorsPerLevel.Fill(1);
+  registration->SetShrinkFactorsPerLevel(shrinkFactorsPerLevel);
+  typename RegistrationType::SmoothingSigmasArrayType smoothingSigmasPerLevel(1);
+  smoothingSigmasPerLevel.Fill(0.0);
+  registration->SetSmoothingSigmasPerLevel(smoothingSigmasPerLevel);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(registration->Update());
+
+  metricValue = optimizer->GetCurrentMetricValue();
+  const auto & parameters = registration->GetTransform()->GetParameters();
+  displacements.SetSize(parameters.Size());
+  for (unsigned int i = 0; i < parameters.Size(); ++i)
+  {
+    displacements[i] = parameters[i];
+  }
+  std::cout << "Final metric value: " << metricValue << std::endl;
+  return EXIT_SUCCESS;
+}
+
+template <template <typename, typename, typename, typename, typename> class TMetric>
+int
+itkImageRegistrationFloatPrecisionTestCompare(const ImageType * fixedImage,
+                                              const ImageType * movingImage,
+                                              double            metricTolerance)
+{
+  using FloatMetricType = TMetric<ImageType,
+                                  ImageType,
+                                  ImageType,
+                                  float,
+                                  itk::DefaultImageToImageMetricTraitsv4<ImageType, ImageType, ImageType, float>>;
+  using DoubleMetricType = TMetric<ImageType,
+                                   ImageType,
+                                   ImageType,
+                                   double,
+                                   itk::DefaultImageToImageMetricTraitsv4<ImageType, ImageType, ImageType, double>>;
+
+  itk::Array<double> floatDisplacements;
+  itk::Array<double> doubleDisplacements;
+  double             floatMetricValue = 0.0;
+  double             doubleMetricValue = 0.0;
+  if (itkImageRegistrationFloatPrecisionTestRun<float, FloatMetricType>(
+        fixedImage, movingImage, floatDisplacements, floatMetricValue) != EXIT_SUCCESS ||
+      itkImageRegistrationFloatPrecisionTestRun<double, DoubleMetricType>(
+        fixedImage, movingImage, doubleDisplacements, doubleMetricValue) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The largest displacement is used to check that the registration did move the field,
+  // and to scale the tolerance on the difference between the precisions.
+  double maxDisplacement = 0.0;
+  double maxDifference = 0.0;
+  for (unsigned int i = 0; i < doubleDisplacements.Size(); ++i)
+  {
+    maxDisplacement = std::max(maxDisplacement, std::abs(doubleDisplacements[i]));
+    maxDifference = std::max(maxDifference, std::abs(floatDisplacements[i] - doubleDisplacements[i]));
+  }
+  std::cout << "Maximum displacement: " << maxDisplacement
+            << ", maximum difference between float and double: " << maxDifference << std::endl;
+
+
+  // The registration recovers the displacement of the blob, with the same field in both precisions
+  ITK_TEST_EXPECT_TRUE(maxDisplacement >= 0.5);
+  ITK_TEST_EXPECT_TRUE(maxDifference <= 0.01 * maxDisplacement);
+  ITK_TEST_EXPECT_TRUE(std::abs(floatMetricValue - doubleMetricValue) <= metricTolerance);
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkImageRegistrationFloatPrecisionTest(int, char *[])
+{
+  {
+    // Each point adds 0.09 to the sum of the metric value, which is much smaller than
+    // the spacing between the floats around the total sum.
+    const ImageType::Pointer fixedImage = itkImageRegistrationFloatPrecisionTestCreateConstant(0.0f);
+    const ImageType::Pointer movingImage = itkImageRegistrationFloatPrecisionTestCreateConstant(0.3f);
+
+    const double floatValue = itkImageRegistrationFloatPrecisionTestMeanSquaresValue<float>(fixedImage, movingImage);
+    const double doubleValue = itkImageRegistrationFloatPrecisionTestMeanSquaresValue<double>(fixedImage, movingImage);
+    std::cout << "Mean squares value over " << fixedImage->GetBufferedRegion().GetNumberOfPixels()
+              << " points, float: " << floatValue << ", double: " << doubleValue << std::endl;
+    ITK_TEST_EXPECT_TRUE(std::abs(floatValue - doubleValue) <= 1e-6 * doubleValue);
+  }
+
+  const ImageType::Pointer fixedImage = itkImageRegistrationFloatPrecisionTestCreateBlob(24.0, 24.0);
+  const ImageType::Pointer movingImage = itkImageRegistrationFloatPrecisionTestCreateBlob(25.5, 23.0);
+
+  std::cout << "Mean squares metric" << std::endl;
+  if (itkImageRegistrationFloatPrecisionTestCompare<itk::MeanSquaresImageToImageMetricv4>(
+        fixedImage, movingImage, 1e-2) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Correlation metric" << std::endl;
+  if (itkImageRegistrationFloatPrecisionTestCompare<itk::CorrelationImageToImageMetricv4>(
+        fixedImage, movingImage, 1e-4) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
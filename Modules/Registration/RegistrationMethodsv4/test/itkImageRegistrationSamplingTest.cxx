@@ -16,9 +16,114 @@
  *
  *=========================================================================*/
 
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageRegistrationMethodv4.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkRegistrationParameterScalesFromPhysicalShift.h"
+#include "itkTranslationTransform.h"
 #include "itkTestingMacros.h"
 
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+itkImageRegistrationSamplingTestCreateBlob(double centerX, double centerY)
+{
+  auto                       image = TImage::New();
+  typename TImage::SizeType  size;
+  size.Fill(64);
+  image->SetRegions(size);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const double dx = it.GetIndex()[0] - centerX;
+    const double dy = it.GetIndex()[1] - centerY;
+    it.Set(100.0 * std::exp(-(dx * dx + dy * dy) / (2.0 * 8.0 * 8.0)));
+  }
+  return image;
+}
+
+/*
+ * Register two translated Gaussian blobs using the STOCHASTIC sampling strategy,
+ * which draws a new random subset of the virtual domain at each iteration.
+ */
+template <typename TImage>
+int
+itkImageRegistrationSamplingTestStochastic(typename TImage::Pointer fixedImage,
+                                           typename TImage::Pointer movingImage,
+                                           itk::Array<double> &     parameters)
+{
+  using TransformType = itk::TranslationTransform<double, 2>;
+  using RegistrationType = itk::ImageRegistrationMethodv4<TImage, TImage, TransformType>;
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<TImage, TImage>;
+  using OptimizerType = itk::GradientDescentOptimizerv4;
+  using ScalesEstimatorType = itk::RegistrationParameterScalesFromPhysicalShift<MetricType>;
+
+  auto metric = MetricType::New();
+
+  auto scalesEstimator = ScalesEstimatorType::New();
+  scalesEstimator->SetMetric(metric);
+  scalesEstimator->SetTransformForward(true);
+
+  auto optimizer = OptimizerType::New();
+  optimizer->SetNumberOfIterations(200);
+  optimizer->SetScalesEstimator(scalesEstimator);
+  optimizer->SetDoEstimateLearningRateOnce(true);
+  optimizer->SetMinimumConvergenceValue(1e-8);
+
+  auto registration = RegistrationType::New();
+  registration->SetFixedImage(fixedImage);
+  registration->SetMovingImage(movingImage);
+  registration->SetMetric(metric);
+  registration->SetOptimizer(optimizer);
+  registration->SetNumberOfLevels(1);
+  typename RegistrationType::ShrinkFactorsArrayType shrinkFactorsPerLevel(1);
+  shrinkFactorsPerLevel.Fill(1);
+  registration->SetShrinkFactorsPerLevel(shrinkFactorsPerLevel);
+  typename RegistrationType::SmoothingSigmasArrayType smoothingSigmasPerLevel(1);
+  smoothingSigmasPerLevel.Fill(0.0);
+  registration->SetSmoothingSigmasPerLevel(smoothingSigmasPerLevel);
+  registration->SetMetricSamplingStrategy(RegistrationType::MetricSamplingStrategyEnum::STOCHASTIC);
+  registration->SetMetricSamplingPercentage(0.05);
+  registration->MetricSamplingReinitializeSeed(121212);
+
+  // A growth factor below one is clamped to one
+  registration->SetMetricSamplingPercentageGrowthFactor(0.5);
+  ITK_TEST_EXPECT_EQUAL(registration->GetMetricSamplingPercentageGrowthFactor(), 1.0);
+  registration->SetMetricSamplingPercentageGrowthFactor(1.02);
+  ITK_TEST_SET_GET_VALUE(1.02, registration->GetMetricSamplingPercentageGrowthFactor());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(registration->Update());
+
+  parameters = registration->GetTransform()->GetParameters();
+  std::cout << "Recovered translation: " << parameters << std::endl;
+
+  // The metric must have been evaluated on a subset of the virtual domain
+  const itk::SizeValueType numberOfSamples = metric->GetNumberOfValidPoints();
+  if (numberOfSamples == 0 || numberOfSamples >= fixedImage->GetLargestPossibleRegion().GetNumberOfPixels())
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Unexpected number of valid sampled points: " << numberOfSamples << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const double expectedTranslation[2] = { 3.0, -2.0 };
+  for (unsigned int d = 0; d < 2; ++d)
+  {
+    if (std::abs(parameters[d] - expectedTranslation[d]) > 0.25)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in translation along dimension " << d << ": expected " << expectedTranslation[d]
+                << ", but got " << parameters[d] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
 /*
  * Test the SetMetricSamplingPercentage and SetMetricSamplingPercentagePerLevel.
  * We only need to explicitly run the SetMetricSamplingPercentage method because it
@@ -44,6 +149,31 @@ itkImageRegistrationSamplingTest(int, char *[])
     ITK_TRY_EXPECT_EXCEPTION(registrationMethod->SetMetricSamplingPercentage(errorValue));
   }
 
+  std::cout << RegistrationType::MetricSamplingStrategyEnum::STOCHASTIC << std::endl;
+
+  // Stochastic sampling must recover the translation, and reproduce it for the same seed
+  const FixedImageType::Pointer fixedImage = itkImageRegistrationSamplingTestCreateBlob<FixedImageType>(32.0, 32.0);
+  const FixedImageType::Pointer movingImage = itkImageRegistrationSamplingTestCreateBlob<FixedImageType>(35.0, 30.0);
+
+  itk::Array<double> parameters;
+  if (itkImageRegistrationSamplingTestStochastic<FixedImageType>(fixedImage, movingImage, parameters) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  itk::Array<double> repeatedParameters;
+  if (itkImageRegistrationSamplingTestStochastic<FixedImageType>(fixedImage, movingImage, repeatedParameters) !=
+      EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  if (parameters != repeatedParameters)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Stochastic sampling with a fixed seed is not reproducible: " << parameters << " vs. "
+              << repeatedParameters << std::endl;
+    return EXIT_FAILURE;
+  }
+
 
   std::cout << "Test finished." << std::endl;
   return EXIT_SUCCESS;
@@ -29,6 +29,7 @@
 
 #include "itkRegionOfInterestImageFilter.h"
 
+#include <type_traits>
 #include <vector>
 
 namespace itk
@@ -44,6 +45,14 @@ namespace itk
  * unsigned char, under the assumption that the classifier will generate less
  * than 256 classes.
  *
+ * The means of the images of 8 and 16 bit integers are estimated from the
+ * histogram of the intensities, which is built with the work units of the
+ * filter: each iteration of the K-Means algorithm visits the distinct
+ * intensities instead of the pixels, and the pixels are labeled through a
+ * table of the labels of the intensities. The means of the other images
+ * are estimated with a KdTreeBasedKmeansEstimator, whose filtering of the
+ * K-d tree may give slightly different means.
+ *
  * You may want to look also at the RelabelImageFilter that may be used as a
  * postprocessing stage, in particular if you are interested in ordering the
  * labels by their relative size in number of pixels.
@@ -172,6 +181,24 @@ protected:
 private:
   using MeansContainer = std::vector<RealPixelType>;
 
+  /** Maximal number of iterations of the K-Means algorithm. */
+  static constexpr unsigned int MaximumNumberOfIterations = 200;
+
+  /** The intensities of the integers of 8 and 16 bits are counted in a
+   * histogram with a bin per intensity. */
+  static constexpr bool UseHistogram = std::is_integral<InputPixelType>::value &&
+                                       !std::is_same<InputPixelType, bool>::value && (sizeof(InputPixelType) <= 2);
+
+  /** Estimate the means from the histogram of the intensities of the region,
+   * and label its pixels. */
+  void
+  ClassifyRegion(const ImageRegionType & region, const ClassLabelVectorType & classLabels, std::true_type);
+
+  /** Estimate the means with a KdTreeBasedKmeansEstimator over the pixels of
+   * the region, and label them with a SampleClassifierFilter. */
+  void
+  ClassifyRegion(const ImageRegionType & region, const ClassLabelVectorType & classLabels, std::false_type);
+
   MeansContainer m_InitialMeans;
 
   ParametersType m_FinalMeans;
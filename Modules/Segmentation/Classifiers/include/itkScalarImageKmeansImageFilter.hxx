@@ -19,11 +19,14 @@
 #define itkScalarImageKmeansImageFilter_hxx
 
 #include "itkImageRegionExclusionIteratorWithIndex.h"
+#include "itkImageScanlineIterator.h"
 
 #include "itkDistanceToCentroidMembershipFunction.h"
 
 #include "itkProgressReporter.h"
 #include "itkPrintHelper.h"
+#include <algorithm>
+#include <mutex>
 
 namespace itk
 {
@@ -55,6 +58,242 @@ ScalarImageKmeansImageFilter<TInputImage, TOutputImage>::VerifyPreconditions() I
 template <typename TInputImage, typename TOutputImage>
 void
 ScalarImageKmeansImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  const size_t numberOfClasses = this->m_InitialMeans.size();
+
+  ClassLabelVectorType classLabels;
+  classLabels.resize(numberOfClasses);
+
+  // Spread the labels over the intensity range
+  unsigned int labelInterval = 1;
+  if (m_UseNonContiguousLabels)
+  {
+    labelInterval = (NumericTraits<OutputPixelType>::max() / numberOfClasses) - 1;
+  }
+
+  unsigned int label = 0;
+  for (unsigned int k = 0; k < numberOfClasses; ++k)
+  {
+    classLabels[k] = label;
+    label += labelInterval;
+  }
+
+  typename OutputImageType::Pointer outputPtr = this->GetOutput();
+
+  outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
+  outputPtr->Allocate();
+
+  ImageRegionType region = outputPtr->GetBufferedRegion();
+
+  // If we constrained the classification to a region, label only pixels within
+  // the region. Label outside pixels as numberOfClasses + 1
+  if (m_ImageRegionDefined)
+  {
+    region = m_ImageRegion;
+  }
+
+  this->ClassifyRegion(region, classLabels, std::integral_constant<bool, UseHistogram>());
+
+  if (m_ImageRegionDefined)
+  {
+    // If a region is defined to constrain classification to, we need to label
+    // pixels outside with numberOfClasses + 1.
+    using ExclusionImageIteratorType = ImageRegionExclusionIteratorWithIndex<OutputImageType>;
+    ExclusionImageIteratorType exIt(outputPtr, outputPtr->GetBufferedRegion());
+    exIt.SetExclusionRegion(region);
+    exIt.GoToBegin();
+    if (m_UseNonContiguousLabels)
+    {
+      OutputPixelType outsideLabel = labelInterval * numberOfClasses;
+      while (!exIt.IsAtEnd())
+      {
+        exIt.Set(outsideLabel);
+        ++exIt;
+      }
+    }
+    else
+    {
+      while (!exIt.IsAtEnd())
+      {
+        exIt.Set(numberOfClasses);
+        ++exIt;
+      }
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageKmeansImageFilter<TInputImage, TOutputImage>::ClassifyRegion(const ImageRegionType &      region,
+                                                                        const ClassLabelVectorType & classLabels,
+                                                                        std::true_type)
+{
+  const InputImageType * inputPtr = this->GetInput();
+  OutputImageType *      outputPtr = this->GetOutput();
+
+  if (!inputPtr->GetBufferedRegion().IsInside(region))
+  {
+    itkExceptionMacro("The region " << region << " is not inside the buffered region of the input "
+                                    << inputPtr->GetBufferedRegion());
+  }
+
+  // A bin per intensity of the pixel type, the bin of the lowest intensity first
+  const auto          lowest = static_cast<OffsetValueType>(NumericTraits<InputPixelType>::NonpositiveMin());
+  const SizeValueType numberOfBins =
+    static_cast<SizeValueType>(static_cast<OffsetValueType>(NumericTraits<InputPixelType>::max()) - lowest + 1);
+
+  using HistogramType = std::vector<SizeValueType>;
+  HistogramType histogram(numberOfBins, 0);
+  std::mutex    mutex;
+
+  // The histogram of a chunk with fewer pixels than intensities covers only
+  // the range of its intensities, so that counting costs no more than the
+  // pixels of the chunk
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  multiThreader->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [inputPtr, numberOfBins, lowest, &histogram, &mutex](const ImageRegionType & regionForThread) {
+      OffsetValueType chunkLowest = lowest;
+      SizeValueType   chunkNumberOfBins = numberOfBins;
+      if (regionForThread.GetNumberOfPixels() < numberOfBins)
+      {
+        InputPixelType minimum = NumericTraits<InputPixelType>::max();
+        InputPixelType maximum = NumericTraits<InputPixelType>::NonpositiveMin();
+        for (ImageScanlineConstIterator<InputImageType> it(inputPtr, regionForThread); !it.IsAtEnd(); it.NextLine())
+        {
+          for (; !it.IsAtEndOfLine(); ++it)
+          {
+            minimum = std::min(minimum, it.Get());
+            maximum = std::max(maximum, it.Get());
+          }
+        }
+        if (minimum > maximum)
+        {
+          return;
+        }
+        chunkLowest = static_cast<OffsetValueType>(minimum);
+        chunkNumberOfBins = static_cast<SizeValueType>(static_cast<OffsetValueType>(maximum) - chunkLowest + 1);
+      }
+
+      HistogramType chunkHistogram(chunkNumberOfBins, 0);
+      for (ImageScanlineConstIterator<InputImageType> it(inputPtr, regionForThread); !it.IsAtEnd(); it.NextLine())
+      {
+        for (; !it.IsAtEndOfLine(); ++it)
+        {
+          ++chunkHistogram[static_cast<OffsetValueType>(it.Get()) - chunkLowest];
+        }
+      }
+
+      const SizeValueType               firstBin = static_cast<SizeValueType>(chunkLowest - lowest);
+      const std::lock_guard<std::mutex> lock(mutex);
+      for (SizeValueType bin = 0; bin < chunkNumberOfBins; ++bin)
+      {
+        histogram[firstBin + bin] += chunkHistogram[bin];
+      }
+    },
+    nullptr);
+
+  std::vector<SizeValueType> bins;
+  for (SizeValueType bin = 0; bin < numberOfBins; ++bin)
+  {
+    if (histogram[bin] > 0)
+    {
+      bins.push_back(bin);
+    }
+  }
+
+  // The closest mean by the Euclidean distance, the first one in case of a
+  // tie, as the KdTreeBasedKmeansEstimator and the MinimumDecisionRule
+  const size_t        numberOfClasses = this->m_InitialMeans.size();
+  std::vector<double> means(this->m_InitialMeans.begin(), this->m_InitialMeans.end());
+
+  const auto closestMean = [&means, numberOfClasses](double value) {
+    size_t closest = 0;
+    double closestDistance = NumericTraits<double>::max();
+    for (size_t k = 0; k < numberOfClasses; ++k)
+    {
+      const double difference = means[k] - value;
+      const double distance = std::sqrt(difference * difference);
+      if (distance < closestDistance)
+      {
+        closest = k;
+        closestDistance = distance;
+      }
+    }
+    return closest;
+  };
+
+  // Each intensity is weighted by its number of pixels, and the iterations
+  // stop as those of the KdTreeBasedKmeansEstimator
+  std::vector<double>        previousMeans(numberOfClasses);
+  std::vector<double>        sums(numberOfClasses);
+  std::vector<SizeValueType> sizes(numberOfClasses);
+  for (unsigned int iteration = 0;; ++iteration)
+  {
+    previousMeans = means;
+    std::fill(sums.begin(), sums.end(), 0.0);
+    std::fill(sizes.begin(), sizes.end(), 0);
+    for (const SizeValueType bin : bins)
+    {
+      const double value = static_cast<double>(static_cast<OffsetValueType>(bin) + lowest);
+      const size_t closest = closestMean(value);
+      sums[closest] += value * static_cast<double>(histogram[bin]);
+      sizes[closest] += histogram[bin];
+    }
+    for (size_t k = 0; k < numberOfClasses; ++k)
+    {
+      if (sizes[k] > 0)
+      {
+        means[k] = sums[k] / static_cast<double>(sizes[k]);
+      }
+    }
+
+    if (iteration >= MaximumNumberOfIterations || means == previousMeans)
+    {
+      break;
+    }
+  }
+
+  this->m_FinalMeans = ParametersType(numberOfClasses);
+  for (size_t k = 0; k < numberOfClasses; ++k)
+  {
+    this->m_FinalMeans[k] = means[k];
+  }
+
+  // All the pixels of an intensity have the same label
+  std::vector<OutputPixelType> labels(numberOfBins);
+  for (const SizeValueType bin : bins)
+  {
+    const double value = static_cast<double>(static_cast<OffsetValueType>(bin) + lowest);
+    labels[bin] = static_cast<OutputPixelType>(classLabels[closestMean(value)]);
+  }
+
+  multiThreader->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [inputPtr, outputPtr, lowest, &labels](const ImageRegionType & regionForThread) {
+      ImageScanlineConstIterator<InputImageType> inputIt(inputPtr, regionForThread);
+      ImageScanlineIterator<OutputImageType>     outputIt(outputPtr, regionForThread);
+      while (!inputIt.IsAtEnd())
+      {
+        while (!inputIt.IsAtEndOfLine())
+        {
+          outputIt.Set(labels[static_cast<OffsetValueType>(inputIt.Get()) - lowest]);
+          ++inputIt;
+          ++outputIt;
+        }
+        inputIt.NextLine();
+        outputIt.NextLine();
+      }
+    },
+    nullptr);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarImageKmeansImageFilter<TInputImage, TOutputImage>::ClassifyRegion(const ImageRegionType &      region,
+                                                                        const ClassLabelVectorType & classLabels,
+                                                                        std::false_type)
 {
   auto adaptor = AdaptorType::New();
 
@@ -93,14 +332,12 @@ ScalarImageKmeansImageFilter<TInputImage, TOutputImage>::GenerateData()
   estimator->SetParameters(initialMeans);
 
   estimator->SetKdTree(treeGenerator->GetOutput());
-  estimator->SetMaximumIteration(200);
+  estimator->SetMaximumIteration(MaximumNumberOfIterations);
   estimator->SetCentroidPositionChangesThreshold(0.0);
   estimator->StartOptimization();
 
   this->m_FinalMeans = estimator->GetParameters();
 
-  using RegionType = typename InputImageType::RegionType;
-
   // Now classify the samples
   auto decisionRule = DecisionRuleType::New();
   auto classifier = ClassifierType::New();
@@ -110,23 +347,10 @@ ScalarImageKmeansImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   classifier->SetNumberOfClasses(numberOfClasses);
 
-  ClassLabelVectorType classLabels;
-  classLabels.resize(numberOfClasses);
-
-  // Spread the labels over the intensity range
-  unsigned int labelInterval = 1;
-  if (m_UseNonContiguousLabels)
-  {
-    labelInterval = (NumericTraits<OutputPixelType>::max() / numberOfClasses) - 1;
-  }
-
-  unsigned int                 label = 0;
   MembershipFunctionVectorType membershipFunctions;
 
   for (unsigned int k = 0; k < numberOfClasses; ++k)
   {
-    classLabels[k] = label;
-    label += labelInterval;
     MembershipFunctionPointer    membershipFunction = MembershipFunctionType::New();
     MembershipFunctionOriginType origin(adaptor->GetMeasurementVectorSize());
     origin[0] = this->m_FinalMeans[k]; // A scalar image has a MeasurementVector
@@ -150,23 +374,9 @@ ScalarImageKmeansImageFilter<TInputImage, TOutputImage>::GenerateData()
   classifier->Update();
 
   // Now classify the pixels
-  typename OutputImageType::Pointer outputPtr = this->GetOutput();
-
   using ImageIterator = ImageRegionIterator<OutputImageType>;
 
-  outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
-  outputPtr->Allocate();
-
-  RegionType region = outputPtr->GetBufferedRegion();
-
-  // If we constrained the classification to a region, label only pixels within
-  // the region. Label outside pixels as numberOfClasses + 1
-  if (m_ImageRegionDefined)
-  {
-    region = m_ImageRegion;
-  }
-
-  ImageIterator pixel(outputPtr, region);
+  ImageIterator pixel(this->GetOutput(), region);
   pixel.GoToBegin();
 
   using ClassifierOutputType = typename ClassifierType::MembershipSampleType;
@@ -183,33 +393,6 @@ ScalarImageKmeansImageFilter<TInputImage, TOutputImage>::GenerateData()
     ++iter;
     ++pixel;
   }
-
-  if (m_ImageRegionDefined)
-  {
-    // If a region is defined to constrain classification to, we need to label
-    // pixels outside with numberOfClasses + 1.
-    using ExclusionImageIteratorType = ImageRegionExclusionIteratorWithIndex<OutputImageType>;
-    ExclusionImageIteratorType exIt(outputPtr, outputPtr->GetBufferedRegion());
-    exIt.SetExclusionRegion(region);
-    exIt.GoToBegin();
-    if (m_UseNonContiguousLabels)
-    {
-      OutputPixelType outsideLabel = labelInterval * numberOfClasses;
-      while (!exIt.IsAtEnd())
-      {
-        exIt.Set(outsideLabel);
-        ++exIt;
-      }
-    }
-    else
-    {
-      while (!exIt.IsAtEnd())
-      {
-        exIt.Set(numberOfClasses);
-        ++exIt;
-      }
-    }
-  }
 }
 
 template <typename TInputImage, typename TOutputImage>
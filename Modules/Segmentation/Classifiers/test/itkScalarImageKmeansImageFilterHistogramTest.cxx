@@ -0,0 +1,148 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkScalarImageKmeansImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMath.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+/*
+ * The means of the images of 8 and 16 bit integers are estimated from the
+ * histogram of their intensities, and those of the other images with a
+ * KdTreeBasedKmeansEstimator. Classify images of three noisy bands of
+ * intensities with both, through a copy of the image in float, and check that
+ * they find the same means and labels, with one and several work units.
+ */
+namespace
+{
+template <typename TPixel>
+int
+itkScalarImageKmeansImageFilterHistogramTestRun(const double bandMeans[3], double noise)
+{
+  constexpr unsigned int Dimension = 2;
+  using ImageType = itk::Image<TPixel, Dimension>;
+  using FloatImageType = itk::Image<float, Dimension>;
+  using KMeansFilterType = itk::ScalarImageKmeansImageFilter<ImageType>;
+  using FloatKMeansFilterType = itk::ScalarImageKmeansImageFilter<FloatImageType>;
+
+  // Large enough for a single work unit to count all the intensities of 16
+  // bits, and small enough for several work units to count their ranges only
+  const typename ImageType::SizeType size = { { 320, 240 } };
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  auto floatImage = FloatImageType::New();
+  floatImage->SetRegions(size);
+  floatImage->Allocate();
+
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  auto generator = GeneratorType::New();
+  generator->Initialize(2023);
+
+  itk::ImageRegionIterator<ImageType>      it(image, image->GetLargestPossibleRegion());
+  itk::ImageRegionIterator<FloatImageType> floatIt(floatImage, floatImage->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it, ++floatIt)
+  {
+    const double value = bandMeans[it.GetIndex()[0] * 3 / size[0]] + generator->GetUniformVariate(-noise, noise);
+    it.Set(static_cast<TPixel>(value));
+    floatIt.Set(static_cast<float>(it.Get()));
+  }
+
+  auto floatFilter = FloatKMeansFilterType::New();
+  floatFilter->SetInput(floatImage);
+  for (unsigned int k = 0; k < 3; ++k)
+  {
+    floatFilter->AddClassWithInitialMean(bandMeans[k] + 0.2 * noise);
+  }
+  ITK_TRY_EXPECT_NO_EXCEPTION(floatFilter->Update());
+  const typename FloatKMeansFilterType::ParametersType floatMeans = floatFilter->GetFinalMeans();
+
+  for (itk::ThreadIdType numberOfWorkUnits : { 1, 8 })
+  {
+    auto filter = KMeansFilterType::New();
+    filter->SetInput(image);
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      filter->AddClassWithInitialMean(bandMeans[k] + 0.2 * noise);
+    }
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+    const typename KMeansFilterType::ParametersType means = filter->GetFinalMeans();
+    ITK_TEST_EXPECT_EQUAL(means.Size(), floatMeans.Size());
+    for (unsigned int k = 0; k < means.Size(); ++k)
+    {
+      std::cout << "Mean " << k << ": " << means[k] << " (K-d tree: " << floatMeans[k] << ')' << std::endl;
+      if (itk::Math::abs(means[k] - floatMeans[k]) > 1e-3 * noise)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "The mean " << k << " with " << numberOfWorkUnits << " work units is " << means[k]
+                  << " instead of " << floatMeans[k] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    itk::ImageRegionConstIterator<typename KMeansFilterType::OutputImageType> labelIt(
+      filter->GetOutput(), filter->GetOutput()->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<typename FloatKMeansFilterType::OutputImageType> floatLabelIt(
+      floatFilter->GetOutput(), floatFilter->GetOutput()->GetLargestPossibleRegion());
+    for (; !labelIt.IsAtEnd(); ++labelIt, ++floatLabelIt)
+    {
+      if (labelIt.Get() != floatLabelIt.Get())
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "The label of " << labelIt.GetIndex() << " with " << numberOfWorkUnits << " work units is "
+                  << static_cast<int>(labelIt.Get()) << " instead of " << static_cast<int>(floatLabelIt.Get())
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkScalarImageKmeansImageFilterHistogramTest(int, char *[])
+{
+  const double unsignedCharMeans[3] = { 40.0, 120.0, 200.0 };
+  const double shortMeans[3] = { -1000.0, 200.0, 1500.0 };
+  const double unsignedShortMeans[3] = { 1000.0, 20000.0, 50000.0 };
+
+  std::cout << "unsigned char" << std::endl;
+  if (itkScalarImageKmeansImageFilterHistogramTestRun<unsigned char>(unsignedCharMeans, 30.0) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  std::cout << "short" << std::endl;
+  if (itkScalarImageKmeansImageFilterHistogramTestRun<short>(shortMeans, 400.0) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  std::cout << "unsigned short" << std::endl;
+  if (itkScalarImageKmeansImageFilterHistogramTestRun<unsigned short>(unsignedShortMeans, 800.0) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
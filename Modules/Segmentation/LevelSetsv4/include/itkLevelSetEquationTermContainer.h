@@ -318,6 +318,25 @@ protected:
   using RequiredDataType = typename TermType::RequiredDataType;
   RequiredDataType m_RequiredData;
 
+  /** Flags of the characteristics of m_RequiredData, so that the names are
+   * not compared at each pixel. */
+  enum RequiredDataFlagType : unsigned int
+  {
+    ValueFlag = 1 << 0,
+    GradientFlag = 1 << 1,
+    HessianFlag = 1 << 2,
+    LaplacianFlag = 1 << 3,
+    GradientNormFlag = 1 << 4,
+    MeanCurvatureFlag = 1 << 5,
+    ForwardGradientFlag = 1 << 6,
+    BackwardGradientFlag = 1 << 7
+  };
+  unsigned int m_RequiredDataFlags{ 0 };
+
+  /** Flag of a characteristic name, 0 if the name is unknown. */
+  static unsigned int
+  GetRequiredDataFlag(const std::string & iName);
+
   MapTermContainerType m_Container;
 
   using MapCFLContainerType = std::map<TermIdType, std::atomic<LevelSetOutputRealType>>;
@@ -107,6 +107,7 @@ LevelSetEquationTermContainer<TInputImage, TLevelSetContainer>::AddTerm(const Te
     while (dIt != dEnd)
     {
       m_RequiredData.insert(*dIt);
+      m_RequiredDataFlags |= GetRequiredDataFlag(*dIt);
       ++dIt;
     }
 
@@ -166,6 +167,7 @@ LevelSetEquationTermContainer<TInputImage, TLevelSetContainer>::PushTerm(TermTyp
     while (dIt != dEnd)
     {
       m_RequiredData.insert(*dIt);
+      m_RequiredDataFlags |= GetRequiredDataFlag(*dIt);
       ++dIt;
     }
 
@@ -370,55 +372,86 @@ LevelSetEquationTermContainer<TInputImage, TLevelSetContainer>::ComputeCFLContri
   return oValue;
 }
 
+// ----------------------------------------------------------------------------
+template <typename TInputImage, typename TLevelSetContainer>
+unsigned int
+LevelSetEquationTermContainer<TInputImage, TLevelSetContainer>::GetRequiredDataFlag(const std::string & iName)
+{
+  if (iName == "Value")
+  {
+    return ValueFlag;
+  }
+  if (iName == "Gradient")
+  {
+    return GradientFlag;
+  }
+  if (iName == "Hessian")
+  {
+    return HessianFlag;
+  }
+  if (iName == "Laplacian")
+  {
+    return LaplacianFlag;
+  }
+  if (iName == "GradientNorm")
+  {
+    return GradientNormFlag;
+  }
+  if (iName == "MeanCurvature")
+  {
+    return MeanCurvatureFlag;
+  }
+  if (iName == "ForwardGradient")
+  {
+    return ForwardGradientFlag;
+  }
+  if (iName == "BackwardGradient")
+  {
+    return BackwardGradientFlag;
+  }
+  // here add new characteristics
+  return 0;
+}
+
 // ----------------------------------------------------------------------------
 template <typename TInputImage, typename TLevelSetContainer>
 void
 LevelSetEquationTermContainer<TInputImage, TLevelSetContainer>::ComputeRequiredData(const LevelSetInputIndexType & iP,
                                                                                     LevelSetDataType & ioData)
 {
-  typename RequiredDataType::const_iterator dIt = m_RequiredData.begin();
-  typename RequiredDataType::const_iterator dEnd = m_RequiredData.end();
+  LevelSetType * levelset = (m_Container.begin()->second)->GetModifiableCurrentLevelSetPointer();
 
-  auto tIt = m_Container.begin();
-
-  LevelSetPointer levelset = (tIt->second)->GetModifiableCurrentLevelSetPointer();
-
-  while (dIt != dEnd)
+  if (m_RequiredDataFlags & ValueFlag)
   {
-    if (*dIt == "Value")
-    {
-      levelset->Evaluate(iP, ioData);
-    }
-    if (*dIt == "Gradient")
-    {
-      levelset->EvaluateGradient(iP, ioData);
-    }
-    if (*dIt == "Hessian")
-    {
-      levelset->EvaluateHessian(iP, ioData);
-    }
-    if (*dIt == "Laplacian")
-    {
-      levelset->EvaluateLaplacian(iP, ioData);
-    }
-    if (*dIt == "GradientNorm")
-    {
-      levelset->EvaluateGradientNorm(iP, ioData);
-    }
-    if (*dIt == "MeanCurvature")
-    {
-      levelset->EvaluateMeanCurvature(iP, ioData);
-    }
-    if (*dIt == "ForwardGradient")
-    {
-      levelset->EvaluateForwardGradient(iP, ioData);
-    }
-    if (*dIt == "BackwardGradient")
-    {
-      levelset->EvaluateBackwardGradient(iP, ioData);
-    }
-    // here add new characteristics
-    ++dIt;
+    levelset->Evaluate(iP, ioData);
+  }
+  if (m_RequiredDataFlags & GradientFlag)
+  {
+    levelset->EvaluateGradient(iP, ioData);
+  }
+  if (m_RequiredDataFlags & HessianFlag)
+  {
+    levelset->EvaluateHessian(iP, ioData);
+  }
+  if (m_RequiredDataFlags & LaplacianFlag)
+  {
+    levelset->EvaluateLaplacian(iP, ioData);
+  }
+  if (m_RequiredDataFlags & GradientNormFlag)
+  {
+    levelset->EvaluateGradientNorm(iP, ioData);
+  }
+  if (m_RequiredDataFlags & MeanCurvatureFlag)
+  {
+    levelset->EvaluateMeanCurvature(iP, ioData);
+  }
+  if (m_RequiredDataFlags & ForwardGradientFlag)
+  {
+    levelset->EvaluateForwardGradient(iP, ioData);
+  }
+  if (m_RequiredDataFlags & BackwardGradientFlag)
+  {
+    levelset->EvaluateBackwardGradient(iP, ioData);
   }
 }
 
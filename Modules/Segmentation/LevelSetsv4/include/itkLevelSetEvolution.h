@@ -266,6 +266,11 @@ protected:
   // For sparse case, the update buffer needs to be the size of the active layer
   std::map<IdentifierType, LevelSetLayerType *> m_UpdateBuffer;
 
+  /** Read the statuses of the level sets from dense images while they are
+   *  evolving */
+  void
+  SetLevelSetsEvolving(bool evolving) override;
+
   /** Initialize the update buffers for all level sets to hold the updates of
    *  equations in each iteration */
   void
@@ -364,6 +369,11 @@ public:
   ~LevelSetEvolution() override = default;
 
 protected:
+  /** Read the statuses of the level sets from dense images while they are
+   *  evolving */
+  void
+  SetLevelSetsEvolving(bool evolving) override;
+
   /** Update the levelset by 1 iteration from the computed updates */
   void
   UpdateLevelSets() override;
@@ -443,6 +453,11 @@ public:
   ~LevelSetEvolution() override = default;
 
 protected:
+  /** Read the statuses of the level sets from dense images while they are
+   *  evolving */
+  void
+  SetLevelSetsEvolving(bool evolving) override;
+
   void
   UpdateLevelSets() override;
   void
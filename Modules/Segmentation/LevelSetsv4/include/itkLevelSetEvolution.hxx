@@ -236,6 +236,19 @@ LevelSetEvolution<TEquationContainer, WhitakerSparseLevelSetImage<TOutput, VDime
   return this->m_SplitLevelSetComputeIterationThreader->GetNumberOfWorkUnits();
 }
 
+template <typename TEquationContainer, typename TOutput, unsigned int VDimension>
+void
+LevelSetEvolution<TEquationContainer, WhitakerSparseLevelSetImage<TOutput, VDimension>>::SetLevelSetsEvolving(
+  bool evolving)
+{
+  typename LevelSetContainerType::Iterator it = this->m_LevelSetContainer->Begin();
+  while (it != this->m_LevelSetContainer->End())
+  {
+    it->GetLevelSet()->SetUseStatusImage(evolving);
+    ++it;
+  }
+}
+
 template <typename TEquationContainer, typename TOutput, unsigned int VDimension>
 void
 LevelSetEvolution<TEquationContainer, WhitakerSparseLevelSetImage<TOutput, VDimension>>::AllocateUpdateBuffer()
@@ -354,6 +367,18 @@ LevelSetEvolution<TEquationContainer, WhitakerSparseLevelSetImage<TOutput, VDime
 
 // Shi
 
+template <typename TEquationContainer, unsigned int VDimension>
+void
+LevelSetEvolution<TEquationContainer, ShiSparseLevelSetImage<VDimension>>::SetLevelSetsEvolving(bool evolving)
+{
+  typename LevelSetContainerType::Iterator it = this->m_LevelSetContainer->Begin();
+  while (it != this->m_LevelSetContainer->End())
+  {
+    it->GetLevelSet()->SetUseStatusImage(evolving);
+    ++it;
+  }
+}
+
 template <typename TEquationContainer, unsigned int VDimension>
 void
 LevelSetEvolution<TEquationContainer, ShiSparseLevelSetImage<VDimension>>::UpdateLevelSets()
@@ -387,6 +412,18 @@ LevelSetEvolution<TEquationContainer, ShiSparseLevelSetImage<VDimension>>::Updat
 
 // Malcolm
 
+template <typename TEquationContainer, unsigned int VDimension>
+void
+LevelSetEvolution<TEquationContainer, MalcolmSparseLevelSetImage<VDimension>>::SetLevelSetsEvolving(bool evolving)
+{
+  typename LevelSetContainerType::Iterator it = this->m_LevelSetContainer->Begin();
+  while (it != this->m_LevelSetContainer->End())
+  {
+    it->GetLevelSet()->SetUseStatusImage(evolving);
+    ++it;
+  }
+}
+
 template <typename TEquationContainer, unsigned int VDimension>
 void
 LevelSetEvolution<TEquationContainer, MalcolmSparseLevelSetImage<VDimension>>::UpdateLevelSets()
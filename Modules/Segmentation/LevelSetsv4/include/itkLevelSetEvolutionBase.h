@@ -131,12 +131,18 @@ protected:
   InitializeIteration();
 
   /** Run the iterative loops of calculating levelset function updates until
-   *  the stopping criterion is satisfied.  Calls AllocateUpdateBuffer,
-   *  ComputeIteration, ComputeTimeStepForNextIteration, UpdateLevelSets,
-   *  UpdateEquations.  */
+   *  the stopping criterion is satisfied.  Calls SetLevelSetsEvolving,
+   *  AllocateUpdateBuffer, ComputeIteration, ComputeTimeStepForNextIteration,
+   *  UpdateLevelSets, UpdateEquations.  */
   void
   Evolve();
 
+  /** Called with true before the first iteration and with false after the
+   *  last one, so that the level sets can keep data that is only valid while
+   *  the evolution alone modifies them. No-op by default. */
+  virtual void
+  SetLevelSetsEvolving(bool evolving);
+
   /** Initialize the update buffers for all level sets to hold the updates of
    *  equations in each iteration. No-op by default. */
   virtual void
@@ -197,6 +197,8 @@ template <typename TEquationContainer, typename TLevelSet>
 void
 LevelSetEvolutionBase<TEquationContainer, TLevelSet>::Evolve()
 {
+  this->SetLevelSetsEvolving(true);
+
   this->AllocateUpdateBuffer();
 
   this->InitializeIteration();
@@ -233,8 +235,15 @@ LevelSetEvolutionBase<TEquationContainer, TLevelSet>::Evolve()
     // Trigger visualization classes to show updated level-set
     this->InvokeEvent(IterationEvent());
   }
+
+  this->SetLevelSetsEvolving(false);
 }
 
+template <typename TEquationContainer, typename TLevelSet>
+void
+LevelSetEvolutionBase<TEquationContainer, TLevelSet>::SetLevelSetsEvolving(bool)
+{}
+
 template <typename TEquationContainer, typename TLevelSet>
 void
 LevelSetEvolutionBase<TEquationContainer, TLevelSet>::AllocateUpdateBuffer()
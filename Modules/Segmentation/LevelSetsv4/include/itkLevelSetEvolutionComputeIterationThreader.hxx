@@ -20,6 +20,7 @@
 
 
 #include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
 
 namespace itk
 {
@@ -64,13 +65,17 @@ LevelSetEvolutionComputeIterationThreader<LevelSetDenseImage<TImage>,
       ++idListIdx;
     }
 
+    // The characteristics are reset from a blank copy at each pixel, which
+    // does not construct their names again
+    const LevelSetDataType blankCharacteristics;
+    LevelSetDataType       characteristics;
     while (!imageIt.IsAtEnd())
     {
       const IndexType levelSetIndex = imageIt.GetIndex();
       const IndexType inputIndex = imageIt.GetIndex() + offset;
       for (idListIdx = 0; idListIdx < numberOfLevelSets; ++idListIdx)
       {
-        LevelSetDataType characteristics;
+        characteristics = blankCharacteristics;
         termContainers[idListIdx]->ComputeRequiredData(inputIndex, characteristics);
         LevelSetOutputRealType temp_update = termContainers[idListIdx]->Evaluate(inputIndex, characteristics);
         levelSetUpdateImages[idListIdx]->SetPixel(levelSetIndex, temp_update);
@@ -90,16 +95,20 @@ LevelSetEvolutionComputeIterationThreader<LevelSetDenseImage<TImage>,
     typename EquationContainerType::Iterator equationContainerIt = this->m_Associate->m_EquationContainer->Begin();
     typename TermContainerType::Pointer      termContainer = equationContainerIt->GetEquation();
 
+    ImageRegionIterator<LevelSetImageType> updateIt(levelSetUpdateImage, subRegion);
+
+    const LevelSetDataType blankCharacteristics;
+    LevelSetDataType       characteristics;
     imageIt.GoToBegin();
     while (!imageIt.IsAtEnd())
     {
-      const IndexType  levelSetIndex = imageIt.GetIndex();
-      const IndexType  inputIndex = imageIt.GetIndex() + offset;
-      LevelSetDataType characteristics;
+      const IndexType inputIndex = imageIt.GetIndex() + offset;
+      characteristics = blankCharacteristics;
       termContainer->ComputeRequiredData(inputIndex, characteristics);
       LevelSetOutputRealType temp_update = termContainer->Evaluate(inputIndex, characteristics);
-      levelSetUpdateImage->SetPixel(levelSetIndex, temp_update);
+      updateIt.Set(temp_update);
       ++imageIt;
+      ++updateIt;
     }
   }
 }
@@ -114,33 +123,43 @@ LevelSetEvolutionComputeIterationThreader<
 {
   typename InputImageType::ConstPointer inputImage = this->m_Associate->m_EquationContainer->GetInput();
 
+  const LevelSetDataType blankCharacteristics;
+  LevelSetDataType       characteristics;
+
   typename DomainType::IteratorType mapIt = imageSubDomain.Begin();
   while (mapIt != imageSubDomain.End())
   {
+    const IdListType * idList = mapIt->second.GetIdList();
+
+    // itkAssertInDebugOrThrowInReleaseMacro( !idList->empty() );
+
+    // The level sets of the domain are looked up once for all its pixels
+    const size_t                     numberOfLevelSets = idList->size();
+    std::vector<LevelSetImageType *> levelSetUpdateImages(numberOfLevelSets);
+    std::vector<OffsetType>          offsets(numberOfLevelSets);
+    std::vector<TermContainerType *> termContainers(numberOfLevelSets);
+    unsigned int                     idListIdx = 0;
+    for (auto idListIt = idList->begin(); idListIt != idList->end(); ++idListIt, ++idListIdx)
+    {
+      //! \todo Fix me for string identifiers
+      LevelSetType * levelSetUpdate = this->m_Associate->m_UpdateBuffer->GetLevelSet(*idListIt - 1);
+      levelSetUpdateImages[idListIdx] = levelSetUpdate->GetModifiableImage();
+      offsets[idListIdx] = levelSetUpdate->GetDomainOffset();
+      termContainers[idListIdx] = this->m_Associate->m_EquationContainer->GetEquation(*idListIt - 1);
+    }
+
     ImageRegionConstIteratorWithIndex<InputImageType> it(inputImage, *(mapIt->second.GetRegion()));
     it.GoToBegin();
 
     while (!it.IsAtEnd())
     {
-      const IdListType idList = *(mapIt->second.GetIdList());
-
-      // itkAssertInDebugOrThrowInReleaseMacro( !idList.empty() );
-
-      for (auto idListIt = idList.begin(); idListIt != idList.end(); ++idListIt)
+      const IndexType inputIndex = it.GetIndex();
+      for (idListIdx = 0; idListIdx < numberOfLevelSets; ++idListIdx)
       {
-        typename LevelSetType::Pointer levelSetUpdate = this->m_Associate->m_UpdateBuffer->GetLevelSet(*idListIt - 1);
-
-        OffsetType offset = levelSetUpdate->GetDomainOffset();
-        IndexType  levelSetIndex = it.GetIndex() - offset;
-
-        LevelSetDataType                    characteristics;
-        typename TermContainerType::Pointer termContainer =
-          this->m_Associate->m_EquationContainer->GetEquation(*idListIt - 1);
-        termContainer->ComputeRequiredData(it.GetIndex(), characteristics);
-        LevelSetOutputRealType tempUpdate = termContainer->Evaluate(it.GetIndex(), characteristics);
-
-        LevelSetImageType * levelSetImage = levelSetUpdate->GetModifiableImage();
-        levelSetImage->SetPixel(levelSetIndex, tempUpdate);
+        characteristics = blankCharacteristics;
+        termContainers[idListIdx]->ComputeRequiredData(inputIndex, characteristics);
+        LevelSetOutputRealType tempUpdate = termContainers[idListIdx]->Evaluate(inputIndex, characteristics);
+        levelSetUpdateImages[idListIdx]->SetPixel(inputIndex - offsets[idListIdx], tempUpdate);
       }
       ++it;
     }
@@ -20,6 +20,7 @@
 #define itkLevelSetSparseImage_h
 
 #include "itkDiscreteLevelSetImage.h"
+#include "itkImage.h"
 #include "itkObjectFactory.h"
 
 #include "itkLabelObject.h"
@@ -33,6 +34,14 @@ namespace itk
  *  \class LevelSetSparseImage
  *  \brief Base class for the sparse representation of a level-set function on one Image.
  *
+ *  The status of each pixel is stored in a LabelMap, whose GetPixel() goes
+ *  through all its lines. When UseStatusImage is on, Status() reads the
+ *  statuses from a dense image instead, computed from the LabelMap when it is
+ *  set or grafted, and by the level set update classes once they have
+ *  modified it. LevelSetEvolution turns UseStatusImage on while it evolves
+ *  the level set, and off afterwards, so that the label objects can be
+ *  changed in place the rest of the time.
+ *
  *  \tparam TImage Input image type of the level set function
  *  \todo Think about using image iterators instead of GetPixel()
  *
@@ -74,6 +83,9 @@ public:
   using LabelMapConstPointer = typename LabelMapType::ConstPointer;
   using RegionType = typename LabelMapType::RegionType;
 
+  using StatusImageType = Image<LayerIdType, VDimension>;
+  using StatusImagePointer = typename StatusImageType::Pointer;
+
   using LayerType = std::map<InputType, OutputType, Functor::LexicographicCompare>;
   using LayerIterator = typename LayerType::iterator;
   using LayerConstIterator = typename LayerType::const_iterator;
@@ -103,6 +115,22 @@ public:
   SetLabelMap(LabelMapType * labelMap);
   itkGetModifiableObjectMacro(LabelMap, LabelMapType);
 
+  /** Set/Get whether Status() reads the statuses from a dense image computed
+   * from the LabelMap, instead of searching the LabelMap. The image does not
+   * follow the label objects changed in place after it is computed. Off by
+   * default. */
+  virtual void
+  SetUseStatusImage(bool useStatusImage);
+  itkGetConstMacro(UseStatusImage, bool);
+  itkBooleanMacro(UseStatusImage);
+
+  /** Compute the statuses of the pixels of the LabelMap again when
+   * UseStatusImage is on, unless the LabelMap is not modified since they were
+   * computed. Called by the level set update classes once they have modified
+   * the LabelMap. */
+  void
+  UpdateStatusImage();
+
   /** Graft data object as level set object */
   void
   Graft(const DataObject * data) override;
@@ -120,6 +148,13 @@ protected:
   LabelMapPointer m_LabelMap;
   LayerIdListType m_InternalLabelList;
 
+  /** Whether Status() reads the statuses of the pixels of the LabelMap from
+   * an image, the image, and the modification time of the LabelMap when it
+   * was computed */
+  bool               m_UseStatusImage{ false };
+  StatusImagePointer m_StatusImage;
+  ModifiedTimeType   m_StatusImageMTime{ 0 };
+
   /** Initialize the sparse field layers */
   virtual void
   InitializeLayers() = 0;
@@ -130,6 +165,12 @@ protected:
   bool
   IsInsideDomain(const InputType & inputIndex) const override;
 
+  /** Look for the node at mapIndex in the layers, starting with the layer of
+   * the given status, which holds it unless the layers are being updated.
+   * Return false if the node is in no layer. */
+  bool
+  FindInLayers(const InputType & mapIndex, LayerIdType status, OutputType & value) const;
+
   /** Initialize the label map point and the sparse-field layers */
   void
   Initialize() override;
@@ -19,6 +19,7 @@
 #ifndef itkLevelSetSparseImage_hxx
 #define itkLevelSetSparseImage_hxx
 
+#include <algorithm>
 
 namespace itk
 {
@@ -28,6 +29,15 @@ auto
 LevelSetSparseImage<TOutput, VDimension>::Status(const InputType & inputIndex) const -> LayerIdType
 {
   InputType mapIndex = inputIndex - this->m_DomainOffset;
+
+  if (this->m_StatusImage.IsNotNull() && this->m_StatusImageMTime == this->m_LabelMap->GetMTime())
+  {
+    if (this->m_StatusImage->GetBufferedRegion().IsInside(mapIndex))
+    {
+      return this->m_StatusImage->GetPixel(mapIndex);
+    }
+    return this->m_LabelMap->GetBackgroundValue();
+  }
   return this->m_LabelMap->GetPixel(mapIndex);
 }
 
@@ -47,10 +57,113 @@ LevelSetSparseImage<TOutput, VDimension>::SetLabelMap(LabelMapType * labelMap)
     this->m_NeighborhoodScales[dim] =
       NumericTraits<OutputRealType>::OneValue() / static_cast<OutputRealType>(spacing[dim]);
   }
+  this->UpdateStatusImage();
   this->Modified();
 }
 
 
+template <typename TOutput, unsigned int VDimension>
+void
+LevelSetSparseImage<TOutput, VDimension>::SetUseStatusImage(bool useStatusImage)
+{
+  if (this->m_UseStatusImage != useStatusImage)
+  {
+    this->m_UseStatusImage = useStatusImage;
+    this->UpdateStatusImage();
+    this->Modified();
+  }
+}
+
+
+template <typename TOutput, unsigned int VDimension>
+void
+LevelSetSparseImage<TOutput, VDimension>::UpdateStatusImage()
+{
+  if (!this->m_UseStatusImage || this->m_LabelMap.IsNull())
+  {
+    this->m_StatusImage = nullptr;
+    return;
+  }
+  if (this->m_StatusImage.IsNotNull() && this->m_StatusImageMTime == this->m_LabelMap->GetMTime())
+  {
+    return;
+  }
+
+  // A label map without region, built pixel by pixel, is only read with GetPixel()
+  const RegionType region = this->m_LabelMap->GetLargestPossibleRegion();
+  if (region.GetNumberOfPixels() == 0)
+  {
+    this->m_StatusImage = nullptr;
+    return;
+  }
+
+  auto statusImage = StatusImageType::New();
+  statusImage->SetRegions(region);
+  statusImage->Allocate();
+  statusImage->FillBuffer(this->m_LabelMap->GetBackgroundValue());
+
+  const IndexValueType firstX = region.GetIndex(0);
+  const IndexValueType endX = firstX + static_cast<IndexValueType>(region.GetSize(0));
+  LayerIdType *        buffer = statusImage->GetBufferPointer();
+
+  for (typename LabelMapType::ConstIterator objectIt(this->m_LabelMap); !objectIt.IsAtEnd(); ++objectIt)
+  {
+    const LabelObjectType * labelObject = objectIt.GetLabelObject();
+    const LayerIdType       label = labelObject->GetLabel();
+    const SizeValueType     numberOfLines = labelObject->GetNumberOfLines();
+
+    for (SizeValueType i = 0; i < numberOfLines; ++i)
+    {
+      const LabelObjectLineType & line = labelObject->GetLine(i);
+      InputType                   lineIndex = line.GetIndex();
+      const IndexValueType        lineEnd =
+        std::min(lineIndex[0] + static_cast<IndexValueType>(line.GetLength()), endX);
+      lineIndex[0] = std::max(lineIndex[0], firstX);
+      if (lineIndex[0] < lineEnd && region.IsInside(lineIndex))
+      {
+        std::fill_n(buffer + statusImage->ComputeOffset(lineIndex), lineEnd - lineIndex[0], label);
+      }
+    }
+  }
+
+  this->m_StatusImage = statusImage;
+  this->m_StatusImageMTime = this->m_LabelMap->GetMTime();
+}
+
+
+template <typename TOutput, unsigned int VDimension>
+bool
+LevelSetSparseImage<TOutput, VDimension>::FindInLayers(const InputType & mapIndex,
+                                                      LayerIdType       status,
+                                                      OutputType &      value) const
+{
+  const LayerMapConstIterator statusLayerIt = this->m_Layers.find(status);
+  if (statusLayerIt != this->m_Layers.end())
+  {
+    const LayerConstIterator it = statusLayerIt->second.find(mapIndex);
+    if (it != statusLayerIt->second.end())
+    {
+      value = it->second;
+      return true;
+    }
+  }
+
+  for (auto layerIt = this->m_Layers.begin(); layerIt != this->m_Layers.end(); ++layerIt)
+  {
+    if (layerIt != statusLayerIt)
+    {
+      const LayerConstIterator it = layerIt->second.find(mapIndex);
+      if (it != layerIt->second.end())
+      {
+        value = it->second;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+
 template <typename TOutput, unsigned int VDimension>
 bool
 LevelSetSparseImage<TOutput, VDimension>::IsInsideDomain(const InputType & inputIndex) const
@@ -77,7 +190,22 @@ LevelSetSparseImage<TOutput, VDimension>::Graft(const DataObject * data)
                       << typeid(Self *).name());
   }
 
-  this->m_LabelMap->Graft(levelSet->m_LabelMap);
+  if (this->m_LabelMap != levelSet->m_LabelMap)
+  {
+    this->m_LabelMap->Graft(levelSet->m_LabelMap);
+    this->m_LabelMap->Modified();
+  }
+  if (this->m_UseStatusImage && levelSet->m_StatusImage.IsNotNull() &&
+      levelSet->m_StatusImageMTime == levelSet->m_LabelMap->GetMTime())
+  {
+    // the statuses of the grafted label map are shared, and never modified in place
+    this->m_StatusImage = levelSet->m_StatusImage;
+    this->m_StatusImageMTime = this->m_LabelMap->GetMTime();
+  }
+  else
+  {
+    this->UpdateStatusImage();
+  }
   if (&m_Layers != &(levelSet->m_Layers))
   {
     m_Layers.clear();
@@ -136,6 +264,7 @@ LevelSetSparseImage<TOutput, VDimension>::Initialize()
   Superclass::Initialize();
 
   this->m_LabelMap = nullptr;
+  this->m_StatusImage = nullptr;
   this->InitializeLayers();
   this->InitializeInternalLabelList();
 }
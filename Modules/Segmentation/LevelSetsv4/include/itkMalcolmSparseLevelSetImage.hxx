@@ -35,36 +35,20 @@ template <unsigned int VDimension>
 auto
 MalcolmSparseLevelSetImage<VDimension>::Evaluate(const InputType & inputPixel) const -> OutputType
 {
-  InputType mapIndex = inputPixel - this->m_DomainOffset;
-  auto      layerIt = this->m_Layers.begin();
+  const InputType   mapIndex = inputPixel - this->m_DomainOffset;
+  const LayerIdType status = this->Status(inputPixel);
 
-  while (layerIt != this->m_Layers.end())
+  OutputType value;
+  if (this->FindInLayers(mapIndex, status, value))
   {
-    auto it = (layerIt->second).find(mapIndex);
-    if (it != (layerIt->second).end())
-    {
-      return it->second;
-    }
-
-    ++layerIt;
+    return value;
   }
 
-  if (this->m_LabelMap->GetLabelObject(MinusOneLayer())->HasIndex(mapIndex))
-  {
-    return MinusOneLayer();
-  }
-  else
+  if (status != MinusOneLayer() && status != PlusOneLayer())
   {
-    char status = this->m_LabelMap->GetPixel(mapIndex);
-    if (status == PlusOneLayer())
-    {
-      return PlusOneLayer();
-    }
-    else
-    {
-      itkGenericExceptionMacro(<< "status " << static_cast<int>(status) << " should be 1 or -1");
-    }
+    itkGenericExceptionMacro(<< "status " << static_cast<int>(status) << " should be 1 or -1");
   }
+  return status;
 }
 
 // ----------------------------------------------------------------------------
@@ -34,37 +34,20 @@ template <unsigned int VDimension>
 auto
 ShiSparseLevelSetImage<VDimension>::Evaluate(const InputType & inputIndex) const -> OutputType
 {
-  InputType mapIndex = inputIndex - this->m_DomainOffset;
-  auto      layerIt = this->m_Layers.begin();
+  const InputType   mapIndex = inputIndex - this->m_DomainOffset;
+  const LayerIdType status = this->Status(inputIndex);
 
-  while (layerIt != this->m_Layers.end())
+  OutputType value;
+  if (this->FindInLayers(mapIndex, status, value))
   {
-    auto it = (layerIt->second).find(mapIndex);
-    if (it != (layerIt->second).end())
-    {
-      return it->second;
-    }
-
-    ++layerIt;
+    return value;
   }
 
-  if (this->m_LabelMap->GetLabelObject(this->MinusThreeLayer())->HasIndex(mapIndex))
-  {
-    return static_cast<OutputType>(this->MinusThreeLayer());
-  }
-  else
+  if (status != this->MinusThreeLayer() && status != this->PlusThreeLayer())
   {
-    const LayerIdType status = this->m_LabelMap->GetPixel(mapIndex);
-
-    if (status == this->PlusThreeLayer())
-    {
-      return static_cast<OutputType>(this->PlusThreeLayer());
-    }
-    else
-    {
-      itkGenericExceptionMacro(<< "status " << static_cast<int>(status) << " should be 3 or -3");
-    }
+    itkGenericExceptionMacro(<< "status " << static_cast<int>(status) << " should be 3 or -3");
   }
+  return static_cast<OutputType>(status);
 }
 
 
@@ -172,6 +172,9 @@ UpdateShiSparseLevelSet<VDimension, TEquationContainer>::Update()
 
   LevelSetLabelMapPointer outputLabelMap = this->m_OutputLevelSet->GetModifiableLabelMap();
   outputLabelMap->Graft(labelImageToLabelMapFilter->GetOutput());
+  outputLabelMap->Modified();
+  this->m_OutputLevelSet->SetUseStatusImage(this->m_InputLevelSet->GetUseStatusImage());
+  this->m_OutputLevelSet->UpdateStatusImage();
 }
 
 template <unsigned int VDimension, typename TEquationContainer>
@@ -171,7 +171,11 @@ UpdateWhitakerSparseLevelSet<VDimension, TLevelSetValueType, TEquationContainer>
   labelImageToLabelMapFilter->SetBackgroundValue(LevelSetType::PlusThreeLayer());
   labelImageToLabelMapFilter->Update();
 
-  this->m_OutputLevelSet->GetModifiableLabelMap()->Graft(labelImageToLabelMapFilter->GetOutput());
+  LevelSetLabelMapPointer outputLabelMap = this->m_OutputLevelSet->GetModifiableLabelMap();
+  outputLabelMap->Graft(labelImageToLabelMapFilter->GetOutput());
+  outputLabelMap->Modified();
+  this->m_OutputLevelSet->SetUseStatusImage(this->m_InputLevelSet->GetUseStatusImage());
+  this->m_OutputLevelSet->UpdateStatusImage();
   this->m_TempPhi.clear();
 }
 
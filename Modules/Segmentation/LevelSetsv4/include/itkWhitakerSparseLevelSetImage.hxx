@@ -34,50 +34,30 @@ template <typename TOutput, unsigned int VDimension>
 auto
 WhitakerSparseLevelSetImage<TOutput, VDimension>::Evaluate(const InputType & inputIndex) const -> OutputType
 {
-  InputType mapIndex = inputIndex - this->m_DomainOffset;
-  auto      layerIt = this->m_Layers.begin();
+  const InputType mapIndex = inputIndex - this->m_DomainOffset;
 
-  auto rval = static_cast<OutputType>(ZeroLayer());
-
-  while (layerIt != this->m_Layers.end())
+  if (this->m_LabelMap.IsNull())
   {
-    auto it = (layerIt->second).find(mapIndex);
-    if (it != (layerIt->second).end())
+    auto rval = static_cast<OutputType>(ZeroLayer());
+    if (!this->FindInLayers(mapIndex, ZeroLayer(), rval))
     {
-      rval = it->second;
-      break;
+      itkGenericExceptionMacro(<< "Note: m_LabelMap is nullptr");
     }
+    return rval;
+  }
 
-    ++layerIt;
+  const LayerIdType status = this->Status(inputIndex);
+  auto              rval = static_cast<OutputType>(ZeroLayer());
+  if (this->FindInLayers(mapIndex, status, rval))
+  {
+    return rval;
   }
-  // if layer not found, look using label map
-  if (layerIt == this->m_Layers.end())
+  // if layer not found, the status is the value
+  if (status != MinusThreeLayer() && status != PlusThreeLayer())
   {
-    if (this->m_LabelMap.IsNotNull())
-    {
-      if (this->m_LabelMap->GetLabelObject(MinusThreeLayer())->HasIndex(mapIndex))
-      {
-        rval = static_cast<OutputType>(MinusThreeLayer());
-      }
-      else
-      {
-        char status = this->m_LabelMap->GetPixel(mapIndex);
-        if (status == this->PlusThreeLayer())
-        {
-          rval = static_cast<OutputType>(this->PlusThreeLayer());
-        }
-        else
-        {
-          itkGenericExceptionMacro(<< "status " << static_cast<int>(status) << " should be 3 or -3");
-        }
-      }
-    }
-    else
-    {
-      itkGenericExceptionMacro(<< "Note: m_LabelMap is nullptr");
-    }
+    itkGenericExceptionMacro(<< "status " << static_cast<int>(status) << " should be 3 or -3");
   }
-  return rval;
+  return static_cast<OutputType>(status);
 }
 
 
@@ -66,5 +66,70 @@ itkWhitakerSparseLevelSetImageTest(int, char *[])
     return EXIT_FAILURE;
   }
 
+  // By default, the statuses are read from the label map, even when its label objects are changed in place
+  LabelMapType::SizeType size;
+  size.Fill(10);
+  labelMap->SetRegions(size);
+  phi->SetLabelMap(labelMap);
+
+  ITK_TEST_EXPECT_TRUE(!phi->GetUseStatusImage());
+
+  labelMap->GetLabelObject(-3)->RemoveIndex(index);
+  if (phi->Status(index) != 3 || itk::Math::NotExactlyEquals(phi->Evaluate(index), 3))
+  {
+    std::cout << index << ' ' << phi->Evaluate(index) << " != 3" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  labelMap->GetLabelObject(-3)->AddIndex(index);
+  if (phi->Status(index) != -3 || itk::Math::NotExactlyEquals(phi->Evaluate(index), -3))
+  {
+    std::cout << index << ' ' << phi->Evaluate(index) << " != -3" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // With UseStatusImage, the statuses are read from an image computed from the label map
+  ITK_TEST_SET_GET_BOOLEAN(phi, UseStatusImage, true);
+
+  if (phi->Status(index) != -3 || itk::Math::NotExactlyEquals(phi->Evaluate(index), -3))
+  {
+    std::cout << index << ' ' << phi->Evaluate(index) << " != -3" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // and from the label map once it is modified
+  labelMap->SetPixel(index, 3);
+  if (phi->Status(index) != 3 || itk::Math::NotExactlyEquals(phi->Evaluate(index), 3))
+  {
+    std::cout << index << ' ' << phi->Evaluate(index) << " != 3" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  index[1] = 5;
+  if (phi->Status(index) != -3)
+  {
+    std::cout << index << ' ' << static_cast<int>(phi->Status(index)) << " != -3" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // UpdateStatusImage computes the image again once the label map is modified
+  labelMap->GetLabelObject(-3)->RemoveIndex(index);
+  labelMap->Modified();
+  phi->UpdateStatusImage();
+  if (phi->Status(index) != 3)
+  {
+    std::cout << index << ' ' << static_cast<int>(phi->Status(index)) << " != 3" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Turning UseStatusImage off reads the label objects changed in place again
+  labelMap->GetLabelObject(-3)->AddIndex(index);
+  phi->UseStatusImageOff();
+  if (phi->Status(index) != -3)
+  {
+    std::cout << index << ' ' << static_cast<int>(phi->Status(index)) << " != -3" << std::endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
@@ -135,7 +135,21 @@ extern ITKMarkovRandomFieldsClassifiers_EXPORT std::ostream &
  * in the previous iteration. The pixels' classification is updated using a
  * synchronous scheme (iteration by iteration) until the error reaches
  * less than the threshold or the number of iteration exceed the maximum set
- * number of iterations. Note: The current implementation supports betaMatrix
+ * number of iterations.
+ *
+ * By default, the pixels are visited sequentially in raster order. When
+ * MulticolorICM is on, the pixels are instead visited by colors, the color of
+ * a pixel being its index modulo the size of the neighborhood along each
+ * dimension, as in the red-black ordering of the face connected
+ * neighborhoods. The neighborhoods of two pixels of the same color do not
+ * overlap, so the pixels of a color are examined concurrently by the work
+ * units of the filter, and the labels do not depend on the number of threads.
+ * Only the pixels whose classification or neighbor classifications changed
+ * since they were last examined are examined again. As ICM converges to a
+ * local minimum that depends on the visiting order, the labels differ from
+ * the ones of the raster order sweep. DoNeighborhoodOperation is then called
+ * by several threads at the same time, and must not modify the filter.
+ * Note: The current implementation supports betaMatrix
  * default weight for two and three dimensional images only. The default for
  * higher dimension is set to unity. This should be overridden by custom
  * weights after filter initialization.
@@ -267,6 +281,13 @@ public:
   itkSetMacro(SmoothingFactor, double);
   itkGetConstMacro(SmoothingFactor, double);
 
+  /** Set/Get whether the pixels are visited by colors and labelled
+   * concurrently by the work units, instead of sequentially in raster order.
+   * The labels of the two sweeps differ. Off by default. */
+  itkSetMacro(MulticolorICM, bool);
+  itkGetConstMacro(MulticolorICM, bool);
+  itkBooleanMacro(MulticolorICM);
+
   /** Set the neighborhood radius */
   void
   SetNeighborhoodRadius(const NeighborhoodRadiusType &);
@@ -411,12 +432,11 @@ private:
   double *     m_ClassProbability{ nullptr }; // Class liklihood
   unsigned int m_NumberOfIterations{ 0 };
   MRFStopEnum  m_StopCondition{ MRFStopEnum::MaximumNumberOfIterations };
+  bool         m_MulticolorICM{ false };
 
   LabelStatusImagePointer m_LabelStatusImage;
 
   std::vector<double> m_MRFNeighborhoodWeight;
-  std::vector<double> m_NeighborInfluence;
-  std::vector<double> m_MahalanobisDistance;
   std::vector<double> m_DummyVector;
 
   /** Pointer to the classifier to be used for the MRF labelling. */
@@ -428,9 +448,21 @@ private:
   virtual void
   SetDefaultMRFNeighborhoodWeight();
 
+  /** Number of classes whose neighborhood influence is computed on the
+   * stack. */
+  static constexpr unsigned int MaximumNumberOfClassesOnStack = 16;
+
   // Function implementing the ICM algorithm to label the images
   void
   ApplyICMLabeller();
+
+  /** Label the pixels by colors, concurrently, when MulticolorICM is on. */
+  void
+  ApplyMulticolorICMLabeller();
+
+  /** Examine the pixels of the region having the color of colorIndex. */
+  void
+  ThreadedApplyICMLabeller(const InputImageRegionType & regionForThread, const LabelledImageIndexType & colorIndex);
 }; // class MRFImageFilter
 } // namespace itk
 
@@ -18,6 +18,7 @@
 #ifndef itkMRFImageFilter_hxx
 #define itkMRFImageFilter_hxx
 #include "itkPrintHelper.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -34,7 +35,6 @@ MRFImageFilter<TInputImage, TClassifiedImage>::MRFImageFilter()
   }
   m_InputImageNeighborhoodRadius.Fill(0);
   m_MRFNeighborhoodWeight.resize(0);
-  m_NeighborInfluence.resize(0);
   m_DummyVector.resize(0);
   this->SetMRFNeighborhoodWeight(m_DummyVector);
   this->SetDefaultMRFNeighborhoodWeight();
@@ -68,6 +68,8 @@ MRFImageFilter<TInputImage, TClassifiedImage>::PrintSelf(std::ostream & os, Inde
 
   os << indent << "StopCondition: " << m_StopCondition << std::endl;
 
+  os << indent << " Multicolor ICM: " << (m_MulticolorICM ? "On" : "Off") << std::endl;
+
   os << indent << " Number of iterations: " << m_NumberOfIterations << std::endl;
 } // end PrintSelf
 
@@ -455,23 +457,17 @@ template <typename TInputImage, typename TClassifiedImage>
 void
 MRFImageFilter<TInputImage, TClassifiedImage>::ApplyICMLabeller()
 {
-  //---------------------------------------------------------------------
-  // Loop through the data set and classify the data
-  //---------------------------------------------------------------------
-  m_NeighborInfluence.resize(m_NumberOfClasses);
-
-  // Varible to store the input pixel vector value
-  // InputImagePixelType inputPixel;
-
-  m_MahalanobisDistance.resize(m_NumberOfClasses);
+  if (m_MulticolorICM)
+  {
+    this->ApplyMulticolorICMLabeller();
+    return;
+  }
 
   //---------------------------------------------------------------------
   // Set up the neighborhood iterators and the valid neighborhoods
   // for iteration
   //---------------------------------------------------------------------
 
-  // Set up the nighborhood iterators
-
   // Define the face list for the input/labelled image
   InputImageFacesCalculator       inputImageFacesCalculator;
   LabelledImageFacesCalculator    labelledImageFacesCalculator;
@@ -522,6 +518,131 @@ MRFImageFilter<TInputImage, TClassifiedImage>::ApplyICMLabeller()
   }
 } // ApplyICMlabeller
 
+template <typename TInputImage, typename TClassifiedImage>
+void
+MRFImageFilter<TInputImage, TClassifiedImage>::ApplyMulticolorICMLabeller()
+{
+  //---------------------------------------------------------------------
+  // Walk through the interior of the data set (not visiting the
+  // boundaries), one color of pixels at a time
+  //---------------------------------------------------------------------
+  InputImageConstPointer inputImage = this->GetInput();
+  InputImageFacesCalculator inputImageFacesCalculator;
+  InputImageFaceListType    inputImageFaceList =
+    inputImageFacesCalculator(inputImage, inputImage->GetBufferedRegion(), m_InputImageNeighborhoodRadius);
+  const InputImageRegionType interiorRegion = *inputImageFaceList.begin();
+  if (interiorRegion.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // The colors are the positions of the pixels modulo twice the radius plus
+  // one: the neighborhoods of two pixels of the same color do not overlap, so
+  // the pixels of a color are labelled concurrently
+  SizeValueType numberOfColors = 1;
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  {
+    numberOfColors *= 2 * m_InputImageNeighborhoodRadius[i] + 1;
+  }
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  for (SizeValueType color = 0; color < numberOfColors; ++color)
+  {
+    LabelledImageIndexType colorIndex = interiorRegion.GetIndex();
+    SizeValueType          position = color;
+    for (unsigned int i = 0; i < InputImageDimension; ++i)
+    {
+      const SizeValueType spacing = 2 * m_InputImageNeighborhoodRadius[i] + 1;
+      colorIndex[i] += static_cast<IndexValueType>(position % spacing);
+      position /= spacing;
+    }
+
+    multiThreader->template ParallelizeImageRegion<InputImageDimension>(
+      interiorRegion,
+      [this, &colorIndex](const InputImageRegionType & regionForThread) {
+        this->ThreadedApplyICMLabeller(regionForThread, colorIndex);
+      },
+      nullptr);
+  }
+} // ApplyMulticolorICMLabeller
+
+template <typename TInputImage, typename TClassifiedImage>
+void
+MRFImageFilter<TInputImage, TClassifiedImage>::ThreadedApplyICMLabeller(const InputImageRegionType &   regionForThread,
+                                                                        const LabelledImageIndexType & colorIndex)
+{
+  // The pixels of the color in the region, from first to last
+  LabelledImageOffsetType spacing;
+  LabelledImageIndexType  first;
+  LabelledImageIndexType  last;
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  {
+    spacing[i] = static_cast<IndexValueType>(2 * m_InputImageNeighborhoodRadius[i] + 1);
+    const IndexValueType start = regionForThread.GetIndex(i);
+    first[i] = start + ((colorIndex[i] - start) % spacing[i] + spacing[i]) % spacing[i];
+    last[i] = start + static_cast<IndexValueType>(regionForThread.GetSize(i)) - 1;
+    if (first[i] > last[i])
+    {
+      return;
+    }
+  }
+  LabelledImageOffsetType lineStep;
+  lineStep.Fill(0);
+  lineStep[0] = spacing[0];
+
+  InputImageNeighborhoodIterator nInputImageNeighborhoodIter(
+    m_InputImageNeighborhoodRadius, this->GetInput(), regionForThread);
+
+  LabelledImageNeighborhoodIterator nLabelledImageNeighborhoodIter(
+    m_LabelledImageNeighborhoodRadius, m_ClassifierPtr->GetClassifiedImage(), regionForThread);
+
+  LabelStatusImageNeighborhoodIterator nLabelStatusImageNeighborhoodIter(
+    m_LabelStatusImageNeighborhoodRadius, m_LabelStatusImage, regionForThread);
+
+  LabelledImageIndexType index = first;
+  while (true)
+  {
+    nInputImageNeighborhoodIter.SetLocation(index);
+    nLabelledImageNeighborhoodIter.SetLocation(index);
+    nLabelStatusImageNeighborhoodIter.SetLocation(index);
+    for (IndexValueType x = first[0];;)
+    {
+      // A pixel whose label and neighbor labels did not change since it was
+      // last processed keeps its label
+      if (nLabelStatusImageNeighborhoodIter.GetCenterPixel() != 0)
+      {
+        this->DoNeighborhoodOperation(
+          nInputImageNeighborhoodIter, nLabelledImageNeighborhoodIter, nLabelStatusImageNeighborhoodIter);
+      }
+
+      x += spacing[0];
+      if (x > last[0])
+      {
+        break;
+      }
+      nInputImageNeighborhoodIter += lineStep;
+      nLabelledImageNeighborhoodIter += lineStep;
+      nLabelStatusImageNeighborhoodIter += lineStep;
+    }
+
+    unsigned int i = 1;
+    for (; i < InputImageDimension; ++i)
+    {
+      index[i] += spacing[i];
+      if (index[i] <= last[i])
+      {
+        break;
+      }
+      index[i] = first[i];
+    }
+    if (i == InputImageDimension)
+    {
+      break;
+    }
+  }
+}
+
 //-------------------------------------------------------
 //-------------------------------------------------------
 // Function that performs the MRF operation with each neighborhood
@@ -541,36 +662,32 @@ MRFImageFilter<TInputImage, TClassifiedImage>::DoNeighborhoodOperation(
 
   const std::vector<double> & pixelMembershipValue = m_ClassifierPtr->GetPixelMembershipValue(*inputPixelVec);
 
-  // Reinitialize the neighborhood influence at the beginning of the
-  // neighborhood operation
-  for (index = 0; index < m_NeighborInfluence.size(); ++index)
+  // The neighborhood influence of each class, on the stack of the work unit
+  // for the usual numbers of classes
+  double              neighborInfluenceOnStack[MaximumNumberOfClassesOnStack];
+  std::vector<double> neighborInfluenceOnHeap;
+  double *            neighborInfluence = neighborInfluenceOnStack;
+  if (m_NumberOfClasses > MaximumNumberOfClassesOnStack)
   {
-    m_NeighborInfluence[index] = 0;
+    neighborInfluenceOnHeap.resize(m_NumberOfClasses);
+    neighborInfluence = neighborInfluenceOnHeap.data();
   }
-
-  LabelledImagePixelType labelledPixel;
+  std::fill_n(neighborInfluence, m_NumberOfClasses, 0.0);
 
   // Begin neighborhood processing. Calculate the prior for each label
   for (int i = 0; i < m_NeighborhoodSize; ++i)
   {
-    labelledPixel = labelledIter.GetPixel(i);
-    index = static_cast<unsigned int>(labelledPixel);
-    m_NeighborInfluence[index] += m_MRFNeighborhoodWeight[i];
+    index = static_cast<unsigned int>(labelledIter.GetPixel(i));
+    neighborInfluence[index] += m_MRFNeighborhoodWeight[i];
   } // End neighborhood processing
 
-  // Add the prior probability to the pixel probability
-  for (index = 0; index < m_NumberOfClasses; ++index)
-  {
-    m_MahalanobisDistance[index] = m_NeighborInfluence[index] - pixelMembershipValue[index];
-  }
-
-  // Determine the maximum possible distance
+  // Add the prior probability to the pixel probability, and determine the
+  // maximum possible distance
   double maximumDistance = -1e+20;
   int    pixLabel = -1;
-  double tmpPixDistance;
   for (index = 0; index < m_NumberOfClasses; ++index)
   {
-    tmpPixDistance = m_MahalanobisDistance[index];
+    const double tmpPixDistance = neighborInfluence[index] - pixelMembershipValue[index];
     if (tmpPixDistance > maximumDistance)
     {
       maximumDistance = tmpPixDistance;
@@ -0,0 +1,140 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMRFImageFilter.h"
+#include "itkDistanceToCentroidMembershipFunction.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMinimumDecisionRule.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Label a noisy image of three classes by colors (MulticolorICM) with several
+ * work units, and check that the labels and the number of iterations are the
+ * same as with a single work unit.
+ */
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using VectorImageType = itk::Image<itk::Vector<double, 1>, Dimension>;
+using LabelImageType = itk::Image<unsigned short, Dimension>;
+using MRFImageFilterType = itk::MRFImageFilter<VectorImageType, LabelImageType>;
+using RadiusType = MRFImageFilterType::NeighborhoodRadiusType;
+
+int
+itkMRFImageFilterWorkUnitsTestRun(const VectorImageType *   image,
+                                  const RadiusType &        radius,
+                                  unsigned int              numberOfWorkUnits,
+                                  LabelImageType::Pointer & labels,
+                                  unsigned int &            numberOfIterations)
+{
+  using ClassifierType = itk::ImageClassifierBase<VectorImageType, LabelImageType>;
+  using MembershipFunctionType = itk::Statistics::DistanceToCentroidMembershipFunction<VectorImageType::PixelType>;
+
+  auto classifier = ClassifierType::New();
+  classifier->SetDecisionRule(itk::Statistics::MinimumDecisionRule::New());
+  MembershipFunctionType::CentroidType centroid(1);
+  for (double mean : { 0.0, 50.0, 100.0 })
+  {
+    auto membershipFunction = MembershipFunctionType::New();
+    centroid[0] = mean;
+    membershipFunction->SetCentroid(centroid);
+    classifier->AddMembershipFunction(membershipFunction);
+  }
+
+  auto filter = MRFImageFilterType::New();
+  filter->SetInput(image);
+  filter->SetNumberOfClasses(3);
+  filter->SetClassifier(classifier);
+  filter->SetMaximumNumberOfIterations(30);
+  filter->SetErrorTolerance(1e-7);
+  filter->SetSmoothingFactor(3);
+  filter->SetNeighborhoodRadius(radius);
+  filter->MulticolorICMOn();
+  filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  numberOfIterations = filter->GetNumberOfIterations();
+  labels = filter->GetOutput();
+  labels->DisconnectPipeline();
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkMRFImageFilterWorkUnitsTest(int, char *[])
+{
+  // The raster order sweep is the default
+  auto filter = MRFImageFilterType::New();
+  ITK_TEST_EXPECT_TRUE(!filter->GetMulticolorICM());
+  ITK_TEST_SET_GET_BOOLEAN(filter, MulticolorICM, true);
+
+  // Three vertical bands of means 0, 50 and 100, with a deterministic noise
+  // large enough for the initial classification to be wrong at many pixels.
+  auto image = VectorImageType::New();
+  image->SetRegions(VectorImageType::SizeType{ { 97, 61 } });
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<VectorImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const auto &               index = it.GetIndex();
+    VectorImageType::PixelType value;
+    value[0] = 50.0 * (3 * index[0] / 97) + ((index[0] * 7919 + index[1] * 104729) % 61) - 30.0;
+    it.Set(value);
+  }
+
+  for (const RadiusType & radius : { RadiusType{ { 1, 1 } }, RadiusType{ { 2, 1 } } })
+  {
+    LabelImageType::Pointer reference;
+    unsigned int            referenceNumberOfIterations = 0;
+    if (itkMRFImageFilterWorkUnitsTestRun(image, radius, 1, reference, referenceNumberOfIterations) != EXIT_SUCCESS)
+    {
+      return EXIT_FAILURE;
+    }
+    std::cout << "Neighborhood radius: " << radius << ", number of iterations: " << referenceNumberOfIterations
+              << std::endl;
+
+    for (unsigned int numberOfWorkUnits : { 2, 3, 8 })
+    {
+      LabelImageType::Pointer labels;
+      unsigned int            numberOfIterations = 0;
+      if (itkMRFImageFilterWorkUnitsTestRun(image, radius, numberOfWorkUnits, labels, numberOfIterations) !=
+          EXIT_SUCCESS)
+      {
+        return EXIT_FAILURE;
+      }
+      ITK_TEST_EXPECT_EQUAL(numberOfIterations, referenceNumberOfIterations);
+
+      itk::ImageRegionConstIterator<LabelImageType> referenceIt(reference, reference->GetBufferedRegion());
+      itk::ImageRegionConstIterator<LabelImageType> labelIt(labels, labels->GetBufferedRegion());
+      for (; !referenceIt.IsAtEnd(); ++referenceIt, ++labelIt)
+      {
+        if (labelIt.Get() != referenceIt.Get())
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "With " << numberOfWorkUnits << " work units, the label at " << referenceIt.GetIndex()
+                    << " is " << labelIt.Get() << " instead of " << referenceIt.Get() << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -24,8 +24,8 @@
 #include "itkImageNeighborhoodOffsets.h"
 #include "itkShapedImageNeighborhoodRange.h"
 #include "itkBinaryThresholdImageFunction.h"
-#include "itkFloodFilledImageFunctionConditionalIterator.h"
-#include "itkProgressReporter.h"
+#include "itkParallelFloodFill.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -123,10 +123,6 @@ void
 ConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
 {
   using FunctionType = BinaryThresholdImageFunction<InputImageType, double>;
-  using SecondFunctionType = BinaryThresholdImageFunction<OutputImageType, double>;
-
-  using IteratorType = FloodFilledImageFunctionConditionalIterator<OutputImageType, FunctionType>;
-  using SecondIteratorType = FloodFilledImageFunctionConditionalConstIterator<InputImageType, SecondFunctionType>;
 
   unsigned int loop;
 
@@ -282,49 +278,54 @@ ConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
   itkDebugMacro(<< "\nLower intensity = " << lower << ", Upper intensity = " << upper << "\nmean = " << m_Mean
                 << " , std::sqrt(variance) = " << std::sqrt(m_Variance));
 
-  // Segment the image, the iterator walks the output image (so Set()
-  // writes into the output image), starting at the seed point.  As
-  // the iterator walks, if the corresponding pixel in the input image
-  // (accessed via the "function" assigned to the iterator) is within
-  // the [lower, upper] bounds prescribed, the pixel is added to the
-  // output segmentation and its neighbors become candidates for the
-  // iterator to walk.
-  IteratorType it = IteratorType(outputImage, function, m_Seeds);
-  it.GoToBegin();
-  while (!it.IsAtEnd())
-  {
-    it.Set(m_ReplaceValue);
-    ++it;
-  }
+  // Segment the image: the pixels connected to the seeds whose value in the
+  // input image (accessed via the "function") is within the [lower, upper]
+  // bounds prescribed are filled with several threads. The seeds outside of
+  // the bounds are not filled.
+  ParallelFloodFill<OutputImageType::ImageDimension> floodFill(region);
+
+  const float progressWeight = 1.0f / static_cast<float>(m_NumberOfIterations + 1);
+
+  const auto segment = [&]() {
+    SeedsContainerType seeds;
+    for (const IndexType & seed : m_Seeds)
+    {
+      if (region.IsInside(seed) && function->EvaluateAtIndex(seed))
+      {
+        seeds.push_back(seed);
+      }
+    }
+    floodFill.Fill(
+      seeds,
+      [&function](const IndexType & index) { return function->EvaluateAtIndex(index); },
+      this->GetMultiThreader(),
+      this,
+      progressWeight);
+  };
 
-  ProgressReporter progress(this, 0, region.GetNumberOfPixels() * m_NumberOfIterations);
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  segment();
 
   for (loop = 0; loop < m_NumberOfIterations; ++loop)
   {
     // Now that we have an initial segmentation, let's recalculate the
-    // statistics.  Since we have already labelled the output, we visit
-    // pixels in the input image that have been set in the output image.
-    // Essentially, we flip the iterator around, so we walk the input
-    // image (so Get() will get pixel values from the input) and constrain
-    // iterator such it only visits pixels that were set in the output.
-    auto secondFunction = SecondFunctionType::New();
-    secondFunction->SetInputImage(outputImage);
-    secondFunction->ThresholdBetween(m_ReplaceValue, m_ReplaceValue);
-
+    // statistics over the pixels of the input image which have been filled,
+    // in the order of the image buffer.
     typename NumericTraits<typename InputImageType::PixelType>::RealType sum, sumOfSquares;
     sum = NumericTraits<InputRealType>::ZeroValue();
     sumOfSquares = NumericTraits<InputRealType>::ZeroValue();
     typename TOutputImage::SizeValueType numberOfSamples = 0;
 
-    SecondIteratorType sit = SecondIteratorType(inputImage, secondFunction, m_Seeds);
-    sit.GoToBegin();
-    while (!sit.IsAtEnd())
+    for (const auto & run : floodFill.GetRuns())
     {
-      const auto value = static_cast<InputRealType>(sit.Get());
-      sum += value;
-      sumOfSquares += value * value;
-      ++numberOfSamples;
-      ++sit;
+      IndexType index = run.m_Index;
+      for (SizeValueType i = 0; i < run.m_Length; ++i, ++index[0])
+      {
+        const auto value = static_cast<InputRealType>(inputImage->GetPixel(index));
+        sum += value;
+        sumOfSquares += value * value;
+      }
+      numberOfSamples += run.m_Length;
     }
     m_Mean = sum / static_cast<double>(numberOfSamples);
     m_Variance = (sumOfSquares - (sum * sum / static_cast<double>(numberOfSamples))) /
@@ -369,24 +370,10 @@ ConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
                   << ", variance = " << m_Variance << " , std::sqrt(variance) = " << std::sqrt(m_Variance));
     itkDebugMacro(<< "\nsum = " << sum << ", sumOfSquares = " << sumOfSquares << "\nnum = " << numberOfSamples);
 
-    // Rerun the segmentation, the iterator walks the output image,
-    // starting at the seed point.  As the iterator walks, if the
-    // corresponding pixel in the input image (accessed via the
-    // "function" assigned to the iterator) is within the [lower,
-    // upper] bounds prescribed, the pixel is added to the output
-    // segmentation and its neighbors become candidates for the
-    // iterator to walk.
-    outputImage->FillBuffer(NumericTraits<OutputImagePixelType>::ZeroValue());
-    IteratorType thirdIt = IteratorType(outputImage, function, m_Seeds);
-    thirdIt.GoToBegin();
+    // Rerun the segmentation with the new bounds
     try
     {
-      while (!thirdIt.IsAtEnd())
-      {
-        thirdIt.Set(m_ReplaceValue);
-        ++thirdIt;
-        progress.CompletedPixel(); // potential exception thrown here
-      }
+      segment(); // potential exception thrown here
     }
     catch (const ProcessAborted &)
     {
@@ -401,6 +388,12 @@ ConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
     e.SetDescription("Process aborted.");
     throw ProcessAborted(__FILE__, __LINE__);
   }
+
+  OutputImagePixelType * buffer = outputImage->GetBufferPointer();
+  for (const auto & run : floodFill.GetRuns())
+  {
+    std::fill_n(buffer + outputImage->ComputeOffset(run.m_Index), run.m_Length, m_ReplaceValue);
+  }
 }
 } // end namespace itk
 
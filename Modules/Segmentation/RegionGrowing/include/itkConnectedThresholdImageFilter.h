@@ -58,6 +58,10 @@ extern ITKRegionGrowing_EXPORT std::ostream &
  * connected to an initial Seed AND lie within a Lower and Upper
  * threshold range.
  *
+ * The connected pixels are filled by runs along the first dimension,
+ * with the work units of the filter (see ParallelFloodFill). The output
+ * does not depend on the number of work units.
+ *
  * \ingroup RegionGrowingSegmentation
  * \ingroup ITKRegionGrowing
  * \sphinx
@@ -19,11 +19,9 @@
 #define itkConnectedThresholdImageFilter_hxx
 
 #include "itkBinaryThresholdImageFunction.h"
-#include "itkFloodFilledImageFunctionConditionalIterator.h"
-#include "itkProgressReporter.h"
-
-#include "itkShapedFloodFilledImageFunctionConditionalIterator.h"
+#include "itkParallelFloodFill.h"
 #include "itkMath.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -240,39 +238,32 @@ ConnectedThresholdImageFilter<TInputImage, TOutputImage>::GenerateData()
   function->SetInputImage(inputImage);
   function->ThresholdBetween(lower, upper);
 
-  ProgressReporter progress(this, 0, region.GetNumberOfPixels());
-
-  if (this->m_Connectivity == ConnectivityEnum::FaceConnectivity)
+  // The seeds outside of the thresholds are not filled
+  SeedContainerType seeds;
+  for (const IndexType & seed : m_Seeds)
   {
-    using IteratorType = FloodFilledImageFunctionConditionalIterator<OutputImageType, FunctionType>;
-    IteratorType it(outputImage, function, m_Seeds);
-    it.GoToBegin();
-
-    while (!it.IsAtEnd())
+    if (region.IsInside(seed) && function->EvaluateAtIndex(seed))
     {
-      it.Set(m_ReplaceValue);
-      ++it;
-      progress.CompletedPixel(); // potential exception thrown here
+      seeds.push_back(seed);
     }
   }
-  else if (this->m_Connectivity == ConnectivityEnum::FullConnectivity)
-  {
-    // Use the fully connected iterator here. The fully connected iterator
-    // below is a superset of the above. However, it is reported to be 20%
-    // slower. Hence we use this "if" block to use the old iterator when
-    // we don't need full connectivity.
 
-    using IteratorType = ShapedFloodFilledImageFunctionConditionalIterator<OutputImageType, FunctionType>;
-    IteratorType it(outputImage, function, m_Seeds);
-    it.FullyConnectedOn();
-    it.GoToBegin();
+  // Fill the pixels connected to the seeds within the thresholds with
+  // several threads, and write the runs of pixels filled to the output
+  ParallelFloodFill<OutputImageDimension> floodFill(region);
+  floodFill.SetFullyConnected(this->m_Connectivity == ConnectivityEnum::FullConnectivity);
 
-    while (!it.IsAtEnd())
-    {
-      it.Set(m_ReplaceValue);
-      ++it;
-      progress.CompletedPixel(); // potential exception thrown here
-    }
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  floodFill.Fill(
+    seeds,
+    [&function](const IndexType & index) { return function->EvaluateAtIndex(index); },
+    this->GetMultiThreader(),
+    this);
+
+  OutputImagePixelType * buffer = outputImage->GetBufferPointer();
+  for (const auto & run : floodFill.GetRuns())
+  {
+    std::fill_n(buffer + outputImage->ComputeOffset(run.m_Index), run.m_Length, m_ReplaceValue);
   }
 }
 
@@ -43,7 +43,12 @@ namespace itk
  * the two sets of seeds are not connected. The algorithm uses a
  * binary search to adjust the upper threshold, starting at Upper. The
  * reverse is true for finding the threshold to separate two bright
- * regions.  Lower defaults to the smallest possible value for the
+ * regions. The image is not flood filled for each threshold of the
+ * search: a single priority flood from Seeds1 first finds the smallest
+ * upper threshold (or largest lower threshold) which connects them to
+ * Seeds2, the binary search is done against this value, and the
+ * segmentation is flood filled once with the isolating threshold.
+ * Lower defaults to the smallest possible value for the
  * InputImagePixelType, and Upper defaults to the largest possible
  * value for the InputImagePixelType.
  *
@@ -228,6 +233,14 @@ protected:
 
   void
   GenerateData() override;
+
+private:
+  /** Flood the image from Seeds1, visiting first the pixels reached by the
+   * paths with the smallest maximum (or largest minimum) intensity, until
+   * Seeds2 is reached. Return false if Seeds2 cannot be reached, or store in
+   * connectionValue the threshold from which the seeds are connected. */
+  bool
+  FindConnectionValue(InputImagePixelType & connectionValue, float progressWeight);
 };
 } // end namespace itk
 
@@ -19,12 +19,15 @@
 #define itkIsolatedConnectedImageFilter_hxx
 
 #include "itkBinaryThresholdImageFunction.h"
-#include "itkFloodFilledImageFunctionConditionalIterator.h"
+#include "itkParallelFloodFill.h"
 #include "itkProgressReporter.h"
 #include "itkIterationReporter.h"
 #include "itkMath.h"
 #include "itkNumericTraits.h"
-#include "itkMath.h"
+#include <algorithm>
+#include <queue>
+#include <utility>
+#include <vector>
 
 namespace itk
 {
@@ -196,16 +199,13 @@ IsolatedConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
   outputImage->Allocate();
   outputImage->FillBuffer(NumericTraits<OutputImagePixelType>::ZeroValue());
 
-  using FunctionType = BinaryThresholdImageFunction<InputImageType>;
-  using IteratorType = FloodFilledImageFunctionConditionalIterator<OutputImageType, FunctionType>;
-
-  auto function = FunctionType::New();
-  function->SetInputImage(inputImage);
-
-  float             progressWeight = 0.0f;
-  float             cumulatedProgress = 0.0f;
-  IteratorType      it = IteratorType(outputImage, function, m_Seeds1);
-  IterationReporter iterate(this, 0, 1);
+  // Find the threshold from which the seeds are connected, with a single
+  // flood of the image. The flood fill with a threshold guess reaches
+  // Seeds2 when it is beyond this threshold.
+  constexpr float     progressWeight = 0.5f;
+  InputImagePixelType connectionValue{};
+  const bool          canConnect = this->FindConnectionValue(connectionValue, progressWeight);
+  IterationReporter   iterate(this, 0, 1);
 
   // If the upper threshold has not been set, find it.
   if (m_FindUpperThreshold)
@@ -216,45 +216,10 @@ IsolatedConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
 
     // do a binary search to find an upper threshold that separates the
     // two sets of seeds.
-    const auto maximumIterationsInBinarySearch = static_cast<unsigned int>(
-      std::log((static_cast<float>(upper) - static_cast<float>(lower)) / static_cast<float>(m_IsolatedValueTolerance)) /
-      std::log(2.0));
-
-    progressWeight = 1.0f / static_cast<float>(maximumIterationsInBinarySearch + 2);
-    cumulatedProgress = 0.0f;
-
     while (lower + m_IsolatedValueTolerance < guess)
     {
-      ProgressReporter progress(this, 0, region.GetNumberOfPixels(), 100, cumulatedProgress, progressWeight);
-      cumulatedProgress += progressWeight;
-      outputImage->FillBuffer(NumericTraits<OutputImagePixelType>::ZeroValue());
-      function->ThresholdBetween(m_Lower, static_cast<InputImagePixelType>(guess));
-      it.GoToBegin();
-      while (!it.IsAtEnd())
-      {
-        it.Set(m_ReplaceValue);
-        if (it.GetIndex() == m_Seeds2.front())
-        {
-          break;
-        }
-        ++it;
-        progress.CompletedPixel(); // potential exception thrown here
-      }
       // If any of second seeds are included, decrease the upper bound.
-      // Find the sum of the intensities in m_Seeds2.  If the second
-      // seeds are not included, the sum should be zero.  Otherwise,
-      // it will be other than zero.
-      InputRealType                               seedIntensitySum = NumericTraits<InputRealType>::ZeroValue();
-      typename SeedsContainerType::const_iterator si = m_Seeds2.begin();
-      typename SeedsContainerType::const_iterator li = m_Seeds2.end();
-      while (si != li)
-      {
-        const auto value = static_cast<InputRealType>(outputImage->GetPixel(*si));
-        seedIntensitySum += value;
-        ++si;
-      }
-
-      if (Math::NotExactlyEquals(seedIntensitySum, NumericTraits<InputRealType>::ZeroValue()))
+      if (canConnect && !(static_cast<InputImagePixelType>(guess) < connectionValue))
       {
         upper = guess;
       }
@@ -281,45 +246,10 @@ IsolatedConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
 
     // do a binary search to find a lower threshold that separates the
     // two sets of seeds.
-    const auto maximumIterationsInBinarySearch = static_cast<unsigned int>(
-      std::log((static_cast<float>(upper) - static_cast<float>(lower)) / static_cast<float>(m_IsolatedValueTolerance)) /
-      std::log(2.0));
-
-    progressWeight = 1.0f / static_cast<float>(maximumIterationsInBinarySearch + 2);
-    cumulatedProgress = 0.0f;
-
     while (guess < upper - m_IsolatedValueTolerance)
     {
-      ProgressReporter progress(this, 0, region.GetNumberOfPixels(), 100, cumulatedProgress, progressWeight);
-      cumulatedProgress += progressWeight;
-      outputImage->FillBuffer(NumericTraits<OutputImagePixelType>::ZeroValue());
-      function->ThresholdBetween(static_cast<InputImagePixelType>(guess), m_Upper);
-      it.GoToBegin();
-      while (!it.IsAtEnd())
-      {
-        it.Set(m_ReplaceValue);
-        if (it.GetIndex() == m_Seeds2.front())
-        {
-          break;
-        }
-        ++it;
-        progress.CompletedPixel(); // potential exception thrown here
-      }
       // If any of second seeds are included, increase the lower bound.
-      // Find the sum of the intensities in m_Seeds2.  If the second
-      // seeds are not included, the sum should be zero.  Otherwise,
-      // it will be other than zero.
-      InputRealType                               seedIntensitySum = NumericTraits<InputRealType>::ZeroValue();
-      typename SeedsContainerType::const_iterator si = m_Seeds2.begin();
-      typename SeedsContainerType::const_iterator li = m_Seeds2.end();
-      while (si != li)
-      {
-        const auto value = static_cast<InputRealType>(outputImage->GetPixel(*si));
-        seedIntensitySum += value;
-        ++si;
-      }
-
-      if (Math::NotExactlyEquals(seedIntensitySum, NumericTraits<InputRealType>::ZeroValue()))
+      if (canConnect && !(connectionValue < static_cast<InputImagePixelType>(guess)))
       {
         lower = guess;
       }
@@ -339,10 +269,12 @@ IsolatedConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
                                                                // guess
   }
 
-  // now rerun the algorithm with the thresholds that separate the seeds.
-  ProgressReporter progress(this, 0, region.GetNumberOfPixels(), 100, cumulatedProgress, progressWeight);
+  using FunctionType = BinaryThresholdImageFunction<InputImageType>;
 
-  outputImage->FillBuffer(NumericTraits<OutputImagePixelType>::ZeroValue());
+  auto function = FunctionType::New();
+  function->SetInputImage(inputImage);
+
+  // now run the algorithm with the thresholds that separate the seeds.
   if (m_FindUpperThreshold)
   {
     function->ThresholdBetween(m_Lower, m_IsolatedValue);
@@ -351,12 +283,30 @@ IsolatedConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
   {
     function->ThresholdBetween(m_IsolatedValue, m_Upper);
   }
-  it.GoToBegin();
-  while (!it.IsAtEnd())
+
+  SeedsContainerType seeds;
+  for (const IndexType & seed : m_Seeds1)
   {
-    it.Set(m_ReplaceValue);
-    ++it;
-    progress.CompletedPixel(); // potential exception thrown here
+    if (region.IsInside(seed) && function->EvaluateAtIndex(seed))
+    {
+      seeds.push_back(seed);
+    }
+  }
+
+  ParallelFloodFill<OutputImageType::ImageDimension> floodFill(region);
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  floodFill.Fill(
+    seeds,
+    [&function](const IndexType & index) { return function->EvaluateAtIndex(index); },
+    this->GetMultiThreader(),
+    this,
+    progressWeight);
+
+  OutputImagePixelType * buffer = outputImage->GetBufferPointer();
+  for (const auto & run : floodFill.GetRuns())
+  {
+    std::fill_n(buffer + outputImage->ComputeOffset(run.m_Index), run.m_Length, m_ReplaceValue);
   }
 
   // If any of the second seeds are included or some of the first
@@ -392,6 +342,99 @@ IsolatedConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
   }
   iterate.CompletedStep();
 }
+
+template <typename TInputImage, typename TOutputImage>
+bool
+IsolatedConnectedImageFilter<TInputImage, TOutputImage>::FindConnectionValue(InputImagePixelType & connectionValue,
+                                                                             float                 progressWeight)
+{
+  const InputImageType *      inputImage = this->GetInput();
+  const OutputImageType *     outputImage = this->GetOutput();
+  const OutputImageRegionType region = outputImage->GetBufferedRegion();
+  const IndexType             regionIndex = region.GetIndex();
+  const IndexType             regionUpperIndex = region.GetUpperIndex();
+  const OffsetValueType *     offsetTable = outputImage->GetOffsetTable();
+
+  // The pixels are identified by their offset in the output image, and the
+  // seeds are only compared to the bound which is not searched.
+  const bool                findUpperThreshold = m_FindUpperThreshold;
+  const InputImagePixelType lowerBound = m_Lower;
+  const InputImagePixelType upperBound = m_Upper;
+  const auto                isInBound = [=](const InputImagePixelType & value) {
+    return findUpperThreshold ? !(value < lowerBound) : !(upperBound < value);
+  };
+
+  // The value of a path is its largest intensity when searching the upper
+  // threshold, its smallest one otherwise, and the best path is followed first.
+  const auto isBetter = [findUpperThreshold](const InputImagePixelType & a, const InputImagePixelType & b) {
+    return findUpperThreshold ? a < b : b < a;
+  };
+  using NodeType = std::pair<InputImagePixelType, OffsetValueType>;
+  const auto isWorse = [&isBetter](const NodeType & a, const NodeType & b) { return isBetter(b.first, a.first); };
+  std::priority_queue<NodeType, std::vector<NodeType>, decltype(isWorse)> front(isWorse);
+
+  constexpr unsigned char    Reached = 1;
+  constexpr unsigned char    InSeeds2 = 2;
+  std::vector<unsigned char> states(region.GetNumberOfPixels(), 0);
+  for (const IndexType & seed : m_Seeds2)
+  {
+    if (region.IsInside(seed))
+    {
+      states[outputImage->ComputeOffset(seed)] |= InSeeds2;
+    }
+  }
+  for (const IndexType & seed : m_Seeds1)
+  {
+    if (region.IsInside(seed))
+    {
+      const OffsetValueType     offset = outputImage->ComputeOffset(seed);
+      const InputImagePixelType value = inputImage->GetPixel(seed);
+      if (!(states[offset] & Reached) && isInBound(value))
+      {
+        states[offset] |= Reached;
+        front.emplace(value, offset);
+      }
+    }
+  }
+
+  ProgressReporter progress(this, 0, region.GetNumberOfPixels(), 100, 0.0f, progressWeight);
+  while (!front.empty())
+  {
+    const NodeType node = front.top();
+    front.pop();
+    if (states[node.second] & InSeeds2)
+    {
+      connectionValue = node.first;
+      return true;
+    }
+
+    const IndexType index = outputImage->ComputeIndex(node.second);
+    for (unsigned int i = 0; i < InputImageType::ImageDimension; ++i)
+    {
+      for (const OffsetValueType step : { -1, 1 })
+      {
+        IndexType neighborIndex = index;
+        neighborIndex[i] += step;
+        if (neighborIndex[i] < regionIndex[i] || neighborIndex[i] > regionUpperIndex[i])
+        {
+          continue;
+        }
+        const OffsetValueType neighborOffset = node.second + step * offsetTable[i];
+        if (!(states[neighborOffset] & Reached))
+        {
+          states[neighborOffset] |= Reached;
+          const InputImagePixelType value = inputImage->GetPixel(neighborIndex);
+          if (isInBound(value))
+          {
+            front.emplace(isBetter(node.first, value) ? value : node.first, neighborOffset);
+          }
+        }
+      }
+    }
+    progress.CompletedPixel(); // potential exception thrown here
+  }
+  return false;
+}
 } // end namespace itk
 
 #endif
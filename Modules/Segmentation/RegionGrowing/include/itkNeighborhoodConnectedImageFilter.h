@@ -30,6 +30,9 @@ namespace itk
  * are connected to an initial Seed AND whose neighbors all lie within a
  * Lower and Upper threshold range.
  *
+ * The neighborhoods of the pixels reached from the seeds are evaluated
+ * with the work units of the filter, see ParallelFloodFill.
+ *
  * \ingroup RegionGrowingSegmentation
  * \ingroup ITKRegionGrowing
  */
@@ -19,8 +19,8 @@
 #define itkNeighborhoodConnectedImageFilter_hxx
 
 #include "itkNeighborhoodBinaryThresholdImageFunction.h"
-#include "itkFloodFilledImageFunctionConditionalIterator.h"
-#include "itkProgressReporter.h"
+#include "itkParallelFloodFill.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -109,25 +109,34 @@ NeighborhoodConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
   typename Superclass::OutputImagePointer     outputImage = this->GetOutput();
 
   // Zero the output
-  outputImage->SetBufferedRegion(outputImage->GetRequestedRegion());
+  const OutputImageRegionType region = outputImage->GetRequestedRegion();
+  outputImage->SetBufferedRegion(region);
   outputImage->Allocate();
   outputImage->FillBuffer(NumericTraits<OutputImagePixelType>::ZeroValue());
 
   using FunctionType = NeighborhoodBinaryThresholdImageFunction<InputImageType>;
-  using IteratorType = FloodFilledImageFunctionConditionalIterator<OutputImageType, FunctionType>;
 
   auto function = FunctionType::New();
   function->SetInputImage(inputImage);
   function->ThresholdBetween(m_Lower, m_Upper);
   function->SetRadius(m_Radius);
-  IteratorType it = IteratorType(outputImage, function, m_Seeds);
 
-  ProgressReporter progress(this, 0, outputImage->GetRequestedRegion().GetNumberOfPixels());
-  while (!it.IsAtEnd())
+  // Fill the pixels connected to the seeds whose neighborhood is within the
+  // thresholds with several threads. The seeds are filled even when their
+  // neighborhood is not within the thresholds.
+  ParallelFloodFill<OutputImageDimension> floodFill(region);
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  floodFill.Fill(
+    m_Seeds,
+    [&function](const IndexType & index) { return function->EvaluateAtIndex(index); },
+    this->GetMultiThreader(),
+    this);
+
+  OutputImagePixelType * buffer = outputImage->GetBufferPointer();
+  for (const auto & run : floodFill.GetRuns())
   {
-    it.Set(m_ReplaceValue);
-    ++it;
-    progress.CompletedPixel();
+    std::fill_n(buffer + outputImage->ComputeOffset(run.m_Index), run.m_Length, m_ReplaceValue);
   }
 }
 } // end namespace itk
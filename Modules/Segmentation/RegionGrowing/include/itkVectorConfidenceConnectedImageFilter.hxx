@@ -23,9 +23,9 @@
 #include "itkVectorMeanImageFunction.h"
 #include "itkCovarianceImageFunction.h"
 #include "itkBinaryThresholdImageFunction.h"
-#include "itkFloodFilledImageFunctionConditionalIterator.h"
 #include "itkNumericTraitsRGBPixel.h"
-#include "itkProgressReporter.h"
+#include "itkParallelFloodFill.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -113,10 +113,6 @@ VectorConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
 {
   using InputPixelType = typename InputImageType::PixelType;
 
-  using SecondFunctionType = BinaryThresholdImageFunction<OutputImageType>;
-  using IteratorType = FloodFilledImageFunctionConditionalIterator<OutputImageType, DistanceThresholdFunctionType>;
-  using SecondIteratorType = FloodFilledImageFunctionConditionalConstIterator<InputImageType, SecondFunctionType>;
-
   unsigned int loop;
 
   typename Superclass::InputImageConstPointer inputImage = this->GetInput();
@@ -232,35 +228,38 @@ VectorConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   itkDebugMacro(<< "\nMultiplier after verifying seeds inclusion = " << m_Multiplier);
 
-  // Segment the image, the iterator walks the output image (so Set()
-  // writes into the output image), starting at the seed point.  As
-  // the iterator walks, if the corresponding pixel in the input image
-  // (accessed via the "m_ThresholdFunction" assigned to the iterator) is within
-  // the [lower, upper] bounds prescribed, the pixel is added to the
-  // output segmentation and its neighbors become candidates for the
-  // iterator to walk.
-  IteratorType it = IteratorType(outputImage, m_ThresholdFunction, m_Seeds);
-  it.GoToBegin();
-  while (!it.IsAtEnd())
-  {
-    it.Set(m_ReplaceValue);
-    ++it;
-  }
+  // Segment the image: the pixels connected to the seeds whose value in the
+  // input image (accessed via the "m_ThresholdFunction") is within the
+  // distance prescribed are filled with several threads.
+  ParallelFloodFill<OutputImageType::ImageDimension> floodFill(region);
+
+  const float progressWeight = 1.0f / static_cast<float>(m_NumberOfIterations + 1);
 
-  ProgressReporter progress(this, 0, region.GetNumberOfPixels() * m_NumberOfIterations);
+  const auto segment = [&]() {
+    SeedsContainerType seeds;
+    for (const IndexType & seed : m_Seeds)
+    {
+      if (region.IsInside(seed) && m_ThresholdFunction->EvaluateAtIndex(seed))
+      {
+        seeds.push_back(seed);
+      }
+    }
+    floodFill.Fill(
+      seeds,
+      [this](const IndexType & index) { return m_ThresholdFunction->EvaluateAtIndex(index); },
+      this->GetMultiThreader(),
+      this,
+      progressWeight);
+  };
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  segment();
 
   for (loop = 0; loop < m_NumberOfIterations; ++loop)
   {
     // Now that we have an initial segmentation, let's recalculate the
-    // statistics.  Since we have already labelled the output, we visit
-    // pixels in the input image that have been set in the output image.
-    // Essentially, we flip the iterator around, so we walk the input
-    // image (so Get() will get pixel values from the input) and constrain
-    // iterator such it only visits pixels that were set in the output.
-    auto secondFunction = SecondFunctionType::New();
-    secondFunction->SetInputImage(outputImage);
-    secondFunction->ThresholdBetween(m_ReplaceValue, m_ReplaceValue);
-
+    // statistics over the pixels of the input image which have been filled,
+    // in the order of the image buffer.
     covariance = CovarianceMatrixType(dimension, dimension);
     mean = MeanVectorType(dimension);
 
@@ -269,26 +268,27 @@ VectorConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
 
     SizeValueType num = NumericTraits<SizeValueType>::ZeroValue();
 
-    SecondIteratorType sit = SecondIteratorType(inputImage, secondFunction, m_Seeds);
-    sit.GoToBegin();
-    while (!sit.IsAtEnd())
+    for (const auto & run : floodFill.GetRuns())
     {
-      const InputPixelType pixelValue = sit.Get();
-      for (unsigned int i = 0; i < dimension; ++i)
+      IndexType index = run.m_Index;
+      for (SizeValueType k = 0; k < run.m_Length; ++k, ++index[0])
       {
-        const auto pixelValueI = static_cast<ComponentRealType>(pixelValue[i]);
-        covariance[i][i] += pixelValueI * pixelValueI;
-        mean[i] += pixelValueI;
-        for (unsigned int j = i + 1; j < dimension; ++j)
+        const InputPixelType pixelValue = inputImage->GetPixel(index);
+        for (unsigned int i = 0; i < dimension; ++i)
         {
-          const auto              pixelValueJ = static_cast<ComponentRealType>(pixelValue[j]);
-          const ComponentRealType product = pixelValueI * pixelValueJ;
-          covariance[i][j] += product;
-          covariance[j][i] += product;
+          const auto pixelValueI = static_cast<ComponentRealType>(pixelValue[i]);
+          covariance[i][i] += pixelValueI * pixelValueI;
+          mean[i] += pixelValueI;
+          for (unsigned int j = i + 1; j < dimension; ++j)
+          {
+            const auto              pixelValueJ = static_cast<ComponentRealType>(pixelValue[j]);
+            const ComponentRealType product = pixelValueI * pixelValueJ;
+            covariance[i][j] += product;
+            covariance[j][i] += product;
+          }
         }
       }
-      ++num;
-      ++sit;
+      num += run.m_Length;
     }
     for (unsigned int ii = 0; ii < dimension; ++ii)
     {
@@ -310,24 +310,10 @@ VectorConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
     m_ThresholdFunction->SetMean(mean);
     m_ThresholdFunction->SetCovariance(covariance);
 
-    // Rerun the segmentation, the iterator walks the output image,
-    // starting at the seed point.  As the iterator walks, if the
-    // corresponding pixel in the input image (accessed via the
-    // "m_ThresholdFunction" assigned to the iterator) is within the [lower,
-    // upper] bounds prescribed, the pixel is added to the output
-    // segmentation and its neighbors become candidates for the
-    // iterator to walk.
-    outputImage->FillBuffer(NumericTraits<OutputImagePixelType>::ZeroValue());
-    IteratorType thirdIt = IteratorType(outputImage, m_ThresholdFunction, m_Seeds);
-    thirdIt.GoToBegin();
+    // Rerun the segmentation with the new statistics
     try
     {
-      while (!thirdIt.IsAtEnd())
-      {
-        thirdIt.Set(m_ReplaceValue);
-        ++thirdIt;
-        progress.CompletedPixel(); // potential exception thrown here
-      }
+      segment(); // potential exception thrown here
     }
     catch (const ProcessAborted &)
     {
@@ -342,6 +328,12 @@ VectorConfidenceConnectedImageFilter<TInputImage, TOutputImage>::GenerateData()
     e.SetLocation(ITK_LOCATION);
     throw e;
   }
+
+  OutputImagePixelType * buffer = outputImage->GetBufferPointer();
+  for (const auto & run : floodFill.GetRuns())
+  {
+    std::fill_n(buffer + outputImage->ComputeOffset(run.m_Index), run.m_Length, m_ReplaceValue);
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
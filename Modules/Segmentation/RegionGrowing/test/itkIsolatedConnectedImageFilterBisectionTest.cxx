@@ -0,0 +1,232 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkIsolatedConnectedImageFilter.h"
+#include "itkConnectedThresholdImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+/*
+ * IsolatedConnectedImageFilter finds the threshold from which the two sets
+ * of seeds are connected with a single flood of the image. Compare the
+ * isolated value and the failure flag with those of a binary search which
+ * flood fills the image for each guess, on images where walls of several
+ * heights separate the seeds.
+ */
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+itkIsolatedConnectedImageFilterBisectionTestFlood(const TImage *                                  image,
+                                                  const std::vector<typename TImage::IndexType> & seeds,
+                                                  typename TImage::PixelType                      lower,
+                                                  typename TImage::PixelType                      upper)
+{
+  using ConnectedFilterType = itk::ConnectedThresholdImageFilter<TImage, TImage>;
+
+  auto connected = ConnectedFilterType::New();
+  connected->SetInput(image);
+  connected->SetLower(lower);
+  connected->SetUpper(upper);
+  connected->SetReplaceValue(1);
+  for (const auto & seed : seeds)
+  {
+    connected->AddSeed(seed);
+  }
+  connected->Update();
+  return connected->GetOutput();
+}
+
+// Whether all the seeds are flooded, or any of them when all is false
+template <typename TImage>
+bool
+itkIsolatedConnectedImageFilterBisectionTestIsFlooded(const TImage *                                  flood,
+                                                      const std::vector<typename TImage::IndexType> & seeds,
+                                                      bool                                            all)
+{
+  for (const auto & seed : seeds)
+  {
+    if ((flood->GetPixel(seed) != 0) != all)
+    {
+      return !all;
+    }
+  }
+  return all;
+}
+
+template <typename TPixel>
+int
+itkIsolatedConnectedImageFilterBisectionTestRun(TPixel lowerBound, TPixel upperBound, TPixel tolerance)
+{
+  constexpr unsigned int Dimension = 2;
+  using ImageType = itk::Image<TPixel, Dimension>;
+  using IndexType = typename ImageType::IndexType;
+  using FilterType = itk::IsolatedConnectedImageFilter<ImageType, ImageType>;
+  using AccumulateType = typename itk::NumericTraits<TPixel>::AccumulateType;
+
+  // Noisy background, crossed by walls of several heights between the two
+  // sets of seeds. Each wall has a gap lower than the wall itself.
+  const typename ImageType::SizeType size = { { 64, 40 } };
+  auto                               image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  auto generator = GeneratorType::New();
+  generator->Initialize(1961);
+
+  const double range = static_cast<double>(upperBound) - static_cast<double>(lowerBound);
+  const double wallHeights[3] = { 0.55, 0.85, 0.7 };
+  const double gapHeights[3] = { 0.5, 0.65, 0.6 };
+  const int    gapRows[3] = { 5, 30, 18 };
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const IndexType index = it.GetIndex();
+    double          level = generator->GetUniformVariate(0.0, 0.45);
+    for (unsigned int wall = 0; wall < 3; ++wall)
+    {
+      if (index[0] == static_cast<itk::IndexValueType>(16 * (wall + 1)))
+      {
+        level = index[1] == gapRows[wall] ? gapHeights[wall] : wallHeights[wall];
+        level += generator->GetUniformVariate(0.0, 0.02);
+      }
+    }
+    it.Set(static_cast<TPixel>(static_cast<double>(lowerBound) + level * range));
+  }
+
+  const std::vector<IndexType> seeds1{ { { 3, 4 } }, { { 5, 35 } } };
+  const std::vector<IndexType> seeds2{ { { 60, 20 } }, { { 58, 2 } } };
+
+  for (bool findUpperThreshold : { true, false })
+  {
+    for (bool inverted : { false, true })
+    {
+      // Search the threshold in the image and in its inverse, where the walls
+      // are lower than the background.
+      auto input = ImageType::New();
+      input->SetRegions(size);
+      input->Allocate();
+      itk::ImageRegionIterator<ImageType> inputIt(input, input->GetLargestPossibleRegion());
+      for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++inputIt)
+      {
+        inputIt.Set(inverted ? static_cast<TPixel>(upperBound - (it.Get() - lowerBound)) : it.Get());
+      }
+
+      auto filter = FilterType::New();
+      filter->SetInput(input);
+      for (unsigned int i = 0; i < seeds1.size(); ++i)
+      {
+        filter->AddSeed1(seeds1[i]);
+        filter->AddSeed2(seeds2[i]);
+      }
+      filter->SetLower(lowerBound);
+      filter->SetUpper(upperBound);
+      filter->SetReplaceValue(1);
+      filter->SetIsolatedValueTolerance(tolerance);
+      filter->SetFindUpperThreshold(findUpperThreshold);
+      ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+      // Binary search of the isolating threshold, flooding the image for each
+      // guess, as the filter used to do
+      auto           lower = static_cast<AccumulateType>(lowerBound);
+      auto           upper = static_cast<AccumulateType>(upperBound);
+      AccumulateType guess = findUpperThreshold ? upper : lower;
+      TPixel         isolatedValue;
+      if (findUpperThreshold)
+      {
+        while (lower + tolerance < guess)
+        {
+          const auto flood = itkIsolatedConnectedImageFilterBisectionTestFlood(
+            input.GetPointer(), seeds1, lowerBound, static_cast<TPixel>(guess));
+          if (itkIsolatedConnectedImageFilterBisectionTestIsFlooded(flood.GetPointer(), seeds2, false))
+          {
+            upper = guess;
+          }
+          else
+          {
+            lower = guess;
+          }
+          guess = (upper + lower) / 2;
+        }
+        isolatedValue = static_cast<TPixel>(lower);
+      }
+      else
+      {
+        while (guess < upper - tolerance)
+        {
+          const auto flood = itkIsolatedConnectedImageFilterBisectionTestFlood(
+            input.GetPointer(), seeds1, static_cast<TPixel>(guess), upperBound);
+          if (itkIsolatedConnectedImageFilterBisectionTestIsFlooded(flood.GetPointer(), seeds2, false))
+          {
+            lower = guess;
+          }
+          else
+          {
+            upper = guess;
+          }
+          guess = (upper + lower) / 2;
+        }
+        isolatedValue = static_cast<TPixel>(upper);
+      }
+      const TPixel isolatedLower = findUpperThreshold ? lowerBound : isolatedValue;
+      const TPixel isolatedUpper = findUpperThreshold ? isolatedValue : upperBound;
+      const auto   flood =
+        itkIsolatedConnectedImageFilterBisectionTestFlood(input.GetPointer(), seeds1, isolatedLower, isolatedUpper);
+      const bool   thresholdingFailed =
+        !itkIsolatedConnectedImageFilterBisectionTestIsFlooded(flood.GetPointer(), seeds1, true) ||
+        itkIsolatedConnectedImageFilterBisectionTestIsFlooded(flood.GetPointer(), seeds2, false);
+
+      std::cout << "FindUpperThreshold: " << findUpperThreshold << ", inverted: " << inverted
+                << ", isolated value: " << static_cast<typename itk::NumericTraits<TPixel>::PrintType>(
+                                             filter->GetIsolatedValue())
+                << std::endl;
+      ITK_TEST_EXPECT_EQUAL(static_cast<double>(filter->GetIsolatedValue()), static_cast<double>(isolatedValue));
+      ITK_TEST_EXPECT_EQUAL(filter->GetThresholdingFailed(), thresholdingFailed);
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkIsolatedConnectedImageFilterBisectionTest(int, char *[])
+{
+  std::cout << "unsigned char" << std::endl;
+  if (itkIsolatedConnectedImageFilterBisectionTestRun<unsigned char>(0, 255, 1) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  std::cout << "short" << std::endl;
+  if (itkIsolatedConnectedImageFilterBisectionTestRun<short>(-2000, 3000, 1) != EXIT_SUCCESS ||
+      itkIsolatedConnectedImageFilterBisectionTestRun<short>(-2000, 3000, 50) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  std::cout << "float" << std::endl;
+  if (itkIsolatedConnectedImageFilterBisectionTestRun<float>(0.0f, 1.0f, 0.001f) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -45,6 +45,12 @@ namespace itk
  * value ). The computation is done in index space with scales
  * provided by the SpatialProximityWeight parameters.
  *
+ * The pixels are assigned to the clusters one line of the search window
+ * at a time, with the spatial distances along the other dimensions
+ * computed once per line. The distances are computed with the
+ * DistanceType, the TDistancePixel template parameter, which is float by
+ * default.
+ *
  * The output is a label image with each label representing a
  * superpixel cluster. Every pixel in the output is labeled, and the
  * starting label id is zero.
@@ -114,6 +120,16 @@ public:
   itkSetMacro(MaximumNumberOfIterations, unsigned int);
   itkGetConstMacro(MaximumNumberOfIterations, unsigned int);
 
+  /** \brief Average residual below which the iterations stop
+   *
+   * The iterations stop before MaximumNumberOfIterations once the
+   * AverageResidual of an iteration is less than this value, or once
+   * the clusters do not change any more. The default, zero, only stops
+   * the iterations when the clusters do not change.
+   */
+  itkSetMacro(ConvergenceThreshold, double);
+  itkGetConstMacro(ConvergenceThreshold, double);
+
   /** \brief The expected superpixel size and shape
    *
    * The requested size of a superpixel used to form a regular grid for
@@ -205,6 +221,7 @@ protected:
 private:
   SuperGridSizeType m_SuperGridSize;
   unsigned int      m_MaximumNumberOfIterations;
+  double            m_ConvergenceThreshold{ 0.0 };
   double            m_SpatialProximityWeight{ 10.0 };
 
   FixedArray<double, ImageDimension> m_DistanceScales;
@@ -91,6 +91,7 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::PrintSelf(std::ostre
   Superclass::PrintSelf(os, indent);
   os << indent << "SuperGridSize: " << m_SuperGridSize << std::endl;
   os << indent << "MaximumNumberOfIterations: " << m_MaximumNumberOfIterations << std::endl;
+  os << indent << "ConvergenceThreshold: " << m_ConvergenceThreshold << std::endl;
   os << indent << "SpatialProximityWeight: " << m_SpatialProximityWeight << std::endl;
   os << indent << "EnforceConnectivity: " << m_EnforceConnectivity << std::endl;
   os << indent << "AverageResidual: " << m_AverageResidual << std::endl;
@@ -198,7 +199,6 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedUpdateDistan
   const OutputImageRegionType & outputRegionForThread)
 {
   using InputConstIteratorType = ImageScanlineConstIterator<InputImageType>;
-  using DistanceIteratorType = ImageScanlineIterator<DistanceImageType>;
 
   const InputImageType * inputImage = this->GetInput();
   OutputImageType *      outputImage = this->GetOutput();
@@ -213,9 +213,8 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedUpdateDistan
 
   for (size_t i = 0; i * numberOfClusterComponents < m_Clusters.size(); ++i)
   {
-    ClusterType                         cluster(numberOfClusterComponents, &m_Clusters[i * numberOfClusterComponents]);
+    const ClusterComponentType *        cluster = &m_Clusters[i * numberOfClusterComponents];
     typename InputImageType::RegionType localRegion;
-    typename InputImageType::PointType  pt;
     IndexType                           idx;
 
     for (unsigned int d = 0; d < ImageDimension; ++d)
@@ -232,34 +231,54 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedUpdateDistan
     }
 
 
-    const size_t ln = localRegion.GetSize(0);
+    const auto ln = static_cast<IndexValueType>(localRegion.GetSize(0));
 
     InputConstIteratorType inputIter(inputImage, localRegion);
-    DistanceIteratorType   distanceIter(m_DistanceImage, localRegion);
-
 
     while (!inputIter.IsAtEnd())
     {
-      for (size_t x = 0; x < ln; ++x)
+      const IndexType lineIdx = inputIter.GetIndex();
+
+      // The spatial distances along the other dimensions are the same for
+      // the whole line, only the first one changes from pixel to pixel.
+      DistanceType lineSquares[ImageDimension];
+      for (unsigned int d = 1; d < ImageDimension; ++d)
+      {
+        const DistanceType dd = (cluster[numberOfComponents + d] - lineIdx[d]) * m_DistanceScales[d];
+        lineSquares[d] = dd * dd;
+      }
+
+      DistanceType *    distances = m_DistanceImage->GetBufferPointer() + m_DistanceImage->ComputeOffset(lineIdx);
+      OutputPixelType * labels = outputImage->GetBufferPointer() + outputImage->ComputeOffset(lineIdx);
+
+      for (IndexValueType x = 0; x < ln; ++x)
       {
-        const IndexType & currentIdx = inputIter.GetIndex();
+        // Same terms, in the same order, as Distance(cluster, pixel, point)
+        const typename NumericTraits<InputPixelType>::MeasurementVectorType & v = inputIter.Get();
+        DistanceType                                                          d1 = 0.0;
+        for (unsigned int c = 0; c < numberOfComponents; ++c)
+        {
+          const DistanceType d = (cluster[c] - v[c]);
+          d1 += d * d;
+        }
 
-        pt = ContinuousIndexType(currentIdx);
-        const double distance = this->Distance(cluster, inputIter.Get(), pt);
-        if (distance < distanceIter.Get())
+        const DistanceType dx = (cluster[numberOfComponents] - (lineIdx[0] + x)) * m_DistanceScales[0];
+        DistanceType       d2 = dx * dx;
+        for (unsigned int d = 1; d < ImageDimension; ++d)
         {
-          distanceIter.Set(distance);
-          outputImage->SetPixel(currentIdx, i);
+          d2 += lineSquares[d];
         }
 
-        ++distanceIter;
+        const DistanceType distance = d1 + d2;
+        if (distance < distances[x])
+        {
+          distances[x] = distance;
+          labels[x] = static_cast<OutputPixelType>(i);
+        }
         ++inputIter;
       }
       inputIter.NextLine();
-      distanceIter.NextLine();
     }
-
-    // for neighborhood iterator size S
   }
 }
 
@@ -280,28 +299,36 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedUpdateCluste
 
   UpdateClusterMap clusterMap;
 
+  // The labels come in runs along the lines, so the entry of the last label
+  // is kept to avoid searching the map for each pixel.
+  auto clusterIter = clusterMap.end();
+
   itkDebugMacro("Estimating Centers");
   // calculate new centers
   OutputIteratorType     itOut = OutputIteratorType(outputImage, updateRegionForThread);
   InputConstIteratorType itIn = InputConstIteratorType(inputImage, updateRegionForThread);
+  const auto             ln = static_cast<IndexValueType>(updateRegionForThread.GetSize(0));
   while (!itOut.IsAtEnd())
   {
-    const size_t ln = updateRegionForThread.GetSize(0);
-    for (unsigned int x = 0; x < ln; ++x)
+    const IndexType lineIdx = itOut.GetIndex();
+    for (IndexValueType x = 0; x < ln; ++x)
     {
-      const IndexType &                         idx = itOut.GetIndex();
       const InputPixelType &                    v = itIn.Get();
       const typename OutputImageType::PixelType l = itOut.Get();
 
-      std::pair<typename UpdateClusterMap::iterator, bool> r = clusterMap.insert(std::make_pair(l, UpdateCluster()));
-      vnl_vector<ClusterComponentType> &                   cluster = r.first->second.cluster;
-      if (r.second)
+      if (clusterIter == clusterMap.end() || clusterIter->first != static_cast<size_t>(l))
       {
-        cluster.set_size(numberOfClusterComponents);
-        cluster.fill(0.0);
-        r.first->second.count = 0;
+        std::pair<typename UpdateClusterMap::iterator, bool> r = clusterMap.insert(std::make_pair(l, UpdateCluster()));
+        if (r.second)
+        {
+          r.first->second.cluster.set_size(numberOfClusterComponents);
+          r.first->second.cluster.fill(0.0);
+          r.first->second.count = 0;
+        }
+        clusterIter = r.first;
       }
-      ++r.first->second.count;
+      vnl_vector<ClusterComponentType> & cluster = clusterIter->second.cluster;
+      ++clusterIter->second.count;
 
       const typename NumericTraits<InputPixelType>::MeasurementVectorType & mv = v;
       for (unsigned int i = 0; i < numberOfComponents; ++i)
@@ -309,9 +336,10 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::ThreadedUpdateCluste
         cluster[i] += mv[i];
       }
 
-      for (unsigned int i = 0; i < ImageDimension; ++i)
+      cluster[numberOfComponents] += lineIdx[0] + x;
+      for (unsigned int i = 1; i < ImageDimension; ++i)
       {
-        cluster[numberOfComponents + i] += idx[i];
+        cluster[numberOfComponents + i] += lineIdx[i];
       }
 
       ++itIn;
@@ -675,7 +703,13 @@ SLICImageFilter<TInputImage, TOutputImage, TDistancePixel>::GenerateData()
     m_AverageResidual = std::sqrt(l1Residual) / m_Clusters.size();
     this->InvokeEvent(IterationEvent());
 
-    // while error <= threshold
+    // Once the clusters stop moving the next iterations would find the same
+    // labels and clusters again.
+    if (m_AverageResidual < m_ConvergenceThreshold || m_Clusters == m_OldClusters)
+    {
+      itkDebugMacro("Converged after " << loopCnt + 1 << " iterations");
+      break;
+    }
   }
 
 
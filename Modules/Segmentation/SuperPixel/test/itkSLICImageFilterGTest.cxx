@@ -109,6 +109,10 @@ TEST_F(SLICFixture, SetGetPrint)
   EXPECT_NO_THROW(filter->SetMaximumNumberOfIterations(6));
   EXPECT_EQ(6, filter->GetMaximumNumberOfIterations());
 
+  EXPECT_EQ(0.0, filter->GetConvergenceThreshold());
+  EXPECT_NO_THROW(filter->SetConvergenceThreshold(0.5));
+  EXPECT_EQ(0.5, filter->GetConvergenceThreshold());
+
   EXPECT_NO_THROW(filter->SetSpatialProximityWeight(9.1));
   EXPECT_EQ(9.1, filter->GetSpatialProximityWeight());
 
@@ -182,3 +186,34 @@ TEST_F(SLICFixture, ClusterInitializationOverflow)
   EXPECT_EQ("be2250b1d36e8a418f6487189db1ea64", MD5Hash(filter->GetOutput()));
   EXPECT_FLOAT_EQ(0.023752308, filter->GetAverageResidual());
 }
+
+
+TEST_F(SLICFixture, ConvergenceThreshold)
+{
+  using namespace itk::GTest::TypedefsAndConstructors::Dimension2;
+  using Utils = FixtureUtilities<2>;
+
+  auto filter = Utils::FilterType::New();
+
+  auto image = Utils::CreateImage(100);
+  filter->SetInput(image);
+  filter->SetSuperGridSize(10);
+  filter->SetMaximumNumberOfIterations(10);
+
+  unsigned int numberOfIterations = 0;
+  filter->AddObserver(itk::IterationEvent(), [&numberOfIterations](const itk::EventObject &) { ++numberOfIterations; });
+
+  // The clusters of a blank image stop moving after a few iterations
+  filter->Update();
+  EXPECT_LT(numberOfIterations, 10u);
+  EXPECT_EQ(0.0, filter->GetAverageResidual());
+  EXPECT_EQ("68707adc3df2f7d210b1db96847fc3c5", MD5Hash(filter->GetOutput()));
+
+  // A threshold larger than the residual stops the iterations after the first one
+  image->SetPixel(itk::MakeIndex(23, 27), 100);
+  image->Modified();
+  numberOfIterations = 0;
+  filter->SetConvergenceThreshold(itk::NumericTraits<double>::max());
+  filter->Update();
+  EXPECT_EQ(1u, numberOfIterations);
+}
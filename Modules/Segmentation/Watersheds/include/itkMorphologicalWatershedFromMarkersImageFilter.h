@@ -65,6 +65,10 @@ namespace itk
  * Chapter 9.2 of Pierre Soille's book "Morphological Image Analysis:
  * Principles and Applications", Second Edition, Springer, 2003.
  *
+ * The pixels are flooded with a hierarchical queue storing their offsets in
+ * the image buffers. The queue is an array of levels for the 8 and 16 bit
+ * integer images, and a map of levels for the other pixel types.
+ *
  * This code was contributed in the Insight Journal paper:
  * "The watershed transform in ITK - discussion and new developments"
  * by Beare R., Lehmann G.
@@ -18,16 +18,9 @@
 #ifndef itkMorphologicalWatershedFromMarkersImageFilter_hxx
 #define itkMorphologicalWatershedFromMarkersImageFilter_hxx
 
-#include <algorithm>
-#include <queue>
-#include <list>
+#include <vector>
 #include "itkProgressReporter.h"
-#include "itkImageRegionIterator.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
-#include "itkConstShapedNeighborhoodIterator.h"
-#include "itkConstantBoundaryCondition.h"
-#include "itkSize.h"
-#include "itkConnectedComponentAlgorithm.h"
+#include "itkMorphologicalWatershedHierarchicalQueue.h"
 
 namespace itk
 {
@@ -112,37 +105,69 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
     itkExceptionMacro(<< "Marker and input must have the same size.");
   }
 
-  // FAH (in french: File d'Attente Hierarchique)
-  using QueueType = std::queue<IndexType>;
-  using MapType = std::map<InputImagePixelType, QueueType>;
-  MapType fah;
-
-  // the radius which will be used for all the shaped iterators
-  Size<ImageDimension> radius;
-  radius.Fill(1);
-
-  // iterator for the marker image
-  using MarkerIteratorType = ConstShapedNeighborhoodIterator<LabelImageType>;
-  typename MarkerIteratorType::ConstIterator nmIt;
-  MarkerIteratorType                         markerIt(radius, markerImage, markerImage->GetRequestedRegion());
-  // add a boundary constant to avoid adding pixels on the border in the fah
-  ConstantBoundaryCondition<LabelImageType> lcbc;
-  lcbc.SetConstant(NumericTraits<LabelImagePixelType>::max());
-  markerIt.OverrideBoundaryCondition(&lcbc);
-  setConnectivity(&markerIt, m_FullyConnected);
-
-  // iterator for the input image
-  using InputIteratorType = ConstShapedNeighborhoodIterator<InputImageType>;
-  InputIteratorType                         inputIt(radius, inputImage, inputImage->GetRequestedRegion());
-  typename InputIteratorType::ConstIterator niIt;
-  setConnectivity(&inputIt, m_FullyConnected);
-
-  // iterator for the output image
-  using OutputIteratorType = ShapedNeighborhoodIterator<LabelImageType>;
-  using OffsetType = typename OutputIteratorType::OffsetType;
-  typename OutputIteratorType::Iterator noIt;
-  OutputIteratorType                    outputIt(radius, outputImage, outputImage->GetRequestedRegion());
-  setConnectivity(&outputIt, m_FullyConnected);
+  // the marker, input and output buffers have the same size, so a pixel and
+  // its neighbors are at the same offsets in the three buffers
+  const LabelImagePixelType * markerBuffer = markerImage->GetBufferPointer();
+  const InputImagePixelType * inputBuffer = inputImage->GetBufferPointer();
+  LabelImagePixelType *       outputBuffer = outputImage->GetBufferPointer();
+  const LabelImageRegionType  region = outputImage->GetBufferedRegion();
+  const auto                  numberOfPixels = static_cast<OffsetValueType>(region.GetNumberOfPixels());
+
+  // the offsets of the neighbors, in the order of the neighborhood iterators:
+  // all the pixels of the 3x3x... neighborhood but the center, or only the
+  // face connected ones
+  using OffsetType = typename LabelImageType::OffsetType;
+  std::vector<OffsetType>      neighborOffsets;
+  std::vector<OffsetValueType> neighborStrides;
+  OffsetValueType              neighborhoodSize = 1;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    neighborhoodSize *= 3;
+  }
+  for (OffsetValueType n = 0; n < neighborhoodSize; ++n)
+  {
+    OffsetType      offset;
+    OffsetValueType position = n;
+    OffsetValueType stride = 0;
+    unsigned int    distance = 0;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      offset[d] = position % 3 - 1;
+      position /= 3;
+      stride += offset[d] * outputImage->GetOffsetTable()[d];
+      distance += (offset[d] != 0);
+    }
+    if (distance == 1 || (distance > 1 && m_FullyConnected))
+    {
+      neighborOffsets.push_back(offset);
+      neighborStrides.push_back(stride);
+    }
+  }
+
+  // call visit() with the offset of each neighbor of a pixel inside the
+  // image. The neighbors outside the image are never processed nor labeled,
+  // as with the boundary conditions of the neighborhood iterators.
+  const IndexType firstIndex = region.GetIndex();
+  const IndexType lastIndex = region.GetUpperIndex();
+  const auto      forEachNeighbor = [&](OffsetValueType offset, const auto & visit) {
+    const IndexType idx = outputImage->ComputeIndex(offset);
+    bool            interior = true;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      interior = interior && idx[d] > firstIndex[d] && idx[d] < lastIndex[d];
+    }
+    for (unsigned int i = 0; i < neighborStrides.size(); ++i)
+    {
+      if (interior || region.IsInside(idx + neighborOffsets[i]))
+      {
+        visit(offset + neighborStrides[i]);
+      }
+    }
+  };
+
+  // FAH (in french: File d'Attente Hierarchique), storing the pixels by
+  // their offset in the buffers
+  MorphologicalWatershedHierarchicalQueue<InputImagePixelType, OffsetValueType> fah;
 
   //---------------------------------------------------------------------------
   // Meyer's algorithm
@@ -155,161 +180,89 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
     //  - init FAH with indexes of background pixels with marker pixel(s) in
     //    their neighborhood
 
-    ConstantBoundaryCondition<LabelImageType> lcbc2;
-    // outside pixel are watershed so they won't be use to find real watershed
-    // pixels
-    lcbc2.SetConstant(wsLabel);
-    outputIt.OverrideBoundaryCondition(&lcbc2);
-
-    // create a temporary image to store the state of each pixel (processed or
-    // not)
-    using StatusImageType = Image<bool, ImageDimension>;
-    auto statusImage = StatusImageType::New();
-    statusImage->SetRegions(markerImage->GetLargestPossibleRegion());
-    statusImage->Allocate();
-
-    // iterator for the status image
-    using StatusIteratorType = ShapedNeighborhoodIterator<StatusImageType>;
-    typename StatusIteratorType::Iterator      nsIt;
-    StatusIteratorType                         statusIt(radius, statusImage, outputImage->GetRequestedRegion());
-    ConstantBoundaryCondition<StatusImageType> bcbc;
-    bcbc.SetConstant(true); // outside pixel are already processed
-    statusIt.OverrideBoundaryCondition(&bcbc);
-    setConnectivity(&statusIt, m_FullyConnected);
-
-    // the status image must be initialized before the first stage. In the
-    // first stage, the set to true are the neighbors of the marker (and the
-    // marker) so it's difficult (impossible ?) to init the status image at
-    // the same time
-    // the overhead should be small
-    statusImage->FillBuffer(false);
-
-    for (markerIt.GoToBegin(), statusIt.GoToBegin(), outputIt.GoToBegin(), inputIt.GoToBegin(); !markerIt.IsAtEnd();
-         ++markerIt, ++outputIt)
+    // the state of each pixel (processed or not)
+    std::vector<uint8_t> status(numberOfPixels, false);
+
+    for (OffsetValueType offset = 0; offset < numberOfPixels; ++offset)
     {
-      LabelImagePixelType markerPixel = markerIt.GetCenterPixel();
+      const LabelImagePixelType markerPixel = markerBuffer[offset];
       if (markerPixel != bgLabel)
       {
-        IndexType idx = markerIt.GetIndex();
-
-        // move the iterators to the right place
-        OffsetType shift = idx - statusIt.GetIndex();
-        statusIt += shift;
-        inputIt += shift;
-
         // this pixel belongs to a marker
         // mark it as already processed
-        statusIt.SetCenterPixel(true);
+        status[offset] = true;
         // copy it to the output image
-        outputIt.SetCenterPixel(markerPixel);
+        outputBuffer[offset] = markerPixel;
         // and increase progress because this pixel will not be used in the
         // flooding stage.
         progress.CompletedPixel();
 
         // search the background pixels in the neighborhood
-        for (nmIt = markerIt.Begin(), nsIt = statusIt.Begin(), niIt = inputIt.Begin(); nmIt != markerIt.End();
-             nmIt++, nsIt++, niIt++)
-        {
-          if (!nsIt.Get() && nmIt.Get() == bgLabel)
+        forEachNeighbor(offset, [&](OffsetValueType neighbor) {
+          if (!status[neighbor] && markerBuffer[neighbor] == bgLabel)
           {
             // this neighbor is a background pixel and is not already
-            // processed; add its index to fah
-            fah[niIt.Get()].push(markerIt.GetIndex() + nmIt.GetNeighborhoodOffset());
+            // processed; add it to fah
+            fah.Push(inputBuffer[neighbor], neighbor);
             // mark it as already in the fah to avoid adding it several times
-            nsIt.Set(true);
+            status[neighbor] = true;
           }
-        }
+        });
       }
       else
       {
         // Some pixels may be never processed so, by default, non marked pixels
         // must be marked as watershed
-        outputIt.SetCenterPixel(wsLabel);
+        outputBuffer[offset] = wsLabel;
       }
       // one more pixel done in the init stage
       progress.CompletedPixel();
     }
-    // fill the borders of the status image with "true"
-    // FillSides<StatusImageType>(statusImage, true);
-    // Now disable the boundary checks
-    // outputIt.NeedToUseBoundaryConditionOff();
-    // statusIt.NeedToUseBoundaryConditionOff();
-    // inputIt.NeedToUseBoundaryConditionOff();
     // end of init stage
 
     // flooding
-    // init all the iterators
-    outputIt.GoToBegin();
-    statusIt.GoToBegin();
-    inputIt.GoToBegin();
-
-    // and start flooding
-    while (!fah.empty())
+    while (!fah.Empty())
     {
-      // store the current vars
-      InputImagePixelType currentValue = fah.begin()->first;
-      QueueType           currentQueue = fah.begin()->second;
-      // and remove them from the fah
-      fah.erase(fah.begin());
-
-      while (!currentQueue.empty())
-      {
-        IndexType idx = currentQueue.front();
-        currentQueue.pop();
-
-        // move the iterators to the right place
-        OffsetType shift = idx - outputIt.GetIndex();
-        outputIt += shift;
-        statusIt += shift;
-        inputIt += shift;
-
-        // iterate over the neighbors. If there is only one marker value, give
-        // that value to the pixel, else keep it as is (watershed line)
-        LabelImagePixelType marker = wsLabel;
-        bool                collision = false;
-        for (noIt = outputIt.Begin(); noIt != outputIt.End(); ++noIt)
+      const InputImagePixelType currentValue = fah.GetFrontPriority();
+      const OffsetValueType     offset = fah.Pop();
+
+      // iterate over the neighbors. If there is only one marker value, give
+      // that value to the pixel, else keep it as is (watershed line)
+      LabelImagePixelType marker = wsLabel;
+      bool                collision = false;
+      forEachNeighbor(offset, [&](OffsetValueType neighbor) {
+        const LabelImagePixelType o = outputBuffer[neighbor];
+        if (!collision && o != wsLabel)
         {
-          LabelImagePixelType o = noIt.Get();
-          if (o != wsLabel)
+          if (marker != wsLabel && o != marker)
           {
-            if (marker != wsLabel && o != marker)
-            {
-              collision = true;
-              break;
-            }
-            else
-            {
-              marker = o;
-            }
+            collision = true;
           }
-        }
-        if (!collision)
-        {
-          // set the marker value
-          outputIt.SetCenterPixel(marker);
-          // and propagate to the neighbors
-          for (niIt = inputIt.Begin(), nsIt = statusIt.Begin(); niIt != inputIt.End(); niIt++, nsIt++)
+          else
           {
-            if (!nsIt.Get())
-            {
-              // the pixel is not yet processed. add it to the fah
-              InputImagePixelType GrayVal = niIt.Get();
-              if (GrayVal <= currentValue)
-              {
-                currentQueue.push(inputIt.GetIndex() + niIt.GetNeighborhoodOffset());
-              }
-              else
-              {
-                fah[GrayVal].push(inputIt.GetIndex() + niIt.GetNeighborhoodOffset());
-              }
-              // mark it as already in the fah
-              nsIt.Set(true);
-            }
+            marker = o;
           }
         }
-        // one more pixel in the flooding stage
-        progress.CompletedPixel();
+      });
+      if (!collision)
+      {
+        // set the marker value
+        outputBuffer[offset] = marker;
+        // and propagate to the neighbors
+        forEachNeighbor(offset, [&](OffsetValueType neighbor) {
+          if (!status[neighbor])
+          {
+            // the pixel is not yet processed. add it to the fah, in the
+            // current level if it is not higher
+            const InputImagePixelType GrayVal = inputBuffer[neighbor];
+            fah.Push(GrayVal <= currentValue ? currentValue : GrayVal, neighbor);
+            // mark it as already in the fah
+            status[neighbor] = true;
+          }
+        });
       }
+      // one more pixel in the flooding stage
+      progress.CompletedPixel();
     }
   }
 
@@ -323,38 +276,23 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
     //  - init FAH with indexes of pixels with background pixel in their
     //    neighborhood
 
-    ConstantBoundaryCondition<LabelImageType> lcbc2;
-    // outside pixel are watershed so they won't be use to find real watershed
-    // pixels
-    lcbc2.SetConstant(NumericTraits<LabelImagePixelType>::max());
-    outputIt.OverrideBoundaryCondition(&lcbc2);
-
-    for (markerIt.GoToBegin(), outputIt.GoToBegin(), inputIt.GoToBegin(); !markerIt.IsAtEnd(); ++markerIt, ++outputIt)
+    for (OffsetValueType offset = 0; offset < numberOfPixels; ++offset)
     {
-      LabelImagePixelType markerPixel = markerIt.GetCenterPixel();
+      const LabelImagePixelType markerPixel = markerBuffer[offset];
       if (markerPixel != bgLabel)
       {
-        IndexType  idx = markerIt.GetIndex();
-        OffsetType shift = idx - inputIt.GetIndex();
-        inputIt += shift;
-
         // this pixels belongs to a marker
         // copy it to the output image
-        outputIt.SetCenterPixel(markerPixel);
+        outputBuffer[offset] = markerPixel;
         // search if it has background pixel in its neighborhood
         bool haveBgNeighbor = false;
-        for (nmIt = markerIt.Begin(); nmIt != markerIt.End(); ++nmIt)
-        {
-          if (nmIt.Get() == bgLabel)
-          {
-            haveBgNeighbor = true;
-            break;
-          }
-        }
+        forEachNeighbor(offset, [&](OffsetValueType neighbor) {
+          haveBgNeighbor = haveBgNeighbor || markerBuffer[neighbor] == bgLabel;
+        });
         if (haveBgNeighbor)
         {
           // there is a background pixel in the neighborhood; add to fah
-          fah[inputIt.GetCenterPixel()].push(markerIt.GetIndex());
+          fah.Push(inputBuffer[offset], offset);
         }
         else
         {
@@ -365,59 +303,31 @@ MorphologicalWatershedFromMarkersImageFilter<TInputImage, TLabelImage>::Generate
       }
       else
       {
-        outputIt.SetCenterPixel(wsLabel);
+        outputBuffer[offset] = wsLabel;
       }
       progress.CompletedPixel();
     }
     // end of init stage
 
     // flooding
-    // init all the iterators
-    outputIt.GoToBegin();
-    inputIt.GoToBegin();
-
-    // and start flooding
-    while (!fah.empty())
+    while (!fah.Empty())
     {
-      // store the current vars
-      InputImagePixelType currentValue = fah.begin()->first;
-      QueueType           currentQueue = fah.begin()->second;
-      // and remove them from the fah
-      fah.erase(fah.begin());
+      const InputImagePixelType currentValue = fah.GetFrontPriority();
+      const OffsetValueType     offset = fah.Pop();
 
-      while (!currentQueue.empty())
-      {
-        IndexType idx = currentQueue.front();
-        currentQueue.pop();
-
-        // move the iterators to the right place
-        OffsetType shift = idx - outputIt.GetIndex();
-        outputIt += shift;
-        inputIt += shift;
-
-        LabelImagePixelType currentMarker = outputIt.GetCenterPixel();
-        // get the current value of the pixel
-        // iterate over neighbors to propagate the marker
-        for (noIt = outputIt.Begin(), niIt = inputIt.Begin(); noIt != outputIt.End(); noIt++, niIt++)
+      const LabelImagePixelType currentMarker = outputBuffer[offset];
+      // iterate over neighbors to propagate the marker
+      forEachNeighbor(offset, [&](OffsetValueType neighbor) {
+        if (outputBuffer[neighbor] == wsLabel)
         {
-          if (noIt.Get() == wsLabel)
-          {
-            // the pixel is not yet processed. It can be labeled with the
-            // current label
-            noIt.Set(currentMarker);
-            InputImagePixelType GrayVal = niIt.Get();
-            if (GrayVal <= currentValue)
-            {
-              currentQueue.push(inputIt.GetIndex() + noIt.GetNeighborhoodOffset());
-            }
-            else
-            {
-              fah[GrayVal].push(inputIt.GetIndex() + noIt.GetNeighborhoodOffset());
-            }
-            progress.CompletedPixel();
-          }
+          // the pixel is not yet processed. It can be labeled with the
+          // current label
+          outputBuffer[neighbor] = currentMarker;
+          const InputImagePixelType GrayVal = inputBuffer[neighbor];
+          fah.Push(GrayVal <= currentValue ? currentValue : GrayVal, neighbor);
+          progress.CompletedPixel();
         }
-      }
+      });
     }
   }
 }
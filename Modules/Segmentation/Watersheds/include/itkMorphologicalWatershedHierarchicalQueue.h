@@ -0,0 +1,219 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMorphologicalWatershedHierarchicalQueue_h
+#define itkMorphologicalWatershedHierarchicalQueue_h
+
+#include "itkIntTypes.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <type_traits>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class MorphologicalWatershedHierarchicalQueue
+ * \brief Hierarchical queue of the morphological watershed transforms
+ *
+ * The queue has a first in, first out level per priority, and gives the
+ * elements of the lowest priority first. The elements of a level are stored
+ * contiguously in a vector, with the position of the next element to pop.
+ *
+ * The levels of the integral priorities of 8 or 16 bits are stored in an
+ * array indexed by the priority, and the lowest level is found by moving a
+ * cursor forward. The levels of the other priorities are stored in a
+ * std::map.
+ *
+ * The flooding never pushes an element below the priority of the last
+ * element popped, so the levels below it are released as soon as the queue
+ * moves past them. An empty level keeps its memory until then, as it is
+ * often filled again by the neighbors of the element just popped.
+ *
+ * \sa MorphologicalWatershedFromMarkersImageFilter
+ * \ingroup ITKWatersheds
+ */
+template <typename TPriority,
+          typename TElement,
+          bool VUseBuckets = std::is_integral<TPriority>::value && !std::is_same<TPriority, bool>::value &&
+                             (sizeof(TPriority) <= 2)>
+class MorphologicalWatershedHierarchicalQueue;
+
+/** A level of a hierarchical queue. */
+template <typename TElement>
+class MorphologicalWatershedHierarchicalQueueLevel
+{
+public:
+  bool
+  Empty() const
+  {
+    return m_Head == m_Elements.size();
+  }
+
+  void
+  Push(const TElement & element)
+  {
+    m_Elements.push_back(element);
+  }
+
+  /** Remove the first element. The level must not be empty. */
+  TElement
+  Pop()
+  {
+    const TElement element = m_Elements[m_Head++];
+    if (this->Empty())
+    {
+      m_Elements.clear();
+      m_Head = 0;
+    }
+    return element;
+  }
+
+  /** Release the memory of an empty level. */
+  void
+  Release()
+  {
+    std::vector<TElement>().swap(m_Elements);
+  }
+
+private:
+  std::vector<TElement> m_Elements;
+  SizeValueType         m_Head{ 0 };
+};
+
+/** Hierarchical queue with a level for each possible priority. */
+template <typename TPriority, typename TElement>
+class MorphologicalWatershedHierarchicalQueue<TPriority, TElement, true>
+{
+public:
+  MorphologicalWatershedHierarchicalQueue()
+    : m_Levels(static_cast<SizeValueType>(std::numeric_limits<TPriority>::max()) -
+               static_cast<SizeValueType>(std::numeric_limits<TPriority>::lowest()) + 1)
+  {}
+
+  bool
+  Empty() const
+  {
+    return m_Size == 0;
+  }
+
+  /** The lowest priority of the elements. The queue must not be empty. */
+  TPriority
+  GetFrontPriority()
+  {
+    this->SkipEmptyLevels();
+    return static_cast<TPriority>(m_Front + static_cast<SizeValueType>(std::numeric_limits<TPriority>::lowest()));
+  }
+
+  void
+  Push(TPriority priority, const TElement & element)
+  {
+    const SizeValueType level =
+      static_cast<SizeValueType>(priority) - static_cast<SizeValueType>(std::numeric_limits<TPriority>::lowest());
+    m_Levels[level].Push(element);
+    m_Front = std::min(m_Front, level);
+    ++m_Size;
+  }
+
+  /** Remove the first element of the lowest priority. The queue must not be
+   * empty. */
+  TElement
+  Pop()
+  {
+    this->SkipEmptyLevels();
+    --m_Size;
+    return m_Levels[m_Front].Pop();
+  }
+
+private:
+  void
+  SkipEmptyLevels()
+  {
+    while (m_Levels[m_Front].Empty())
+    {
+      m_Levels[m_Front++].Release();
+    }
+  }
+
+  std::vector<MorphologicalWatershedHierarchicalQueueLevel<TElement>> m_Levels;
+  SizeValueType                                                      m_Front{ 0 };
+  SizeValueType                                                      m_Size{ 0 };
+};
+
+/** Hierarchical queue with a level for each priority pushed. */
+template <typename TPriority, typename TElement>
+class MorphologicalWatershedHierarchicalQueue<TPriority, TElement, false>
+{
+public:
+  bool
+  Empty() const
+  {
+    return m_Size == 0;
+  }
+
+  /** The lowest priority of the elements. The queue must not be empty. */
+  TPriority
+  GetFrontPriority()
+  {
+    this->SkipEmptyLevels();
+    return m_Levels.begin()->first;
+  }
+
+  void
+  Push(TPriority priority, const TElement & element)
+  {
+    // most elements are pushed to the lowest level, which is found without
+    // searching the map
+    const auto front = m_Levels.begin();
+    if (front != m_Levels.end() && front->first == priority)
+    {
+      front->second.Push(element);
+    }
+    else
+    {
+      m_Levels[priority].Push(element);
+    }
+    ++m_Size;
+  }
+
+  /** Remove the first element of the lowest priority. The queue must not be
+   * empty. */
+  TElement
+  Pop()
+  {
+    this->SkipEmptyLevels();
+    --m_Size;
+    return m_Levels.begin()->second.Pop();
+  }
+
+private:
+  void
+  SkipEmptyLevels()
+  {
+    while (m_Levels.begin()->second.Empty())
+    {
+      m_Levels.erase(m_Levels.begin());
+    }
+  }
+
+  std::map<TPriority, MorphologicalWatershedHierarchicalQueueLevel<TElement>> m_Levels;
+  SizeValueType                                                               m_Size{ 0 };
+};
+} // end namespace itk
+
+#endif
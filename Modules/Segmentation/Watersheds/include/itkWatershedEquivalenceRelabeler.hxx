@@ -50,7 +50,8 @@ EquivalenceRelabeler<TScalar, TImageDimension>::GenerateData()
   }
 
   eqT->Flatten();
-  SegmenterType::RelabelImage(output, output->GetRequestedRegion(), eqT);
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  SegmenterType::RelabelImage(output, output->GetRequestedRegion(), eqT, this->GetMultiThreader());
 }
 
 template <typename TScalar, unsigned int VImageDimension>
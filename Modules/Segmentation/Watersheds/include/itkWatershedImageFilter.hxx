@@ -174,6 +174,10 @@ WatershedImageFilter<TInputImage>::GenerateData()
   c->SetCount(0.0);
   c->SetNumberOfFilters(3);
 
+  // The segmenter and the relabeler use the work units of this filter
+  m_Segmenter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  m_Relabeler->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
   // Graft our output on the relabeler
   m_Relabeler->GraftOutput(this->GetOutput());
 
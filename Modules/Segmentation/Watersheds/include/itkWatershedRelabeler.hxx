@@ -88,7 +88,8 @@ Relabeler<TScalar, TImageDimension>::GenerateData()
     ++it;
   }
 
-  SegmenterType::RelabelImage(output, output->GetRequestedRegion(), eqT);
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  SegmenterType::RelabelImage(output, output->GetRequestedRegion(), eqT, this->GetMultiThreader());
   this->UpdateProgress(1.0);
 }
 
@@ -81,6 +81,13 @@ namespace watershed
  * segments.  The assumption is that the "shallow" regions that this
  * thresholding eliminates are generally not of interest.
  *
+ * \par Threading
+ * The comparisons of each pixel with its neighbors, which find the local
+ * minima, the flat regions and the paths of steepest descent, and the
+ * relabeling of the image are split between the work units of the filter.
+ * The labels are then assigned in a single pass in the order of the image
+ * buffer, so the output does not depend on the number of work units.
+ *
  * \sa WatershedImageFilter
  * \ingroup WatershedSegmentation
  * \ingroup ITKWatersheds
@@ -208,8 +215,10 @@ public:
   }
 
   /** Helper function.  Other classes may have occasion to use this. Relabels
-      an image according to a table of equivalencies. */
-  static void RelabelImage(OutputImageTypePointer, ImageRegionType, EquivalencyTable::Pointer);
+      an image according to a table of equivalencies, with the work units of
+      the multi-threader when it is not null. */
+  static void
+  RelabelImage(OutputImageTypePointer, ImageRegionType, EquivalencyTable::Pointer, MultiThreaderBase * = nullptr);
 
   /** Standard itk::ProcessObject subclass method. */
   using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
@@ -377,6 +386,18 @@ protected:
   /** This is a debugging method.  Will be removed. 11/14/01 jc   */
   //  bool CheckLabeledBoundaries();
 
+  /** The offsets of the neighbors of the connectivity in the buffer of an
+   * image.  The threshold and output images share the same buffered region,
+   * so the offsets are the same in both buffers. */
+  std::vector<OffsetValueType>
+  ComputeConnectivityOffsets(const OutputImageType * img) const;
+
+  /** Calls func with the offset in the image buffers of each pixel of the
+   * region, split between the work units of the multi-threader. */
+  template <typename TFunction>
+  void
+  ParallelizeOffsets(const ImageRegionType & region, const TFunction & func);
+
   /** Holds generalized connectivity information for connected component
    * labeling and gradient descent analysis in pixel neighborhoods.  */
   connectivity_t m_Connectivity;
@@ -21,6 +21,7 @@
 #include "itkMath.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineConstIterator.h"
 #include <stack>
 #include <list>
 
@@ -54,6 +55,7 @@ Segmenter<TInputImage>::GenerateData()
   unsigned int i;
 
   this->UpdateProgress(0.0);
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
   if (m_DoBoundaryAnalysis == false)
   {
     this->GetSegmentTable()->Clear();
@@ -682,96 +684,99 @@ Segmenter<TInputImage>::LabelMinima(InputImageTypePointer                img,
                                     typename Self::flat_region_table_t & flatRegions,
                                     InputPixelType                       Max)
 {
-  unsigned int   i, nSize, nCenter, nPos = 0;
-  bool           foundSinglePixelMinimum, foundFlatRegion;
+  unsigned int   i;
   InputPixelType maxValue = Max;
 
   flat_region_t tempFlatRegion;
 
   typename flat_region_table_t::iterator flatPtr;
-  InputPixelType                         currentValue;
   auto                                   equivalentLabels = EquivalencyTable::New();
 
   typename OutputImageType::Pointer output = this->GetOutputImage();
 
-  // Set up the iterators.
-  typename ConstNeighborhoodIterator<InputImageType>::RadiusType rad;
-  for (i = 0; i < ImageDimension; ++i)
-  {
-    rad[i] = 1;
-  }
-  ConstNeighborhoodIterator<InputImageType> searchIt(rad, img, region);
-  NeighborhoodIterator<OutputImageType>     labelIt(rad, output, region);
-  nSize = searchIt.Size();
-  nCenter = nSize >> 1;
-
-  // Sweep through the images.  Label all local minima
-  // and record information for all the flat regions.
-  for (searchIt.GoToBegin(), labelIt.GoToBegin(); !searchIt.IsAtEnd(); ++searchIt, ++labelIt)
-  {
-    foundSinglePixelMinimum = true;
-    foundFlatRegion = false;
-
-    // If this pixel has been labeled already,
-    // skip directly to the next iteration.
-    if (labelIt.GetPixel(nCenter) != Self::NULL_LABEL)
-    {
-      continue;
-    }
-
-    // Compare current pixel value with its neighbors.
-    currentValue = searchIt.GetPixel(nCenter);
-
-    for (i = 0; i < m_Connectivity.size; ++i)
+  const InputPixelType *             values = img->GetBufferPointer();
+  IdentifierType *                   labels = output->GetBufferPointer();
+  const std::vector<OffsetValueType> neighbors = this->ComputeConnectivityOffsets(output);
+  const unsigned int                 nSize = m_Connectivity.size;
+  const auto                         lineLength = static_cast<OffsetValueType>(region.GetSize(0));
+
+  // Compare each pixel value with its neighbors.  This only depends on the
+  // values, so it is done by all the work units before the labeling.  The
+  // class of a pixel is the position of its first neighbor of the same value
+  // when it is in a flat region, SinglePixelMinimum when it is lower than
+  // all its neighbors, and NotMinimum otherwise.
+  const auto           singlePixelMinimum = static_cast<uint8_t>(nSize);
+  const auto           notMinimum = static_cast<uint8_t>(nSize + 1);
+  std::vector<uint8_t> classes(output->GetBufferedRegion().GetNumberOfPixels());
+  this->ParallelizeOffsets(region, [&](OffsetValueType offset) {
+    const InputPixelType currentValue = values[offset];
+    uint8_t              pixelClass = singlePixelMinimum;
+    for (unsigned int n = 0; n < nSize; ++n)
     {
-      nPos = m_Connectivity.index[i];
-      if (Math::AlmostEquals(currentValue, searchIt.GetPixel(nPos)))
+      const InputPixelType neighborValue = values[offset + neighbors[n]];
+      if (Math::AlmostEquals(currentValue, neighborValue))
       {
-        foundFlatRegion = true;
+        pixelClass = static_cast<uint8_t>(n);
         break;
       }
-      else if (currentValue > searchIt.GetPixel(nPos))
+      else if (currentValue > neighborValue)
       {
-        foundSinglePixelMinimum = false;
+        pixelClass = notMinimum;
       }
     }
+    classes[offset] = pixelClass;
+  });
 
-    if (foundFlatRegion)
+  // Sweep through the images.  Label all local minima
+  // and record information for all the flat regions.
+  for (ImageScanlineConstIterator<OutputImageType> lineIt(output, region); !lineIt.IsAtEnd(); lineIt.NextLine())
+  {
+    const OffsetValueType lineOffset = output->ComputeOffset(lineIt.GetIndex());
+    for (OffsetValueType offset = lineOffset; offset < lineOffset + lineLength; ++offset)
     {
-      if (labelIt.GetPixel(nPos) != Self::NULL_LABEL) // If the flat region is
-                                                      // already
-      {                                               // labeled, label this
-                                                      // to match.
-        labelIt.SetPixel(nCenter, labelIt.GetPixel(nPos));
-      }
-      else // Add a new flat region to the table.
-      {    // Initialize its contents.
-        labelIt.SetPixel(nCenter, m_CurrentLabel);
-        nPos = m_Connectivity.index[0];
-
-        tempFlatRegion.bounds_min = maxValue;
-        tempFlatRegion.min_label_ptr = labelIt[nPos];
-        tempFlatRegion.value = currentValue;
-        flatRegions[m_CurrentLabel] = tempFlatRegion;
-        m_CurrentLabel = m_CurrentLabel + 1;
+      // If this pixel has been labeled already,
+      // skip directly to the next iteration.
+      if (labels[offset] != Self::NULL_LABEL)
+      {
+        continue;
       }
 
-      // While we're at it, check to see if we have just linked two flat
-      // regions with the same height value.  Save that info for later.
-      for (i++; i < m_Connectivity.size; ++i)
+      const uint8_t pixelClass = classes[offset];
+      if (pixelClass < nSize)
       {
-        nPos = m_Connectivity.index[i];
-        if (Math::AlmostEquals(searchIt.GetPixel(nCenter), searchIt.GetPixel(nPos)) &&
-            labelIt.GetPixel(nPos) != Self::NULL_LABEL && labelIt.GetPixel(nPos) != labelIt.GetPixel(nCenter))
+        const OffsetValueType nPos = offset + neighbors[pixelClass];
+        if (labels[nPos] != Self::NULL_LABEL) // If the flat region is already
+        {                                     // labeled, label this to match.
+          labels[offset] = labels[nPos];
+        }
+        else // Add a new flat region to the table.
+        {    // Initialize its contents.
+          labels[offset] = m_CurrentLabel;
+
+          tempFlatRegion.bounds_min = maxValue;
+          tempFlatRegion.min_label_ptr = labels + offset + neighbors[0];
+          tempFlatRegion.value = values[offset];
+          flatRegions[m_CurrentLabel] = tempFlatRegion;
+          m_CurrentLabel = m_CurrentLabel + 1;
+        }
+
+        // While we're at it, check to see if we have just linked two flat
+        // regions with the same height value.  Save that info for later.
+        for (i = pixelClass + 1; i < nSize; ++i)
         {
-          equivalentLabels->Add(labelIt.GetPixel(nCenter), labelIt.GetPixel(nPos));
+          const OffsetValueType n = offset + neighbors[i];
+          if (Math::AlmostEquals(values[offset], values[n]) && labels[n] != Self::NULL_LABEL &&
+              labels[n] != labels[offset])
+          {
+            equivalentLabels->Add(labels[offset], labels[n]);
+          }
         }
       }
-    }
-    else if (foundSinglePixelMinimum)
-    {
-      labelIt.SetPixel(nCenter, m_CurrentLabel);
-      m_CurrentLabel = m_CurrentLabel + 1;
+      else if (pixelClass == singlePixelMinimum)
+      {
+        labels[offset] = m_CurrentLabel;
+        m_CurrentLabel = m_CurrentLabel + 1;
+      }
     }
   }
 
@@ -779,44 +784,53 @@ Segmenter<TInputImage>::LabelMinima(InputImageTypePointer                img,
   Self::MergeFlatRegions(flatRegions, equivalentLabels);
 
   // Relabel the image with the merged regions.
-  Self::RelabelImage(output, region, equivalentLabels);
+  Self::RelabelImage(output, region, equivalentLabels, this->GetMultiThreader());
 
   equivalentLabels->Clear();
 
-  // Now make another pass to establish the
-  // boundary values for the flat regions.
-  for (searchIt.GoToBegin(), labelIt.GoToBegin(); !searchIt.IsAtEnd(); ++searchIt, ++labelIt)
+  // Now make another pass to establish the boundary values for the flat
+  // regions.  The pixels of the flat regions are those with a neighbor of the
+  // same value.
+  for (ImageScanlineConstIterator<OutputImageType> lineIt(output, region); !lineIt.IsAtEnd(); lineIt.NextLine())
   {
-    flatPtr = flatRegions.find(labelIt.GetPixel(nCenter));
-    if (flatPtr != flatRegions.end()) // If we are in a flat region
-    {                                 // Search the connectivity neighborhood
-                                      // for lesser boundary pixels.
-      for (i = 0; i < m_Connectivity.size; ++i)
+    const OffsetValueType lineOffset = output->ComputeOffset(lineIt.GetIndex());
+    for (OffsetValueType offset = lineOffset; offset < lineOffset + lineLength; ++offset)
+    {
+      if (classes[offset] >= nSize)
       {
-        nPos = m_Connectivity.index[i];
-
-        if (labelIt.GetPixel(nPos) != labelIt.GetPixel(nCenter) && searchIt.GetPixel(nPos) < flatPtr->second.bounds_min)
-        { // If this is a boundary pixel && has a lesser value than
-          // the currently recorded value...
-          flatPtr->second.bounds_min = searchIt.GetPixel(nPos);
-          flatPtr->second.min_label_ptr = labelIt[nPos];
-        }
-        if (Math::AlmostEquals(searchIt.GetPixel(nCenter), searchIt.GetPixel(nPos)))
+        continue;
+      }
+      flatPtr = flatRegions.find(labels[offset]);
+      if (flatPtr != flatRegions.end()) // If we are in a flat region
+      {                                 // Search the connectivity neighborhood
+                                        // for lesser boundary pixels.
+        for (i = 0; i < nSize; ++i)
         {
-          if (labelIt.GetPixel(nPos) != NULL_LABEL)
-          {
-            // Pick up any equivalencies we missed before.
-            equivalentLabels->Add(labelIt.GetPixel(nCenter), labelIt.GetPixel(nPos));
+          const OffsetValueType nPos = offset + neighbors[i];
+
+          if (labels[nPos] != labels[offset] && values[nPos] < flatPtr->second.bounds_min)
+          { // If this is a boundary pixel && has a lesser value than
+            // the currently recorded value...
+            flatPtr->second.bounds_min = values[nPos];
+            flatPtr->second.min_label_ptr = labels + nPos;
           }
-          // If the following is encountered, it means that there is a
-          // logic flaw in the first pass of this algorithm where flat
-          // regions are initially detected and linked.
-#ifndef NDEBUG
-          else
+          if (Math::AlmostEquals(values[offset], values[nPos]))
           {
-            itkDebugMacro("An unexpected but non-fatal error has occurred.");
-          }
+            if (labels[nPos] != NULL_LABEL)
+            {
+              // Pick up any equivalencies we missed before.
+              equivalentLabels->Add(labels[offset], labels[nPos]);
+            }
+            // If the following is encountered, it means that there is a
+            // logic flaw in the first pass of this algorithm where flat
+            // regions are initially detected and linked.
+#ifndef NDEBUG
+            else
+            {
+              itkDebugMacro("An unexpected but non-fatal error has occurred.");
+            }
 #endif
+          }
         }
       }
     }
@@ -826,7 +840,7 @@ Segmenter<TInputImage>::LabelMinima(InputImageTypePointer                img,
   Self::MergeFlatRegions(flatRegions, equivalentLabels);
 
   // Relabel the image with the merged regions.
-  Self::RelabelImage(output, region, equivalentLabels);
+  Self::RelabelImage(output, region, equivalentLabels, this->GetMultiThreader());
 }
 
 template <typename TInputImage>
@@ -835,60 +849,63 @@ Segmenter<TInputImage>::GradientDescent(InputImageTypePointer img, ImageRegionTy
 {
   typename OutputImageType::Pointer output = this->GetOutputImage();
 
-  InputPixelType                      minVal;
-  unsigned int                        i, nPos;
-  typename InputImageType::OffsetType moveIndex;
-  IdentifierType                      newLabel;
-  std::stack<IdentifierType *>        updateStack;
+  IdentifierType               newLabel;
+  std::stack<IdentifierType *> updateStack;
+
+  const InputPixelType *             values = img->GetBufferPointer();
+  IdentifierType *                   labels = output->GetBufferPointer();
+  const std::vector<OffsetValueType> neighbors = this->ComputeConnectivityOffsets(output);
+  const unsigned int                 nSize = m_Connectivity.size;
+  const auto                         lineLength = static_cast<OffsetValueType>(region.GetSize(0));
 
   //
-  // Set up our iterators.
+  // Find the path of steepest descent out of each unlabeled pixel.  This only
+  // depends on the values, so it is done by all the work units before the
+  // paths are followed.
   //
-  typename ConstNeighborhoodIterator<InputImageType>::RadiusType rad;
-  typename NeighborhoodIterator<OutputImageType>::RadiusType     zeroRad;
-  for (i = 0; i < ImageDimension; ++i)
-  {
-    rad[i] = 1;
-    zeroRad[i] = 0;
-  }
-  ConstNeighborhoodIterator<InputImageType> valueIt(rad, img, region);
-  NeighborhoodIterator<OutputImageType>     labelIt(zeroRad, output, region);
-  ImageRegionIterator<OutputImageType>      it(output, region);
+  std::vector<uint8_t> moves(output->GetBufferedRegion().GetNumberOfPixels());
+  this->ParallelizeOffsets(region, [&](OffsetValueType offset) {
+    if (labels[offset] == NULL_LABEL)
+    {
+      InputPixelType minVal = values[offset + neighbors[0]];
+      uint8_t        move = 0;
+      for (unsigned int ii = 1; ii < nSize; ++ii)
+      {
+        if (values[offset + neighbors[ii]] < minVal)
+        {
+          minVal = values[offset + neighbors[ii]];
+          move = static_cast<uint8_t>(ii);
+        }
+      }
+      moves[offset] = move;
+    }
+  });
 
   //
   // Sweep through the image and trace all unlabeled
   // pixels to a labeled region
   //
-  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  for (ImageScanlineConstIterator<OutputImageType> lineIt(output, region); !lineIt.IsAtEnd(); lineIt.NextLine())
   {
-    if (it.Get() == NULL_LABEL)
+    const OffsetValueType lineOffset = output->ComputeOffset(lineIt.GetIndex());
+    for (OffsetValueType offset = lineOffset; offset < lineOffset + lineLength; ++offset)
     {
-      valueIt.SetLocation(it.GetIndex());
-      labelIt.SetLocation(it.GetIndex());
-      newLabel = NULL_LABEL;         // Follow the path of steep-
-      while (newLabel == NULL_LABEL) // est descent until a label
-      {                              // is found.
-        updateStack.push(labelIt.GetCenterPointer());
-        minVal = valueIt.GetPixel(m_Connectivity.index[0]);
-        moveIndex = m_Connectivity.direction[0];
-        for (unsigned int ii = 1; ii < m_Connectivity.size; ++ii)
-        {
-          nPos = m_Connectivity.index[ii];
-          if (valueIt.GetPixel(nPos) < minVal)
-          {
-            minVal = valueIt.GetPixel(nPos);
-            moveIndex = m_Connectivity.direction[ii];
-          }
+      if (labels[offset] == NULL_LABEL)
+      {
+        OffsetValueType position = offset;
+        newLabel = NULL_LABEL;         // Follow the path of steep-
+        while (newLabel == NULL_LABEL) // est descent until a label
+        {                              // is found.
+          updateStack.push(labels + position);
+          position += neighbors[moves[position]];
+          newLabel = labels[position];
         }
-        valueIt += moveIndex;
-        labelIt += moveIndex;
-        newLabel = labelIt.GetPixel(0);
-      }
 
-      while (!updateStack.empty()) // Update all the pixels we've traversed
-      {
-        *(updateStack.top()) = newLabel;
-        updateStack.pop();
+        while (!updateStack.empty()) // Update all the pixels we've traversed
+        {
+          *(updateStack.top()) = newLabel;
+          updateStack.pop();
+        }
       }
     }
   }
@@ -915,7 +932,7 @@ Segmenter<TInputImage>::DescendFlatRegions(flat_region_table_t & flatRegionTable
   }
 
   equivalentLabels->Flatten();
-  Self::RelabelImage(output, imageRegion, equivalentLabels);
+  Self::RelabelImage(output, imageRegion, equivalentLabels, this->GetMultiThreader());
 }
 
 template <typename TInputImage>
@@ -928,11 +945,11 @@ Segmenter<TInputImage>::UpdateSegmentTable(InputImageTypePointer input, ImageReg
   typename edge_table_hash_t::iterator edge_table_entry_ptr;
   typename edge_table_t::iterator      edge_ptr;
 
-  unsigned int                                               i, nPos;
-  typename NeighborhoodIterator<OutputImageType>::RadiusType hoodRadius;
-  typename SegmentTableType::segment_t *                     segment_ptr;
-  typename SegmentTableType::segment_t                       temp_segment;
-  IdentifierType                                             segment_label;
+  unsigned int                          i;
+  typename SegmentTableType::segment_t * segment_ptr = nullptr;
+  typename SegmentTableType::segment_t   temp_segment;
+  IdentifierType                         segment_label = NULL_LABEL;
+  edge_table_t *                         segment_edges = nullptr;
 
   InputPixelType lowest_edge;
 
@@ -940,67 +957,82 @@ Segmenter<TInputImage>::UpdateSegmentTable(InputImageTypePointer input, ImageReg
   typename OutputImageType::Pointer  output = this->GetOutputImage();
   typename SegmentTableType::Pointer segments = this->GetSegmentTable();
 
-  // Set up some iterators.
-  for (i = 0; i < ImageDimension; ++i)
-  {
-    hoodRadius[i] = 1;
-  }
-  ConstNeighborhoodIterator<InputImageType> searchIt(hoodRadius, input, region);
-  NeighborhoodIterator<OutputImageType>     labelIt(hoodRadius, output, region);
-
-  IdentifierType hoodCenter = searchIt.Size() >> 1;
+  const InputPixelType *             values = input->GetBufferPointer();
+  const IdentifierType *             labels = output->GetBufferPointer();
+  const std::vector<OffsetValueType> neighbors = this->ComputeConnectivityOffsets(output);
+  const auto                         lineLength = static_cast<OffsetValueType>(region.GetSize(0));
 
-  for (searchIt.GoToBegin(), labelIt.GoToBegin(); !searchIt.IsAtEnd(); ++searchIt, ++labelIt)
+  for (ImageScanlineConstIterator<OutputImageType> lineIt(output, region); !lineIt.IsAtEnd(); lineIt.NextLine())
   {
-    segment_label = labelIt.GetPixel(hoodCenter);
-
-    // Find the segment corresponding to this label
-    // and update its minimum value if necessary.
-    segment_ptr = segments->Lookup(segment_label);
-    edge_table_entry_ptr = edgeHash.find(segment_label);
-    if (segment_ptr == nullptr) // This segment not yet identified.
-    {                           // So add it to the table.
-      temp_segment.min = searchIt.GetPixel(hoodCenter);
-      segments->Add(segment_label, temp_segment);
-      using ValueType = typename edge_table_hash_t::value_type;
-      edgeHash.insert(ValueType(segment_label, tempEdgeTable));
-
-      edge_table_entry_ptr = edgeHash.find(segment_label);
-    }
-    else if (searchIt.GetPixel(hoodCenter) < segment_ptr->min)
+    const OffsetValueType lineOffset = output->ComputeOffset(lineIt.GetIndex());
+    for (OffsetValueType offset = lineOffset; offset < lineOffset + lineLength; ++offset)
     {
-      segment_ptr->min = searchIt.GetPixel(hoodCenter);
-    }
+      const InputPixelType value = values[offset];
 
-    // Look up each neighboring segment in this segment's edge table.
-    // If an edge exists, compare (and reset) the minimum edge value.
-    // Note that edges are located *between* two adjacent pixels and
-    // the value is taken to be the maximum of the two adjacent pixel
-    // values.
-    for (i = 0; i < m_Connectivity.size; ++i)
-    {
-      nPos = m_Connectivity.index[i];
-      if (labelIt.GetPixel(nPos) != segment_label && labelIt.GetPixel(nPos) != NULL_LABEL)
+      // Find the segment corresponding to this label
+      // and update its minimum value if necessary.  Consecutive pixels
+      // mostly belong to the same segment, which is only looked up again
+      // when the label changes.
+      if (segment_ptr != nullptr && labels[offset] == segment_label)
       {
-        if (searchIt.GetPixel(nPos) < searchIt.GetPixel(hoodCenter))
+        if (value < segment_ptr->min)
         {
-          lowest_edge = searchIt.GetPixel(hoodCenter); // We want the
+          segment_ptr->min = value;
         }
-        else
+      }
+      else
+      {
+        segment_label = labels[offset];
+        segment_ptr = segments->Lookup(segment_label);
+        edge_table_entry_ptr = edgeHash.find(segment_label);
+        if (segment_ptr == nullptr) // This segment not yet identified.
+        {                           // So add it to the table.
+          temp_segment.min = value;
+          segments->Add(segment_label, temp_segment);
+          segment_ptr = segments->Lookup(segment_label);
+        }
+        else if (value < segment_ptr->min)
         {
-          lowest_edge = searchIt.GetPixel(nPos); // max of the
+          segment_ptr->min = value;
         }
-        // adjacent pixels
-
-        edge_ptr = edge_table_entry_ptr->second.find(labelIt.GetPixel(nPos));
-        if (edge_ptr == edge_table_entry_ptr->second.end())
-        { // This edge has not been identified yet.
-          using ValueType = typename edge_table_t::value_type;
-          edge_table_entry_ptr->second.insert(ValueType(labelIt.GetPixel(nPos), lowest_edge));
+        if (edge_table_entry_ptr == edgeHash.end())
+        {
+          using ValueType = typename edge_table_hash_t::value_type;
+          edge_table_entry_ptr = edgeHash.insert(ValueType(segment_label, tempEdgeTable)).first;
         }
-        else if (lowest_edge < edge_ptr->second)
+        segment_edges = &edge_table_entry_ptr->second;
+      }
+
+      // Look up each neighboring segment in this segment's edge table.
+      // If an edge exists, compare (and reset) the minimum edge value.
+      // Note that edges are located *between* two adjacent pixels and
+      // the value is taken to be the maximum of the two adjacent pixel
+      // values.
+      for (i = 0; i < m_Connectivity.size; ++i)
+      {
+        const OffsetValueType nPos = offset + neighbors[i];
+        if (labels[nPos] != segment_label && labels[nPos] != NULL_LABEL)
         {
-          edge_ptr->second = lowest_edge;
+          if (values[nPos] < value)
+          {
+            lowest_edge = value; // We want the
+          }
+          else
+          {
+            lowest_edge = values[nPos]; // max of the
+          }
+          // adjacent pixels
+
+          edge_ptr = segment_edges->find(labels[nPos]);
+          if (edge_ptr == segment_edges->end())
+          { // This edge has not been identified yet.
+            using ValueType = typename edge_table_t::value_type;
+            segment_edges->insert(ValueType(labels[nPos], lowest_edge));
+          }
+          else if (lowest_edge < edge_ptr->second)
+          {
+            edge_ptr->second = lowest_edge;
+          }
         }
       }
     }
@@ -1153,23 +1185,78 @@ template <typename TInputImage>
 void
 Segmenter<TInputImage>::RelabelImage(OutputImageTypePointer    img,
                                      ImageRegionType           region,
-                                     EquivalencyTable::Pointer eqTable)
+                                     EquivalencyTable::Pointer eqTable,
+                                     MultiThreaderBase *       multiThreader)
 {
   eqTable->Flatten();
+  if (eqTable->Empty())
+  {
+    return;
+  }
 
-  IdentifierType                       temp;
-  ImageRegionIterator<OutputImageType> it(img, region);
+  // The table is only read, so the parts of the region can be relabeled by
+  // several work units at the same time.
+  const auto relabel = [img, &eqTable](const ImageRegionType & subregion) {
+    IdentifierType                       temp;
+    ImageRegionIterator<OutputImageType> it(img, subregion);
 
-  it.GoToBegin();
-  while (!it.IsAtEnd())
+    it.GoToBegin();
+    while (!it.IsAtEnd())
+    {
+      temp = eqTable->Lookup(it.Get());
+      if (temp != it.Get())
+      {
+        it.Set(temp);
+      }
+      ++it;
+    }
+  };
+
+  if (multiThreader == nullptr)
   {
-    temp = eqTable->Lookup(it.Get());
-    if (temp != it.Get())
+    relabel(region);
+  }
+  else
+  {
+    multiThreader->template ParallelizeImageRegion<ImageDimension>(region, relabel, nullptr);
+  }
+}
+
+template <typename TInputImage>
+std::vector<OffsetValueType>
+Segmenter<TInputImage>::ComputeConnectivityOffsets(const OutputImageType * img) const
+{
+  std::vector<OffsetValueType> offsets(m_Connectivity.size, 0);
+  for (unsigned int i = 0; i < m_Connectivity.size; ++i)
+  {
+    for (unsigned int d = 0; d < ImageDimension; ++d)
     {
-      it.Set(temp);
+      offsets[i] += m_Connectivity.direction[i][d] * img->GetOffsetTable()[d];
     }
-    ++it;
   }
+  return offsets;
+}
+
+template <typename TInputImage>
+template <typename TFunction>
+void
+Segmenter<TInputImage>::ParallelizeOffsets(const ImageRegionType & region, const TFunction & func)
+{
+  const OutputImageType * output = this->GetOutputImage();
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [output, &func](const ImageRegionType & subregion) {
+      const auto lineLength = static_cast<OffsetValueType>(subregion.GetSize(0));
+      for (ImageScanlineConstIterator<OutputImageType> lineIt(output, subregion); !lineIt.IsAtEnd(); lineIt.NextLine())
+      {
+        const OffsetValueType lineOffset = output->ComputeOffset(lineIt.GetIndex());
+        for (OffsetValueType offset = lineOffset; offset < lineOffset + lineLength; ++offset)
+        {
+          func(offset);
+        }
+      }
+    },
+    nullptr);
 }
 
 template <typename TInputImage>